@@ -17,16 +17,40 @@ LifetimeImpl* Lifetime::operator->() const
 
 std::once_flag onceFlag;
 
-Lifetime::Lifetime(bool is_eternal) : ptr(std::allocate_shared<LifetimeImpl, Allocator>(allocator, is_eternal))
+namespace
+{
+void init_default_logger()
 {
 	std::call_once(onceFlag, [] {
 		spdlog::set_default_logger(spdlog::stderr_color_mt<spdlog::synchronous_factory>("default", spdlog::color_mode::automatic));
 	});
 }
 
+std::shared_ptr<LifetimeImpl> allocate_impl(std::shared_ptr<memory_resource> resource)
+{
+	if (resource == nullptr)
+	{
+		return std::allocate_shared<LifetimeImpl>(std::allocator<LifetimeImpl>(), false);
+	}
+	// the lifetime keeps its resource, its handles may outlive the model
+	shared_resource_allocator<LifetimeImpl> impl_allocator(resource);
+	return std::allocate_shared<LifetimeImpl>(impl_allocator, false, std::move(resource));
+}
+}	 // namespace
+
+Lifetime::Lifetime(bool is_eternal) : ptr(std::allocate_shared<LifetimeImpl, Allocator>(allocator, is_eternal))
+{
+	init_default_logger();
+}
+
+Lifetime::Lifetime(std::shared_ptr<memory_resource> resource) : ptr(allocate_impl(std::move(resource)))
+{
+	init_default_logger();
+}
+
 Lifetime Lifetime::create_nested() const
 {
-	Lifetime lw(false);
+	Lifetime lw(ptr->resource());
 	ptr->attach_nested(lw.ptr);
 	return lw;
 }
@@ -58,6 +58,12 @@ public:
 
 	explicit Lifetime(bool is_eternal = false);
 
+	/**
+	 * \brief Creates a lifetime whose nested lifetimes and actions are allocated from [resource], as the models living
+	 * in it are expected to be.
+	 */
+	explicit Lifetime(std::shared_ptr<memory_resource> resource);
+
 	LifetimeImpl* operator->() const;
 
 	Lifetime create_nested() const;
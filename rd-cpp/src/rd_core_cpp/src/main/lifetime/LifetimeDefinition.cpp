@@ -8,7 +8,12 @@ LifetimeDefinition::LifetimeDefinition(bool eternaled) : lifetime(eternaled)
 {
 }
 
-LifetimeDefinition::LifetimeDefinition(const Lifetime& parent) : LifetimeDefinition(false)
+LifetimeDefinition::LifetimeDefinition(const Lifetime& parent) : LifetimeDefinition(parent, parent->resource())
+{
+}
+
+LifetimeDefinition::LifetimeDefinition(const Lifetime& parent, std::shared_ptr<memory_resource> resource)
+	: lifetime(std::move(resource))
 {
 	parent->attach_nested(lifetime.ptr);
 }
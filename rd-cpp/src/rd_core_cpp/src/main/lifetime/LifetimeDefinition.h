@@ -26,6 +26,13 @@ public:
 
 	explicit LifetimeDefinition(const Lifetime& parent);
 
+	/**
+	 * \brief Creates a definition nested in [parent] whose lifetime allocates from [resource] instead of the memory
+	 * of [parent], e.g. an arena for the model about to be created in it. The lifetime keeps [resource] for as long as
+	 * it's referenced.
+	 */
+	LifetimeDefinition(const Lifetime& parent, std::shared_ptr<memory_resource> resource);
+
 	LifetimeDefinition(LifetimeDefinition const& other) = delete;
 
 	LifetimeDefinition& operator=(LifetimeDefinition const& other) = delete;
@@ -8,7 +8,15 @@ namespace rd
 LifetimeImpl::counter_t LifetimeImpl::get_id = 0;
 #endif
 
-LifetimeImpl::LifetimeImpl(bool is_eternal) : eternaled(is_eternal), id(LifetimeImpl::get_id++)
+LifetimeImpl::LifetimeImpl(bool is_eternal) : LifetimeImpl(is_eternal, nullptr)
+{
+}
+
+LifetimeImpl::LifetimeImpl(bool is_eternal, std::shared_ptr<memory_resource> resource)
+	: eternaled(is_eternal)
+	, id(LifetimeImpl::get_id++)
+	, resource_(std::move(resource))
+	, actions(0, action_allocator_t(resource_.get()))
 {
 }
 
@@ -21,7 +29,7 @@ void LifetimeImpl::terminate()
 
 	// region thread-safety section
 
-	actions_t actions_copy;
+	actions_t actions_copy(0, actions.get_allocator());
 	{
 		std::lock_guard<decltype(actions_lock)> guard(actions_lock);
 		actions_copy = std::move(actions);
@@ -46,6 +54,11 @@ bool LifetimeImpl::is_eternal() const
 	return eternaled;
 }
 
+std::shared_ptr<memory_resource> const& LifetimeImpl::resource() const
+{
+	return resource_;
+}
+
 void LifetimeImpl::attach_nested(std::shared_ptr<LifetimeImpl> nested)
 {
 	if (nested->is_terminated() || is_eternal())
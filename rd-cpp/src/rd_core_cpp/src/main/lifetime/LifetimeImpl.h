@@ -2,6 +2,7 @@
 #define RD_CPP_CORE_LIFETIME_H
 
 #include <std/hash.h>
+#include <std/memory_resource.h>
 
 #include <functional>
 #include <map>
@@ -9,6 +10,7 @@
 #include <mutex>
 #include <atomic>
 #include <utility>
+#include <vector>
 
 #include <thirdparty.hpp>
 
@@ -24,6 +26,7 @@ public:
 	friend class LifetimeDefinition;
 	friend class SequentialLifetimes;
 	friend class Lifetime;
+	friend class ViewLifetimes;
 
 	using counter_t = int32_t;
 
@@ -34,7 +37,15 @@ private:
 	counter_t id = 0;
 
 	counter_t action_id_in_map = 0;
-	using actions_t = ordered_map<int, std::function<void()>, rd::hash<int>>;
+	// memory of the model living in this lifetime, inherited by the nested lifetimes; null for the global heap
+	std::shared_ptr<memory_resource> resource_;
+	// vector-backed and created without buckets, so that a lifetime allocates nothing until its first action:
+	// most nested lifetimes (e.g. entries of viewable collections) get a few actions or none;
+	// the actions never outlive resource_, so their allocator doesn't own it
+	using action_t = std::pair<int, std::function<void()>>;
+	using action_allocator_t = resource_allocator<action_t>;
+	using actions_t = ordered_map<int, std::function<void()>, rd::hash<int>, std::equal_to<int>, action_allocator_t,
+		std::vector<action_t, action_allocator_t>>;
 	actions_t actions;
 
 	void terminate();
@@ -45,6 +56,8 @@ public:
 	// region ctor/dtor
 	explicit LifetimeImpl(bool is_eternal = false);
 
+	LifetimeImpl(bool is_eternal, std::shared_ptr<memory_resource> resource);
+
 	LifetimeImpl(LifetimeImpl const& other) = delete;
 
 	~LifetimeImpl();
@@ -125,6 +138,11 @@ public:
 
 	bool is_eternal() const;
 
+	/**
+	 * \return the memory of the model living in this lifetime, null when it lives in the global heap.
+	 */
+	std::shared_ptr<memory_resource> const& resource() const;
+
 	void attach_nested(std::shared_ptr<LifetimeImpl> nested);
 };
 }	 // namespace rd
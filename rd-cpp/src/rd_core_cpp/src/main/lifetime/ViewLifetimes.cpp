@@ -0,0 +1,114 @@
+#include "ViewLifetimes.h"
+
+#include <utility>
+
+namespace rd
+{
+constexpr ViewLifetimes::slot_t ViewLifetimes::RELEASED;
+
+ViewLifetimes::slot_t ViewLifetimes::acquire()
+{
+	slots.push_back(terminated ? Lifetime::Terminated() : Lifetime());
+	return static_cast<slot_t>(slots.size() - 1);
+}
+
+Lifetime const& ViewLifetimes::at(slot_t slot) const
+{
+	return slots[slot];
+}
+
+void ViewLifetimes::release(slot_t slot)
+{
+	if (terminated)
+		return;
+
+	// termination may modify the collection again, so bookkeeping goes first
+	const Lifetime lifetime = slots[slot];
+	slots[slot] = Lifetime::Terminated();
+	++released;
+	if (released > 16 && released * 2 > slots.size())
+	{
+		compact();
+	}
+	lifetime->terminate();
+}
+
+void ViewLifetimes::compact()
+{
+	std::vector<slot_t> remap(slots.size(), RELEASED);
+	slot_t live = 0;
+	for (slot_t slot = 0; slot < slots.size(); ++slot)
+	{
+		if (!slots[slot]->is_terminated())
+		{
+			remap[slot] = live;
+			slots[live++] = std::move(slots[slot]);
+		}
+	}
+	slots.resize(live, Lifetime::Terminated());
+	released = 0;
+	on_compacted(remap);
+}
+
+void ViewLifetimes::reserve(size_t count)
+{
+	slots.reserve(count);
+}
+
+void ViewLifetimes::terminate()
+{
+	terminated = true;
+
+	std::vector<Lifetime> slots_copy = std::move(slots);
+	slots.clear();
+	released = 0;
+
+	for (auto it = slots_copy.rbegin(); it != slots_copy.rend(); ++it)
+	{
+		if (!(*it)->is_terminated())
+		{
+			(*it)->terminate();
+		}
+	}
+}
+
+void ViewLifetimes::attach(std::shared_ptr<ViewLifetimes> const& view, Lifetime const& lifetime)
+{
+	if (lifetime->is_eternal())
+		return;
+	if (lifetime->is_terminated())
+	{
+		view->terminate();
+		return;
+	}
+	lifetime->add_action([view] { view->terminate(); });
+}
+
+void IndexedViewLifetimes::reserve(size_t count)
+{
+	ViewLifetimes::reserve(count);
+	positions.reserve(count);
+}
+
+Lifetime IndexedViewLifetimes::insert(size_t index)
+{
+	slot_t slot = acquire();
+	positions.insert(positions.begin() + index, slot);
+	return at(slot);
+}
+
+void IndexedViewLifetimes::erase(size_t index)
+{
+	slot_t slot = positions[index];
+	positions.erase(positions.begin() + index);
+	release(slot);
+}
+
+void IndexedViewLifetimes::on_compacted(std::vector<slot_t> const& remap)
+{
+	for (auto& slot : positions)
+	{
+		slot = remap[slot];
+	}
+}
+}	 // namespace rd
@@ -0,0 +1,146 @@
+#ifndef RD_CPP_CORE_VIEW_LIFETIMES_H
+#define RD_CPP_CORE_VIEW_LIFETIMES_H
+
+#include "Lifetime.h"
+
+#include <util/core_util.h>
+#include <std/unordered_map.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <rd_core_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Lifetimes of the entries of a single view subscription of a viewable collection.
+ *
+ * \details Entry lifetimes aren't nested into the subscription lifetime one by one, which costs an action in the parent
+ * and in the child per entry. Instead they are kept in a flat array of slots and terminated all at once by a single
+ * action when the subscription lifetime ends. Slots of removed entries are reclaimed by occasional compaction,
+ * which keeps the entries in creation order, so they are terminated in the same order as nested lifetimes would be.
+ */
+class RD_CORE_API ViewLifetimes
+{
+public:
+	using slot_t = uint32_t;
+
+private:
+	std::vector<Lifetime> slots;
+	size_t released = 0;
+	bool terminated = false;
+
+	void compact();
+
+protected:
+	static constexpr slot_t RELEASED = static_cast<slot_t>(-1);
+
+	/// \brief Creates a lifetime for a new entry, already terminated if the subscription is over.
+	slot_t acquire();
+
+	Lifetime const& at(slot_t slot) const;
+
+	/// \brief Terminates the entry lifetime in [slot]. The slot mustn't be used afterwards.
+	void release(slot_t slot);
+
+	/// \brief Called after compaction, [remap] maps old slots of live entries to the new ones.
+	virtual void on_compacted(std::vector<slot_t> const& remap) = 0;
+
+public:
+	// region ctor/dtor
+
+	ViewLifetimes() = default;
+
+	ViewLifetimes(ViewLifetimes const&) = delete;
+
+	ViewLifetimes& operator=(ViewLifetimes const&) = delete;
+
+	virtual ~ViewLifetimes() = default;
+	// endregion
+
+	void reserve(size_t count);
+
+	/// \brief Terminates all live entry lifetimes in reverse creation order.
+	void terminate();
+
+	/// \brief Makes [view] terminate when [lifetime] does. Should be called after the subscription is advised,
+	/// so that entries are terminated before the subscription itself.
+	static void attach(std::shared_ptr<ViewLifetimes> const& view, Lifetime const& lifetime);
+};
+
+/**
+ * \brief Entry lifetimes of a map or set view, keyed by the stored key.
+ */
+template <typename K>
+class KeyedViewLifetimes final : public ViewLifetimes
+{
+	rd::unordered_map<K const*, slot_t, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>> index;
+
+public:
+	void reserve(size_t count)
+	{
+		ViewLifetimes::reserve(count);
+		index.reserve(count);
+	}
+
+	bool contains(K const& key) const
+	{
+		return index.count(&key) > 0;
+	}
+
+	/// \param key must stay valid until the entry is removed.
+	Lifetime add(K const& key)
+	{
+		slot_t slot = acquire();
+		auto const& it = index.emplace(&key, slot);
+		RD_ASSERT_MSG(it.second, "lifetime definition already exists in view by key:" + to_string(key));
+		return at(slot);
+	}
+
+	void remove(K const& key)
+	{
+		auto it = index.find(&key);
+		RD_ASSERT_MSG(it != index.end(), "attempting to remove non-existing lifetime in view by key:" + to_string(key));
+		if (it == index.end())
+			return;
+		slot_t slot = it->second;
+		index.erase(it);
+		release(slot);
+	}
+
+protected:
+	void on_compacted(std::vector<slot_t> const& remap) override
+	{
+		for (auto& it : index)
+		{
+			it.second = remap[it.second];
+		}
+	}
+};
+
+/**
+ * \brief Entry lifetimes of a list view, kept in the order of list elements.
+ */
+class RD_CORE_API IndexedViewLifetimes final : public ViewLifetimes
+{
+	std::vector<slot_t> positions;
+
+protected:
+	void on_compacted(std::vector<slot_t> const& remap) override;
+
+public:
+	void reserve(size_t count);
+
+	Lifetime insert(size_t index);
+
+	void erase(size_t index);
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_CORE_VIEW_LIFETIMES_H
@@ -0,0 +1,102 @@
+#include "MonotonicArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace rd
+{
+constexpr size_t MonotonicArena::HEADER_SIZE;
+constexpr size_t MonotonicArena::DEFAULT_FIRST_CHUNK_SIZE;
+constexpr size_t MonotonicArena::MAX_CHUNK_SIZE;
+
+namespace
+{
+char* align_up(char* p, size_t alignment)
+{
+	const auto address = reinterpret_cast<uintptr_t>(p);
+	return p + ((alignment - address % alignment) % alignment);
+}
+}	 // namespace
+
+MonotonicArena::MonotonicArena(size_t first_chunk_size) : next_chunk_size(std::max<size_t>(first_chunk_size, 2 * HEADER_SIZE))
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+	Chunk* chunk = current.load(std::memory_order_acquire);
+	while (chunk != nullptr)
+	{
+		Chunk* previous = chunk->previous;
+		chunk->~Chunk();
+		::operator delete(chunk);
+		chunk = previous;
+	}
+}
+
+void* MonotonicArena::bump(Chunk* chunk, size_t bytes, size_t alignment)
+{
+	const auto begin = reinterpret_cast<char*>(chunk);
+	size_t used = chunk->used.load(std::memory_order_relaxed);
+	while (true)
+	{
+		char* p = align_up(begin + used, alignment);
+		const auto end = static_cast<size_t>(p - begin);
+		if (bytes > chunk->size || end > chunk->size - bytes)
+		{
+			return nullptr;
+		}
+		if (chunk->used.compare_exchange_weak(used, end + bytes, std::memory_order_relaxed))
+		{
+			return p;
+		}
+	}
+}
+
+MonotonicArena::Chunk* MonotonicArena::grow(Chunk* full, size_t bytes, size_t alignment)
+{
+	std::lock_guard<std::mutex> guard(grow_lock);
+	Chunk* last = current.load(std::memory_order_acquire);
+	if (last != full)
+	{
+		// another thread has added a chunk meanwhile
+		return last;
+	}
+	const size_t size = std::max(next_chunk_size, HEADER_SIZE + bytes + alignment);
+	auto chunk = new (::operator new(size)) Chunk(last, size, HEADER_SIZE);
+	reserved.fetch_add(size, std::memory_order_relaxed);
+	next_chunk_size = std::min(next_chunk_size * 2, MAX_CHUNK_SIZE);
+	current.store(chunk, std::memory_order_release);
+	return chunk;
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+	Chunk* chunk = current.load(std::memory_order_acquire);
+	while (true)
+	{
+		void* p = chunk == nullptr ? nullptr : bump(chunk, bytes, alignment);
+		if (p != nullptr)
+		{
+			allocated.fetch_add(bytes, std::memory_order_relaxed);
+			return p;
+		}
+		chunk = grow(chunk, bytes, alignment);
+	}
+}
+
+void MonotonicArena::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/)
+{
+}
+
+size_t MonotonicArena::allocated_bytes() const
+{
+	return allocated.load(std::memory_order_relaxed);
+}
+
+size_t MonotonicArena::reserved_bytes() const
+{
+	return reserved.load(std::memory_order_relaxed);
+}
+}	 // namespace rd
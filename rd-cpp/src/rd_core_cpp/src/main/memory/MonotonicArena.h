@@ -0,0 +1,92 @@
+#ifndef RD_CPP_CORE_MONOTONIC_ARENA_H
+#define RD_CPP_CORE_MONOTONIC_ARENA_H
+
+#include "std/memory_resource.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include <rd_core_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Memory for a model that is freed all at once: allocation bumps a pointer through chunks that double in size,
+ * deallocation does nothing, and the chunks are freed when the arena is destroyed.
+ *
+ * \details Suits models that mostly grow until they are torn down. Give it to the lifetime of the model, see
+ * LifetimeDefinition(const Lifetime&, std::shared_ptr<memory_resource>), which keeps it for as long as the lifetime is
+ * referenced, and pass it to the resource_allocator of its collections, which have to be released before.
+ * Teardown still runs the destructors of the entries and the actions of their lifetimes, it costs O(n) of the model
+ * size as with the global heap: only the frees are saved.
+ * As nothing is reused, a long-lived model whose entries are replaced or removed keeps growing for as long as it lives,
+ * give it a PoolArena instead.
+ * It's safe to use from several threads: allocation bumps the pointer of the current chunk with a compare-and-swap,
+ * only adding a chunk takes a lock.
+ */
+class RD_CORE_API MonotonicArena final : public memory_resource
+{
+	struct Chunk
+	{
+		Chunk* const previous;
+		const size_t size;
+		// offset of the free memory from the start of the chunk
+		std::atomic<size_t> used;
+
+		Chunk(Chunk* previous, size_t size, size_t used) : previous(previous), size(size), used(used)
+		{
+		}
+	};
+
+	// the chunk header is padded so that the memory after it has the strictest fundamental alignment
+	static constexpr size_t HEADER_SIZE =
+		(sizeof(Chunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+	std::atomic<Chunk*> current{nullptr};
+	std::mutex grow_lock;
+	size_t next_chunk_size;
+	std::atomic<size_t> allocated{0};
+	std::atomic<size_t> reserved{0};
+
+	static void* bump(Chunk* chunk, size_t bytes, size_t alignment);
+
+	Chunk* grow(Chunk* full, size_t bytes, size_t alignment);
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+public:
+	static constexpr size_t DEFAULT_FIRST_CHUNK_SIZE = 4096;
+	static constexpr size_t MAX_CHUNK_SIZE = 1 << 20;
+
+	// region ctor/dtor
+
+	explicit MonotonicArena(size_t first_chunk_size = DEFAULT_FIRST_CHUNK_SIZE);
+
+	MonotonicArena(MonotonicArena const&) = delete;
+
+	MonotonicArena& operator=(MonotonicArena const&) = delete;
+
+	~MonotonicArena() override;
+	// endregion
+
+	/**
+	 * \return bytes handed out so far, deallocated ones included.
+	 */
+	size_t allocated_bytes() const;
+
+	/**
+	 * \return bytes taken from the global heap for the chunks.
+	 */
+	size_t reserved_bytes() const;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_CORE_MONOTONIC_ARENA_H
@@ -0,0 +1,135 @@
+#include "PoolArena.h"
+
+#include <atomic>
+
+namespace rd
+{
+constexpr size_t PoolArena::GRANULARITY;
+constexpr size_t PoolArena::MAX_POOLED_SIZE;
+constexpr size_t PoolArena::SHARDS;
+
+namespace
+{
+size_t rounded_size(size_t bytes)
+{
+	constexpr size_t granularity = PoolArena::GRANULARITY;
+	return bytes == 0 ? granularity : (bytes + granularity - 1) / granularity * granularity;
+}
+
+bool is_pooled(size_t bytes, size_t alignment)
+{
+	return bytes <= PoolArena::MAX_POOLED_SIZE && alignment <= PoolArena::GRANULARITY;
+}
+
+size_t thread_shard()
+{
+	static std::atomic<size_t> next_shard{0};
+	thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % PoolArena::SHARDS;
+	return shard;
+}
+}	 // namespace
+
+PoolArena::FreeBlock* PoolArena::Shard::pop(size_t list)
+{
+	FreeBlock*& free_list = free_lists[list];
+	FreeBlock* block = free_list;
+	if (block != nullptr)
+	{
+		free_list = block->next;
+		free_blocks.store(free_blocks.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+	}
+	return block;
+}
+
+void PoolArena::Shard::push(size_t list, FreeBlock* block)
+{
+	FreeBlock*& free_list = free_lists[list];
+	block->next = free_list;
+	free_list = block;
+	free_blocks.store(free_blocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+PoolArena::PoolArena(size_t first_chunk_size) : upstream(first_chunk_size)
+{
+}
+
+PoolArena::FreeBlock* PoolArena::steal(size_t list, Shard const& own)
+{
+	for (Shard& shard : shards)
+	{
+		if (&shard == &own || shard.free_blocks.load(std::memory_order_relaxed) == 0)
+		{
+			continue;
+		}
+		// a busy shard is skipped rather than waited for, its owner is likely to need its blocks
+		std::unique_lock<std::mutex> guard(shard.lock, std::try_to_lock);
+		if (!guard.owns_lock())
+		{
+			continue;
+		}
+		if (FreeBlock* block = shard.pop(list))
+		{
+			return block;
+		}
+	}
+	return nullptr;
+}
+
+void* PoolArena::do_allocate(size_t bytes, size_t alignment)
+{
+	if (!is_pooled(bytes, alignment))
+	{
+		return alignment <= GRANULARITY ? ::operator new(bytes) : upstream.allocate(bytes, alignment);
+	}
+	const size_t size = rounded_size(bytes);
+	const size_t list = size / GRANULARITY - 1;
+	Shard& own = shards[thread_shard()];
+	{
+		std::lock_guard<std::mutex> guard(own.lock);
+		own.in_use += size;
+		if (FreeBlock* block = own.pop(list))
+		{
+			return block;
+		}
+	}
+	if (FreeBlock* block = steal(list, own))
+	{
+		return block;
+	}
+	return upstream.allocate(size, GRANULARITY);
+}
+
+void PoolArena::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	if (!is_pooled(bytes, alignment))
+	{
+		// over-aligned blocks stay in the chunks until the arena is destroyed
+		if (alignment <= GRANULARITY)
+		{
+			::operator delete(p);
+		}
+		return;
+	}
+	const size_t size = rounded_size(bytes);
+	Shard& own = shards[thread_shard()];
+	std::lock_guard<std::mutex> guard(own.lock);
+	own.in_use -= size;
+	own.push(size / GRANULARITY - 1, static_cast<FreeBlock*>(p));
+}
+
+size_t PoolArena::bytes_in_use() const
+{
+	size_t in_use = 0;
+	for (Shard const& shard : shards)
+	{
+		std::lock_guard<std::mutex> guard(shard.lock);
+		in_use += shard.in_use;
+	}
+	return in_use;
+}
+
+size_t PoolArena::reserved_bytes() const
+{
+	return upstream.reserved_bytes();
+}
+}	 // namespace rd
@@ -0,0 +1,90 @@
+#ifndef RD_CPP_CORE_POOL_ARENA_H
+#define RD_CPP_CORE_POOL_ARENA_H
+
+#include "MonotonicArena.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include <rd_core_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Memory for a model whose entries come and go: small blocks are carved out of the chunks of a MonotonicArena
+ * and reused through free lists by size, the chunks are freed when the arena is destroyed.
+ *
+ * \details Blocks above MAX_POOLED_SIZE come from the global heap and go back to it on deallocation.
+ * It's safe to use from several threads. The free lists are split in SHARDS shards, each with its own lock, and a
+ * thread takes its blocks from and returns them to the shard it was given on its first use of a PoolArena, so threads
+ * share a lock only when there are more of them than shards. A thread whose shard has no block of the size looks
+ * for one in the shards of the others before carving a new one.
+ */
+class RD_CORE_API PoolArena final : public memory_resource
+{
+public:
+	static constexpr size_t GRANULARITY = alignof(std::max_align_t);
+	static constexpr size_t MAX_POOLED_SIZE = 512;
+	static constexpr size_t SHARDS = 8;
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	struct Shard
+	{
+		mutable std::mutex lock;
+		std::array<FreeBlock*, MAX_POOLED_SIZE / GRANULARITY> free_lists{};
+		// lets the other threads skip an empty shard without locking it
+		std::atomic<size_t> free_blocks{0};
+		// wraps around when blocks are deallocated by another thread than the one allocating them, the sum doesn't
+		size_t in_use = 0;
+
+		FreeBlock* pop(size_t list);
+
+		void push(size_t list, FreeBlock* block);
+	};
+
+	MonotonicArena upstream;
+	std::array<Shard, SHARDS> shards;
+
+	FreeBlock* steal(size_t list, Shard const& own);
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override;
+
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+public:
+	// region ctor/dtor
+
+	explicit PoolArena(size_t first_chunk_size = MonotonicArena::DEFAULT_FIRST_CHUNK_SIZE);
+
+	PoolArena(PoolArena const&) = delete;
+
+	PoolArena& operator=(PoolArena const&) = delete;
+
+	~PoolArena() override = default;
+	// endregion
+
+	/**
+	 * \return bytes allocated and not deallocated yet, rounded up to the pooled sizes.
+	 */
+	size_t bytes_in_use() const;
+
+	/**
+	 * \return bytes taken from the global heap for the chunks.
+	 */
+	size_t reserved_bytes() const;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_CORE_POOL_ARENA_H
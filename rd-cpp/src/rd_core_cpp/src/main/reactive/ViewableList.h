@@ -21,15 +21,25 @@ public:
 	using Event = typename IViewableList<T>::Event;
 
 private:
-	using WA = typename std::allocator_traits<A>::template rebind_alloc<Wrapper<T>>;
-
-	using data_t = std::vector<Wrapper<T>, WA>;
+	// getList exposes the wrappers in a std::vector, so only the wrapped values are allocated by alloc
+	using data_t = std::vector<Wrapper<T>>;
 	mutable data_t list;
 	Signal<Event> change;
+	A alloc;
 
 protected:
 	using WT = typename IViewableList<T>::WT;
 
+	static Wrapper<T> wrap(Wrapper<T>&& element)
+	{
+		return std::move(element);
+	}
+
+	Wrapper<T> wrap(T&& element) const
+	{
+		return wrapper::allocate_wrapper<T>(alloc, std::move(element));
+	}
+
 	const std::vector<Wrapper<T>>& getList() const override
 	{
 		return list;
@@ -40,6 +50,13 @@ public:
 
 	ViewableList() = default;
 
+	/**
+	 * \brief Creates a list whose elements are allocated by [alloc], unless they come wrapped already.
+	 */
+	explicit ViewableList(A const& value_allocator) : alloc(value_allocator)
+	{
+	}
+
 	ViewableList(ViewableList&&) = default;
 
 	ViewableList& operator=(ViewableList&&) = default;
@@ -217,14 +234,14 @@ public:
 
 	bool add(WT element) const override
 	{
-		list.emplace_back(std::move(element));
+		list.emplace_back(wrap(std::move(element)));
 		change.fire(typename Event::Add(static_cast<int32_t>(size()) - 1, &(*list.back())));
 		return true;
 	}
 
 	bool add(size_t index, WT element) const override
 	{
-		list.emplace(list.begin() + index, std::move(element));
+		list.emplace(list.begin() + index, wrap(std::move(element)));
 		change.fire(typename Event::Add(static_cast<int32_t>(index), &(*list[index])));
 		return true;
 	}
@@ -257,7 +274,7 @@ public:
 	WT set(size_t index, WT element) const override
 	{
 		auto old_value = std::move(list[index]);
-		list[index] = Wrapper<T>(std::move(element));
+		list[index] = wrap(std::move(element));
 		change.fire(typename Event::Update(static_cast<int32_t>(index), &(*old_value), &(*list[index])));	   //???
 		return wrapper::unwrap<T>(std::move(old_value));
 	}
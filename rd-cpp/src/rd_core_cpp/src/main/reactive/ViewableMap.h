@@ -3,6 +3,7 @@
 
 #include "base/IViewableMap.h"
 #include "reactive/base/SignalX.h"
+#include "reactive/base/ordered_storage.h"
 
 #include <util/core_util.h>
 #include <std/unordered_map.h>
@@ -27,11 +28,11 @@ private:
 	using WK = typename IViewableMap<K, V>::WK;
 	using WV = typename IViewableMap<K, V>::WV;
 	using OV = typename IViewableMap<K, V>::OV;
-	using PA = typename std::allocator_traits<VA>::template rebind_alloc<std::pair<Wrapper<K>, Wrapper<V>>>;
 
 	Signal<Event> change;
 
-	using data_t = ordered_map<Wrapper<K>, Wrapper<V>, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>, PA>;
+	using data_t = ordered_storage<K, V, VA>;
+	using slot_t = typename data_t::slot_t;
 	mutable data_t map;
 
 public:
@@ -39,6 +40,13 @@ public:
 
 	ViewableMap() = default;
 
+	/**
+	 * \brief Creates a map whose entries, and the values it wraps, are allocated by [alloc].
+	 */
+	explicit ViewableMap(VA const& alloc) : map(alloc)
+	{
+	}
+
 	ViewableMap(ViewableMap&&) = default;
 
 	ViewableMap& operator=(ViewableMap&&) = default;
@@ -162,22 +170,22 @@ public:
 
 		reference operator*() const noexcept
 		{
-			return *it_.value();
+			return wrapper::get<V>((*it_)->second);
 		}
 
 		pointer operator->() const noexcept
 		{
-			return it_.value().get();
+			return &wrapper::get<V>((*it_)->second);
 		}
 
 		key_type const& key() const
 		{
-			return *it_.key();
+			return wrapper::get<K>((*it_)->first);
 		}
 
 		value_type const& value() const
 		{
-			return *it_.value();
+			return wrapper::get<V>((*it_)->second);
 		}
 	};
 
@@ -243,73 +251,75 @@ public:
 	{
 		change.advise(lifetime, handler);
 		/*for (auto const &[key, value] : map) {*/
-		for (auto const& it : map)
+		for (auto const slot : map)
 		{
-			auto& key = it.first;
-			auto& value = it.second;
-			handler(Event(typename Event::Add(&(*key), &(*value))));
-			;
+			handler(Event(typename Event::Add(&wrapper::get<K>(slot->first), &wrapper::get<V>(slot->second))));
 		}
 	}
 
 	const V* get(K const& key) const override
 	{
-		auto it = map.find(key);
-		if (it == map.end())
+		auto slot = map.find(key);
+		if (slot == nullptr)
 		{
 			return nullptr;
 		}
-		return &(*it->second);
+		return &wrapper::get<V>(slot->second);
 	}
 
 	const V* set(WK key, WV value) const override
 	{
-		if (map.count(key) == 0)
+		auto slot = map.find(wrapper::get<K>(key));
+		if (slot == nullptr)
 		{
-			/*auto[it, success] = map.emplace(std::make_unique<K>(std::move(key)), std::make_unique<V>(std::move(value)));*/
-			auto node = map.emplace(std::move(key), std::move(value));
-			auto& it = node.first;
-			auto const& key_ptr = it->first;
-			auto const& value_ptr = it->second;
-			change.fire(typename Event::Add(&(*key_ptr), &(*value_ptr)));
+			slot = map.emplace(map.template store<K>(std::move(key)), map.template store<V>(std::move(value))).first;
+			change.fire(typename Event::Add(&wrapper::get<K>(slot->first), &wrapper::get<V>(slot->second)));
 			return nullptr;
 		}
-		else
-		{
-			auto it = map.find(key);
-			auto const& key_ptr = it->first;
-			auto const& value_ptr = it->second;
-
-			if (*value_ptr != wrapper::get<V>(value))
-			{	 // TO-DO more effective
-				Wrapper<V> old_value = std::move(map.at(key));
-
-				map.at(key_ptr) = Wrapper<V>(std::move(value));
-				change.fire(typename Event::Update(&(*key_ptr), &(*old_value), &(*value_ptr)));
-			}
-			return &*(value_ptr);
+
+		if (wrapper::get<V>(slot->second) != wrapper::get<V>(value))
+		{	 // TO-DO more effective
+			// the old value is kept where the handlers have seen it until they are done with the update
+			V const* value_ptr = nullptr;
+			map.replace(
+				slot,
+				[this, &value_ptr](slot_t const& old_entry, slot_t const& new_entry) {
+					value_ptr = &wrapper::get<V>(new_entry.second);
+					change.fire(typename Event::Update(
+						&wrapper::get<K>(new_entry.first), &wrapper::get<V>(old_entry.second), value_ptr));
+				},
+				slot->first, map.template store<V>(std::move(value)));
+			return value_ptr;
 		}
+		return &wrapper::get<V>(slot->second);
 	}
 
 	OV remove(K const& key) const override
 	{
-		if (map.count(key) > 0)
+		auto slot = map.find(key);
+		if (slot == nullptr)
+		{
+			return nullopt;
+		}
+		change.fire(typename Event::Remove(&key, &wrapper::get<V>(slot->second)));
+		// handlers may have removed it already
+		slot = map.find(key);
+		if (slot == nullptr)
 		{
-			Wrapper<V> old_value = std::move(map.at(key));
-			change.fire(typename Event::Remove(&key, &(*old_value)));
-			map.erase(key);
-			return wrapper::unwrap<V>(std::move(old_value));
+			return nullopt;
 		}
-		return nullopt;
+		collection_storage<V> old_value = std::move(slot->second);
+		map.erase(key);
+		return wrapper::unwrap<V>(std::move(old_value));
 	}
 
 	void clear() const override
 	{
 		std::vector<Event> changes;
 		/*for (auto const &[key, value] : map) {*/
-		for (auto const& it : map)
+		for (auto const slot : map)
 		{
-			changes.push_back(typename Event::Remove(&(*it.first), &(*it.second)));
+			changes.push_back(typename Event::Remove(&wrapper::get<K>(slot->first), &wrapper::get<V>(slot->second)));
 		}
 		for (auto const& it : changes)
 		{
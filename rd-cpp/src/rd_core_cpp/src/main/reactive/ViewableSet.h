@@ -3,6 +3,7 @@
 
 #include "base/IViewableSet.h"
 #include "reactive/base/SignalX.h"
+#include "reactive/base/ordered_storage.h"
 
 #include <std/allocator.h>
 #include <util/core_util.h>
@@ -23,10 +24,9 @@ public:
 
 private:
 	using WT = typename IViewableSet<T, A>::WT;
-	using WA = typename std::allocator_traits<A>::template rebind_alloc<Wrapper<T>>;
 
 	Signal<Event> change;
-	using data_t = ordered_set<Wrapper<T>, wrapper::TransparentHash<T>, wrapper::TransparentKeyEqual<T>, WA>;
+	using data_t = ordered_storage<T, void, A>;
 	mutable data_t set;
 
 public:
@@ -34,6 +34,13 @@ public:
 
 	ViewableSet() = default;
 
+	/**
+	 * \brief Creates a set whose elements, and the ones it wraps, are allocated by [alloc].
+	 */
+	explicit ViewableSet(A const& alloc) : set(alloc)
+	{
+	}
+
 	ViewableSet(ViewableSet&&) = default;
 
 	ViewableSet& operator=(ViewableSet&&) = default;
@@ -155,12 +162,12 @@ public:
 
 		reference operator*() const noexcept
 		{
-			return **it_;
+			return wrapper::get<T>(**it_);
 		}
 
 		pointer operator->() const noexcept
 		{
-			return (*it_).get();
+			return &wrapper::get<T>(**it_);
 		}
 	};
 
@@ -191,12 +198,12 @@ public:
 	bool add(WT element) const override
 	{
 		/*auto const &[it, success] = set.emplace(std::make_unique<T>(std::move(element)));*/
-		auto const& it = set.emplace(std::move(element));
+		auto const& it = set.emplace(set.template store<T>(std::move(element)));
 		if (!it.second)
 		{
 			return false;
 		}
-		change.fire(Event(AddRemove::ADD, &(wrapper::get<T>(*it.first))));
+		change.fire(Event(AddRemove::ADD, &wrapper::get<T>(*it.first)));
 		return true;
 	}
 
@@ -212,9 +219,9 @@ public:
 	void clear() const override
 	{
 		std::vector<Event> changes;
-		for (auto const& element : set)
+		for (auto const slot : set)
 		{
-			changes.push_back(Event(AddRemove::REMOVE, &(*element)));
+			changes.push_back(Event(AddRemove::REMOVE, &wrapper::get<T>(*slot)));
 		}
 		for (auto const& e : changes)
 		{
@@ -229,17 +236,17 @@ public:
 		{
 			return false;
 		}
-		auto it = set.find(element);
-		change.fire(Event(AddRemove::REMOVE, &(wrapper::get<T>(*it))));
-		set.erase(it);
+		auto slot = set.find(element);
+		change.fire(Event(AddRemove::REMOVE, &wrapper::get<T>(*slot)));
+		set.erase(element);
 		return true;
 	}
 
 	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override
 	{
-		for (auto const& x : set)
+		for (auto const slot : set)
 		{
-			handler(Event(AddRemove::ADD, &(*x)));
+			handler(Event(AddRemove::ADD, &wrapper::get<T>(*slot)));
 		}
 		change.advise(lifetime, handler);
 	}
@@ -251,7 +258,7 @@ public:
 
 	bool contains(T const& element) const override
 	{
-		return set.count(element) > 0;
+		return set.contains(element);
 	}
 
 	bool empty() const override
@@ -5,6 +5,7 @@
 #include "viewable_collections.h"
 
 #include <lifetime/LifetimeDefinition.h>
+#include <lifetime/ViewLifetimes.h>
 #include <util/overloaded.h>
 #include <types/wrapper.h>
 
@@ -118,9 +119,6 @@ public:
 	 */
 	using Event = typename detail::ListEvent<T>;
 
-protected:
-	mutable rd::unordered_map<Lifetime, std::vector<LifetimeDefinition>> lifetimes;
-
 public:
 	// region ctor/dtor
 
@@ -141,13 +139,13 @@ public:
 	 */
 	void advise_add_remove(Lifetime lifetime, std::function<void(AddRemove, size_t, T const&)> handler) const
 	{
-		advise(lifetime, [handler](Event e) {
-			visit(util::make_visitor([handler](typename Event::Add const& e) { handler(AddRemove::ADD, e.index, *e.new_value); },
-					  [handler](typename Event::Update const& e) {
+		advise(lifetime, [handler](Event const& e) {
+			visit(util::make_visitor([&handler](typename Event::Add const& e) { handler(AddRemove::ADD, e.index, *e.new_value); },
+					  [&handler](typename Event::Update const& e) {
 						  handler(AddRemove::REMOVE, e.index, *e.old_value);
 						  handler(AddRemove::ADD, e.index, *e.new_value);
 					  },
-					  [handler](typename Event::Remove const& e) { handler(AddRemove::REMOVE, e.index, *e.old_value); }),
+					  [&handler](typename Event::Remove const& e) { handler(AddRemove::REMOVE, e.index, *e.old_value); }),
 				e.v);
 		});
 	}
@@ -167,27 +165,24 @@ public:
 	 */
 	void view(Lifetime lifetime, std::function<void(Lifetime, size_t, T const&)> handler) const
 	{
-		advise_add_remove(lifetime, [this, lifetime, handler](AddRemove kind, size_t idx, T const& value) {
+		auto entries = std::make_shared<IndexedViewLifetimes>();
+		entries->reserve(size());
+		advise_add_remove(lifetime, [entries, handler](AddRemove kind, size_t idx, T const& value) {
 			switch (kind)
 			{
 				case AddRemove::ADD:
 				{
-					LifetimeDefinition def(lifetime);
-					std::vector<LifetimeDefinition>& v = lifetimes[lifetime];
-					auto it = v.emplace(v.begin() + idx, std::move(def));
-					handler(it->lifetime, idx, value);
+					handler(entries->insert(idx), idx, value);
 					break;
 				}
 				case AddRemove::REMOVE:
 				{
-					LifetimeDefinition def = std::move(lifetimes.at(lifetime)[idx]);
-					std::vector<LifetimeDefinition>& v = lifetimes.at(lifetime);
-					v.erase(v.begin() + idx);
-					def.terminate();
+					entries->erase(idx);
 					break;
 				}
 			}
 		});
+		ViewLifetimes::attach(entries, lifetime);
 	}
 
 	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override = 0;
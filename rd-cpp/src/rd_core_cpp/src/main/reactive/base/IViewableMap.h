@@ -2,6 +2,7 @@
 #define RD_CPP_IVIEWABLEMAP_H
 
 #include "lifetime/LifetimeDefinition.h"
+#include "lifetime/ViewLifetimes.h"
 #include "util/overloaded.h"
 #include "interfaces.h"
 #include "viewable_collections.h"
@@ -121,10 +122,6 @@ protected:
 	using WV = value_or_wrapper<V>;
 	using OV = opt_or_wrapper<V>;
 
-	mutable rd::unordered_map<Lifetime,
-		ordered_map<K const*, LifetimeDefinition, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>>>
-		lifetimes;
-
 public:
 	/**
 	 * \brief Represents an addition, update or removal of an element in the map.
@@ -147,34 +144,27 @@ public:
 									 >
 									 handler) const override
 	{
-		advise_add_remove(lifetime, [this, lifetime, handler](AddRemove kind, K const& key, V const& value) {
-			const std::pair<K const*, V const*> entry = std::make_pair(&key, &value);
+		auto entries = std::make_shared<KeyedViewLifetimes<K>>();
+		entries->reserve(size());
+		advise_add_remove(lifetime, [entries, handler](AddRemove kind, K const& key, V const& value) {
 			switch (kind)
 			{
 				case AddRemove::ADD:
 				{
-					if (lifetimes[lifetime].count(key) == 0)
+					if (!entries->contains(key))
 					{
-						/*auto const &[it, inserted] = lifetimes[lifetime].emplace(key, LifetimeDefinition(lifetime));*/
-						auto const& pair = lifetimes[lifetime].emplace(&key, LifetimeDefinition(lifetime));
-						auto& it = pair.first;
-						auto& inserted = pair.second;
-						RD_ASSERT_MSG(inserted, "lifetime definition already exists in viewable map by key:" + to_string(key));
-						handler(it->second.lifetime, entry);
+						handler(entries->add(key), std::make_pair(&key, &value));
 					}
 					break;
 				}
 				case AddRemove::REMOVE:
 				{
-					RD_ASSERT_MSG(lifetimes.at(lifetime).count(key) > 0,
-						"attempting to remove non-existing lifetime in viewable map by key:" + to_string(key));
-					LifetimeDefinition def = std::move(lifetimes.at(lifetime).at(key));
-					lifetimes.at(lifetime).erase(key);
-					def.terminate();
+					entries->remove(key);
 					break;
 				}
 			}
 		});
+		ViewLifetimes::attach(entries, lifetime);
 	}
 
 	/**
@@ -188,13 +178,13 @@ public:
 												  >
 												  handler) const
 	{
-		advise(lifetime, [handler](Event e) {
-			visit(util::make_visitor([handler](typename Event::Add const& e) { handler(AddRemove::ADD, *e.key, *e.new_value); },
-					  [handler](typename Event::Update const& e) {
+		advise(lifetime, [handler](Event const& e) {
+			visit(util::make_visitor([&handler](typename Event::Add const& e) { handler(AddRemove::ADD, *e.key, *e.new_value); },
+					  [&handler](typename Event::Update const& e) {
 						  handler(AddRemove::REMOVE, *e.key, *e.old_value);
 						  handler(AddRemove::ADD, *e.key, *e.new_value);
 					  },
-					  [handler](typename Event::Remove const& e) { handler(AddRemove::REMOVE, *e.key, *e.old_value); }),
+					  [&handler](typename Event::Remove const& e) { handler(AddRemove::REMOVE, *e.key, *e.old_value); }),
 				e.v);
 		});
 	}
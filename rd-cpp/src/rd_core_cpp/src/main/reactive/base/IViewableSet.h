@@ -5,6 +5,7 @@
 #include "viewable_collections.h"
 
 #include <lifetime/LifetimeDefinition.h>
+#include <lifetime/ViewLifetimes.h>
 #include <util/core_util.h>
 
 #include <std/unordered_map.h>
@@ -42,9 +43,6 @@ class IViewableSet : public IViewable<T>, public ISource<detail::SetEvent<T>>
 {
 protected:
 	using WT = value_or_wrapper<T>;
-	mutable rd::unordered_map<Lifetime,
-		ordered_map<T const*, LifetimeDefinition, wrapper::TransparentHash<T>, wrapper::TransparentKeyEqual<T>>>
-		lifetimes;
 
 public:
 	// region ctor/dtor
@@ -87,28 +85,24 @@ public:
 	 */
 	void view(Lifetime lifetime, std::function<void(Lifetime, T const&)> handler) const override
 	{
-		advise(lifetime, [this, lifetime, handler](AddRemove kind, T const& key) {
+		auto entries = std::make_shared<KeyedViewLifetimes<T>>();
+		entries->reserve(size());
+		advise(lifetime, [entries, handler](AddRemove kind, T const& key) {
 			switch (kind)
 			{
 				case AddRemove::ADD:
 				{
-					/*auto const &[it, inserted] = lifetimes[lifetime].emplace(key, LifetimeDefinition(lifetime));*/
-					auto const& it = lifetimes[lifetime].emplace(&key, lifetime);
-					RD_ASSERT_MSG(it.second, "lifetime definition already exists in viewable set by key:" + to_string(key));
-					handler(it.first->second.lifetime, key);
+					handler(entries->add(key), key);
 					break;
 				}
 				case AddRemove::REMOVE:
 				{
-					RD_ASSERT_MSG(lifetimes.at(lifetime).count(key) > 0,
-						"attempting to remove non-existing lifetime in viewable set by key:" + to_string(key));
-					LifetimeDefinition def = std::move(lifetimes.at(lifetime).at(key));
-					lifetimes.at(lifetime).erase(key);
-					def.terminate();
+					entries->remove(key);
 					break;
 				}
 			}
 		});
+		ViewLifetimes::attach(entries, lifetime);
 	}
 
 	/**
@@ -108,7 +108,13 @@ private:
 	{
 		if (lifetime->is_terminated())
 			return;
-		auto event_ptr = std::make_shared<Event>(lifetime, std::forward<F>(handler));
+		// the listener is allocated from the memory of the model advising, the signal may keep it after its lifetime
+		// until it's fired again, so the listener keeps the memory
+		using event_allocator_t = shared_resource_allocator<Event>;
+		auto const& resource = lifetime->resource();
+		auto event_ptr = resource == nullptr
+							 ? std::make_shared<Event>(lifetime, std::forward<F>(handler))
+							 : std::allocate_shared<Event>(event_allocator_t(resource), lifetime, std::forward<F>(handler));
 		lifetime->add_action([event_ptr] { event_ptr->terminate(); });
 		queue.push_back(std::move(event_ptr));
 	}
@@ -0,0 +1,377 @@
+#ifndef RD_CPP_CORE_ORDERED_STORAGE_H
+#define RD_CPP_CORE_ORDERED_STORAGE_H
+
+#include "types/wrapper.h"
+#include "util/core_traits.h"
+#include "util/core_util.h"
+
+#include <thirdparty.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rd
+{
+/**
+ * \brief How viewable collections keep a T: in place when it's small and moves without throwing, wrapped otherwise.
+ */
+template <typename T>
+using collection_storage = std::conditional_t<util::in_place_v<T>, T, Wrapper<T>>;
+
+namespace detail
+{
+template <typename K, typename V>
+struct ordered_storage_slot
+{
+	using type = std::pair<collection_storage<K>, collection_storage<V>>;
+
+	static K const& key(type const& slot)
+	{
+		return wrapper::get<K>(slot.first);
+	}
+};
+
+template <typename K>
+struct ordered_storage_slot<K, void>
+{
+	using type = collection_storage<K>;
+
+	static K const& key(type const& slot)
+	{
+		return wrapper::get<K>(slot);
+	}
+};
+}	 // namespace detail
+
+/**
+ * \brief Entries of a viewable collection in insertion order, with O(1) amortized lookup, insertion and removal.
+ * An entry of a set ([V] is void) is its key, an entry of a map is a pair of its key and value.
+ *
+ * \details Entries are constructed in blocks and don't move until they are removed, so the keys and values passed
+ * to handlers stay valid for as long as their entries are in the storage, whether they are kept in place or wrapped.
+ * The order is kept as pointers to the entries. A removed entry leaves a tombstone, a null pointer, instead of
+ * shifting the following ones. Tombstones are dropped when they outnumber the entries and before iteration, so
+ * iterators walk contiguous pointers in insertion order and are random access. Any modification invalidates them.
+ */
+template <typename K, typename V, typename A = std::allocator<K>>
+class ordered_storage
+{
+	using slot_traits = detail::ordered_storage_slot<K, V>;
+
+public:
+	using slot_t = typename slot_traits::type;
+
+private:
+	using slot_allocator_t = typename std::allocator_traits<A>::template rebind_alloc<slot_t>;
+	using slot_allocator_traits = std::allocator_traits<slot_allocator_t>;
+	using pointers_t = std::vector<slot_t*, typename std::allocator_traits<A>::template rebind_alloc<slot_t*>>;
+
+public:
+	using iterator = typename pointers_t::iterator;
+
+private:
+	using index_entry_t = std::pair<K const*, size_t>;
+	using index_allocator_t = typename std::allocator_traits<A>::template rebind_alloc<index_entry_t>;
+	// keyed by the stored keys, whose addresses don't change while they are in the storage; the order of the index
+	// doesn't matter, so it's erased from in O(1)
+	using index_t = ordered_map<K const*, size_t, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>,
+		index_allocator_t, std::vector<index_entry_t, index_allocator_t>>;
+
+	static constexpr size_t MIN_TOMBSTONES_TO_COMPACT = 16;
+	static constexpr size_t FIRST_BLOCK_SLOTS = 4;
+	static constexpr size_t MAX_BLOCK_SLOTS = sizeof(slot_t) > 256 ? 16 : 4096 / sizeof(slot_t);
+
+	slot_allocator_t alloc;
+	pointers_t blocks;
+	// slots at the end of the last block that haven't been used yet
+	size_t unused_in_block = 0;
+	pointers_t free_slots;
+
+	pointers_t order;
+	index_t index;
+	size_t tombstones = 0;
+
+	// blocks double in size up to MAX_BLOCK_SLOTS, so that small collections stay small
+	static size_t block_slots(size_t block)
+	{
+		return block >= 16 ? MAX_BLOCK_SLOTS : std::min<size_t>(MAX_BLOCK_SLOTS, FIRST_BLOCK_SLOTS << block);
+	}
+
+	template <typename... Args>
+	slot_t* construct(Args&&... args)
+	{
+		slot_t* slot;
+		if (!free_slots.empty())
+		{
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		else
+		{
+			if (unused_in_block == 0)
+			{
+				const size_t slots = block_slots(blocks.size());
+				slot_t* block = slot_allocator_traits::allocate(alloc, slots);
+				try
+				{
+					blocks.push_back(block);
+				}
+				catch (...)
+				{
+					slot_allocator_traits::deallocate(alloc, block, slots);
+					throw;
+				}
+				unused_in_block = slots;
+			}
+			slot = blocks.back() + (block_slots(blocks.size() - 1) - unused_in_block--);
+		}
+		try
+		{
+			slot_allocator_traits::construct(alloc, slot, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			free_slots.push_back(slot);
+			throw;
+		}
+		return slot;
+	}
+
+	void destroy(slot_t* slot)
+	{
+		slot_allocator_traits::destroy(alloc, slot);
+		free_slots.push_back(slot);
+	}
+
+	void compact()
+	{
+		size_t live = 0;
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			slot_t* slot = order[i];
+			if (slot == nullptr)
+			{
+				continue;
+			}
+			if (live != i)
+			{
+				order[live] = slot;
+				index.find(&slot_traits::key(*slot)).value() = live;
+			}
+			++live;
+		}
+		order.resize(live);
+		tombstones = 0;
+	}
+
+	template <typename T, typename U>
+	static collection_storage<T> store(U&& value, std::true_type /*kept as it is*/)
+	{
+		return std::forward<U>(value);
+	}
+
+	template <typename T, typename U>
+	collection_storage<T> store(U&& value, std::false_type /*kept as it is*/) const
+	{
+		using value_allocator_t = typename std::allocator_traits<A>::template rebind_alloc<T>;
+		return wrapper::allocate_wrapper<T>(value_allocator_t(alloc), std::forward<U>(value));
+	}
+
+	void reset()
+	{
+		blocks.clear();
+		unused_in_block = 0;
+		free_slots.clear();
+		order.clear();
+		index.clear();
+		tombstones = 0;
+	}
+
+public:
+	// region ctor/dtor
+
+	ordered_storage() = default;
+
+	explicit ordered_storage(A const& allocator)
+		: alloc(allocator), blocks(allocator), free_slots(allocator), order(allocator), index(index_allocator_t(allocator))
+	{
+	}
+
+	ordered_storage(ordered_storage const&) = delete;
+
+	ordered_storage& operator=(ordered_storage const&) = delete;
+
+	ordered_storage(ordered_storage&& other)
+		: alloc(std::move(other.alloc))
+		, blocks(std::move(other.blocks))
+		, unused_in_block(other.unused_in_block)
+		, free_slots(std::move(other.free_slots))
+		, order(std::move(other.order))
+		, index(std::move(other.index))
+		, tombstones(other.tombstones)
+	{
+		other.reset();
+	}
+
+	ordered_storage& operator=(ordered_storage&& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			alloc = std::move(other.alloc);
+			blocks = std::move(other.blocks);
+			unused_in_block = other.unused_in_block;
+			free_slots = std::move(other.free_slots);
+			order = std::move(other.order);
+			index = std::move(other.index);
+			tombstones = other.tombstones;
+			other.reset();
+		}
+		return *this;
+	}
+
+	~ordered_storage()
+	{
+		clear();
+	}
+
+	// endregion
+
+	// region iterators
+
+	iterator begin()
+	{
+		if (tombstones > 0)
+		{
+			compact();
+		}
+		return order.begin();
+	}
+
+	iterator end()
+	{
+		if (tombstones > 0)
+		{
+			compact();
+		}
+		return order.end();
+	}
+
+	// endregion
+
+	size_t size() const
+	{
+		return index.size();
+	}
+
+	bool empty() const
+	{
+		return index.empty();
+	}
+
+	bool contains(K const& key) const
+	{
+		return index.count(&key) > 0;
+	}
+
+	slot_t* find(K const& key)
+	{
+		auto it = index.find(&key);
+		return it == index.end() ? nullptr : order[it->second];
+	}
+
+	/**
+	 * \brief Converts [value] to the way the storage keeps a T: values that aren't kept in place are wrapped in the
+	 * memory of the allocator of the storage, unless they come wrapped already.
+	 */
+	template <typename T, typename U>
+	collection_storage<T> store(U&& value) const
+	{
+		using kept_as_it_is = util::bool_constant<util::in_place_v<T> || is_wrapper_v<std::decay_t<U>>>;
+		return store<T>(std::forward<U>(value), kept_as_it_is{});
+	}
+
+	/**
+	 * \brief Appends the entry constructed from [args] unless its key is present already.
+	 * \return the entry with the key and whether it has been appended.
+	 */
+	template <typename... Args>
+	std::pair<slot_t*, bool> emplace(Args&&... args)
+	{
+		slot_t* slot = construct(std::forward<Args>(args)...);
+		auto inserted = index.emplace(&slot_traits::key(*slot), order.size());
+		if (!inserted.second)
+		{
+			destroy(slot);
+			return std::make_pair(order[inserted.first->second], false);
+		}
+		order.push_back(slot);
+		return std::make_pair(slot, true);
+	}
+
+	/**
+	 * \brief Puts the entry constructed from [args], which has the key of [slot], in the position of [slot].
+	 * [handler] is called with the replaced entry and the new one, the replaced entry is destroyed after it.
+	 */
+	template <typename F, typename... Args>
+	void replace(slot_t* slot, F&& handler, Args&&... args)
+	{
+		slot_t* replacement = construct(std::forward<Args>(args)...);
+		auto it = index.find(&slot_traits::key(*slot));
+		const size_t position = it->second;
+		index.unordered_erase(it);
+		index.emplace(&slot_traits::key(*replacement), position);
+		order[position] = replacement;
+		try
+		{
+			handler(*slot, *replacement);
+		}
+		catch (...)
+		{
+			destroy(slot);
+			throw;
+		}
+		destroy(slot);
+	}
+
+	bool erase(K const& key)
+	{
+		auto it = index.find(&key);
+		if (it == index.end())
+		{
+			return false;
+		}
+		const size_t position = it->second;
+		index.unordered_erase(it);
+		destroy(order[position]);
+		order[position] = nullptr;
+		++tombstones;
+		if (tombstones >= MIN_TOMBSTONES_TO_COMPACT && tombstones > index.size())
+		{
+			compact();
+		}
+		return true;
+	}
+
+	void clear()
+	{
+		for (slot_t* slot : order)
+		{
+			if (slot != nullptr)
+			{
+				slot_allocator_traits::destroy(alloc, slot);
+			}
+		}
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			slot_allocator_traits::deallocate(alloc, blocks[i], block_slots(i));
+		}
+		reset();
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_CORE_ORDERED_STORAGE_H
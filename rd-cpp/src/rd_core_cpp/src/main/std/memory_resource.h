@@ -0,0 +1,190 @@
+#ifndef RD_CPP_MEMORY_RESOURCE_H
+#define RD_CPP_MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rd
+{
+/**
+ * \brief Source of memory for allocator-aware models and collections, in the manner of std::pmr::memory_resource.
+ */
+class memory_resource
+{
+public:
+	virtual ~memory_resource() = default;
+
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		return do_allocate(bytes, alignment);
+	}
+
+	void deallocate(void* p, size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		do_deallocate(p, bytes, alignment);
+	}
+
+protected:
+	virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+
+	virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+};
+
+namespace detail
+{
+template <typename T>
+T* allocate_from(memory_resource* resource, size_t n)
+{
+	if (n > static_cast<size_t>(-1) / sizeof(T))
+	{
+		throw std::bad_alloc();
+	}
+	if (resource == nullptr)
+	{
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+	return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void deallocate_to(memory_resource* resource, T* p, size_t n) noexcept
+{
+	if (resource == nullptr)
+	{
+		::operator delete(p);
+		return;
+	}
+	resource->deallocate(p, n * sizeof(T), alignof(T));
+}
+}	 // namespace detail
+
+/**
+ * \brief Allocator drawing from a memory_resource it doesn't own, or from the global heap when it has none.
+ *
+ * \details Copies cost no reference counting, so collections copy it freely, e.g. once for every value they wrap. The
+ * resource has to outlive the memory: attach it to the lifetime of the model and release the collections, and the
+ * values taken out of them, before that lifetime is gone. Memory that may outlive the model takes a
+ * shared_resource_allocator instead.
+ */
+template <typename T>
+class resource_allocator
+{
+	template <typename>
+	friend class resource_allocator;
+
+	memory_resource* resource_ = nullptr;
+
+public:
+	using value_type = T;
+	// containers moved or swapped keep the memory they have allocated
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	// region ctor/dtor
+
+	resource_allocator() noexcept = default;
+
+	explicit resource_allocator(memory_resource* resource) noexcept : resource_(resource)
+	{
+	}
+
+	template <typename U>
+	resource_allocator(resource_allocator<U> const& other) noexcept : resource_(other.resource_)
+	{
+	}
+
+	// endregion
+
+	T* allocate(size_t n)
+	{
+		return detail::allocate_from<T>(resource_, n);
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		detail::deallocate_to(resource_, p, n);
+	}
+
+	memory_resource* resource() const noexcept
+	{
+		return resource_;
+	}
+
+	template <typename U>
+	friend bool operator==(resource_allocator const& lhs, resource_allocator<U> const& rhs) noexcept
+	{
+		return lhs.resource() == rhs.resource();
+	}
+
+	template <typename U>
+	friend bool operator!=(resource_allocator const& lhs, resource_allocator<U> const& rhs) noexcept
+	{
+		return !(lhs == rhs);
+	}
+};
+
+/**
+ * \brief Allocator sharing the ownership of its memory_resource, or drawing from the global heap when it has none.
+ *
+ * \details For memory that may outlive the model, e.g. its lifetimes or the listeners a signal keeps until it's fired
+ * again. Every copy counts a reference, so it's only meant for allocations that copy it once, as std::allocate_shared.
+ */
+template <typename T>
+class shared_resource_allocator
+{
+	template <typename>
+	friend class shared_resource_allocator;
+
+	std::shared_ptr<memory_resource> resource_;
+
+public:
+	using value_type = T;
+
+	// region ctor/dtor
+
+	shared_resource_allocator() noexcept = default;
+
+	explicit shared_resource_allocator(std::shared_ptr<memory_resource> resource) noexcept : resource_(std::move(resource))
+	{
+	}
+
+	template <typename U>
+	shared_resource_allocator(shared_resource_allocator<U> const& other) noexcept : resource_(other.resource_)
+	{
+	}
+
+	// endregion
+
+	T* allocate(size_t n)
+	{
+		return detail::allocate_from<T>(resource_.get(), n);
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		detail::deallocate_to(resource_.get(), p, n);
+	}
+
+	std::shared_ptr<memory_resource> const& resource() const noexcept
+	{
+		return resource_;
+	}
+
+	template <typename U>
+	friend bool operator==(shared_resource_allocator const& lhs, shared_resource_allocator<U> const& rhs) noexcept
+	{
+		return lhs.resource() == rhs.resource();
+	}
+
+	template <typename U>
+	friend bool operator!=(shared_resource_allocator const& lhs, shared_resource_allocator<U> const& rhs) noexcept
+	{
+		return !(lhs == rhs);
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_MEMORY_RESOURCE_H
@@ -283,6 +283,12 @@ typename std::enable_if_t<util::in_heap_v<T>, Wrapper<T>> unwrap(Wrapper<T>&& pt
 	return Wrapper<T>(std::move(ptr));
 }
 
+template <typename T>
+typename std::enable_if_t<!util::in_heap_v<T>, T> unwrap(T&& value)
+{
+	return std::move(value);
+}
+
 template <typename T, typename... Args>
 Wrapper<T> make_wrapper(Args&&... args)
 {
@@ -110,6 +110,23 @@ static_assert(!in_heap_v<int>, "int shouldn't be placed in shared memory");
 
 // endregion
 
+// region in_place
+
+/**
+ * \brief Whether viewable collections keep values of T in their own storage rather than allocating each one separately.
+ */
+template <typename T>
+using in_place = conjunction<negation<in_heap<T>>, std::is_nothrow_move_constructible<T>, std::is_copy_constructible<T>,
+	bool_constant<sizeof(T) <= 64>>;
+
+template <typename T>
+/*inline */ constexpr bool in_place_v = in_place<T>::value;
+
+static_assert(in_place_v<int>, "int should be placed in collection storage");
+static_assert(!in_place_v<std::wstring>, "std::wstring shouldn't be placed in collection storage");
+
+// endregion
+
 // region literal
 
 template <typename T>
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include "memory/MonotonicArena.h"
+#include "memory/PoolArena.h"
+#include "reactive/ViewableList.h"
+#include "reactive/ViewableMap.h"
+#include "reactive/ViewableSet.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rd;
+
+namespace
+{
+// too large to be kept in place by the viewable collections
+struct Large
+{
+	std::array<int64_t, 16> values;
+
+	friend bool operator==(Large const& lhs, Large const& rhs)
+	{
+		return lhs.values == rhs.values;
+	}
+
+	friend bool operator!=(Large const& lhs, Large const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	friend std::string to_string(Large const& value)
+	{
+		return std::to_string(value.values.front());
+	}
+};
+}	 // namespace
+
+namespace rd
+{
+template <>
+struct hash<Large>
+{
+	size_t operator()(Large const& value) const noexcept
+	{
+		return std::hash<int64_t>()(value.values.front());
+	}
+};
+}	 // namespace rd
+
+namespace
+{
+class CountingResource final : public memory_resource
+{
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		++allocations;
+		in_use += bytes;
+		return arena.allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override
+	{
+		in_use -= bytes;
+		arena.deallocate(p, bytes, alignment);
+	}
+
+public:
+	PoolArena arena;
+	size_t allocations = 0;
+	size_t in_use = 0;
+};
+
+Large large(int64_t value)
+{
+	Large result{};
+	result.values.fill(value);
+	return result;
+}
+}	 // namespace
+
+TEST(arena, monotonic_allocates_aligned_blocks)
+{
+	MonotonicArena arena(64);
+	auto first = arena.allocate(3, 1);
+	auto second = arena.allocate(24, 8);
+	auto third = arena.allocate(100, 64);
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(second) % 8);
+	EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(third) % 64);
+	EXPECT_NE(first, second);
+	EXPECT_EQ(127u, arena.allocated_bytes());
+	EXPECT_GE(arena.reserved_bytes(), arena.allocated_bytes());
+
+	// the chunks double until the largest allocation fits
+	auto huge = static_cast<char*>(arena.allocate(10000));
+	huge[9999] = 1;
+	EXPECT_GE(arena.reserved_bytes(), 10000u);
+}
+
+TEST(arena, pool_reuses_freed_blocks)
+{
+	PoolArena arena;
+	auto first = arena.allocate(40);
+	auto second = arena.allocate(40);
+	EXPECT_NE(first, second);
+	EXPECT_EQ(96u, arena.bytes_in_use());
+
+	arena.deallocate(first, 40);
+	EXPECT_EQ(first, arena.allocate(33));
+	const size_t reserved = arena.reserved_bytes();
+
+	// larger blocks go to the global heap
+	auto large = arena.allocate(PoolArena::MAX_POOLED_SIZE + 1);
+	EXPECT_EQ(reserved, arena.reserved_bytes());
+	arena.deallocate(large, PoolArena::MAX_POOLED_SIZE + 1);
+
+	arena.deallocate(first, 33);
+	arena.deallocate(second, 40);
+	EXPECT_EQ(0u, arena.bytes_in_use());
+}
+
+TEST(arena, pool_reuses_blocks_freed_by_other_threads)
+{
+	PoolArena arena;
+	void* freed = nullptr;
+	std::thread([&] {
+		freed = arena.allocate(40);
+		arena.deallocate(freed, 40);
+	}).join();
+	const size_t reserved = arena.reserved_bytes();
+
+	void* reused = nullptr;
+	std::thread([&] { reused = arena.allocate(40); }).join();
+	EXPECT_EQ(freed, reused);
+	EXPECT_EQ(reserved, arena.reserved_bytes());
+	arena.deallocate(reused, 40);
+	EXPECT_EQ(0u, arena.bytes_in_use());
+}
+
+TEST(arena, shared_between_threads)
+{
+	MonotonicArena monotonic;
+	PoolArena pool;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<int64_t*>> blocks(4);
+	for (size_t t = 0; t < blocks.size(); ++t)
+	{
+		threads.emplace_back([&, t] {
+			for (int64_t i = 0; i < 10000; ++i)
+			{
+				auto block = static_cast<int64_t*>(monotonic.allocate(sizeof(int64_t) * 2, alignof(int64_t)));
+				block[0] = block[1] = i;
+				blocks[t].push_back(block);
+
+				auto pooled = static_cast<int64_t*>(pool.allocate(sizeof(int64_t) * (1 + i % 8)));
+				*pooled = i;
+				pool.deallocate(pooled, sizeof(int64_t) * (1 + i % 8));
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	// no block was handed out twice
+	for (auto const& thread_blocks : blocks)
+	{
+		for (size_t i = 0; i < thread_blocks.size(); ++i)
+		{
+			EXPECT_EQ(static_cast<int64_t>(i), thread_blocks[i][0]);
+			EXPECT_EQ(static_cast<int64_t>(i), thread_blocks[i][1]);
+		}
+	}
+	EXPECT_EQ(blocks.size() * 10000 * sizeof(int64_t) * 2, monotonic.allocated_bytes());
+	EXPECT_EQ(0u, pool.bytes_in_use());
+}
+
+TEST(arena, collections_allocate_from_resource)
+{
+	auto resource = std::make_shared<CountingResource>();
+	{
+		ViewableMap<std::string, Large, std::allocator<std::string>, resource_allocator<Large>> map(
+			(resource_allocator<Large>(resource.get())));
+		ViewableSet<Large, resource_allocator<Large>> set((resource_allocator<Large>(resource.get())));
+		ViewableList<Large, resource_allocator<Large>> list((resource_allocator<Large>(resource.get())));
+		for (int64_t i = 0; i < 100; ++i)
+		{
+			map.set(std::to_string(i), large(i));
+			set.add(large(i));
+			list.add(large(i));
+		}
+		map.set("0", large(-1));
+		map.remove("1");
+		set.remove(large(1));
+		list.removeAt(1);
+		EXPECT_EQ(99u, map.size());
+		EXPECT_EQ(-1, map.get("0")->values.front());
+		EXPECT_EQ(99u, set.size());
+		EXPECT_EQ(2, list.get(1).values.front());
+
+		// every wrapped value is in the resource besides the blocks of the entries
+		EXPECT_GE(resource->allocations, 300u);
+	}
+	EXPECT_EQ(0u, resource->in_use);
+	EXPECT_EQ(0u, resource->arena.bytes_in_use());
+}
+
+TEST(arena, nested_lifetimes_allocate_from_resource)
+{
+	auto resource = std::make_shared<CountingResource>();
+	Signal<int> signal;
+	int fired = 0;
+	{
+		LifetimeDefinition definition(Lifetime::Eternal(), resource);
+		Lifetime nested = definition.lifetime.create_nested();
+		EXPECT_EQ(resource, nested->resource());
+		EXPECT_EQ(resource, LifetimeDefinition(nested).lifetime->resource());
+
+		const size_t before = resource->allocations;
+		signal.advise(nested, [&fired](int value) { fired += value; });
+		nested->add_action([] {});
+		EXPECT_GT(resource->allocations, before);
+
+		signal.fire(1);
+	}
+	signal.fire(2);
+	EXPECT_EQ(1, fired);
+	EXPECT_EQ(0u, resource->in_use);
+}
+
+TEST(arena, kept_by_lifetimes_and_listeners)
+{
+	std::weak_ptr<MonotonicArena> weak_arena;
+	Lifetime kept = Lifetime::Eternal();
+	Signal<int> signal;
+	{
+		auto arena = std::make_shared<MonotonicArena>();
+		weak_arena = arena;
+		LifetimeDefinition definition(Lifetime::Eternal(), arena);
+		kept = definition.lifetime;
+		signal.advise(definition.lifetime, [](int) {});
+		// values don't keep the arena, they are released before the lifetime
+		auto value = wrapper::allocate_wrapper<Large>(resource_allocator<Large>(arena.get()), large(7));
+		EXPECT_EQ(7, value->values.back());
+	}
+	// the lifetime is referenced still
+	EXPECT_FALSE(weak_arena.expired());
+	kept = Lifetime::Eternal();
+	// the listener is kept by the signal until it's fired again
+	EXPECT_FALSE(weak_arena.expired());
+	signal.fire(1);
+	EXPECT_TRUE(weak_arena.expired());
+}
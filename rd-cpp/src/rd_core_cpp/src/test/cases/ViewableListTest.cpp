@@ -84,6 +84,46 @@ TEST(viewable_list, add_remove_fuzz)
 	}
 }
 
+TEST(viewable_list, view_many_removals)
+{
+	ViewableList<int> list;
+	std::vector<int> unviewed;
+
+	const int C = 100;
+
+	LifetimeDefinition::use([&](Lifetime lifetime) {
+		list.view(lifetime, [&unviewed](Lifetime lt, size_t /*index*/, int const& value) {
+			lt->add_action([&unviewed, value]() { unviewed.push_back(value); });
+		});
+
+		for (int i = 0; i < C; ++i)
+		{
+			list.add(i);
+		}
+		for (int i = 0; i < C; ++i)
+		{
+			if (i % 3 != 0)
+			{
+				list.remove(i);
+			}
+		}
+		EXPECT_EQ(C - (C + 2) / 3, unviewed.size());
+		unviewed.clear();
+
+		list.add(1, C);
+	});
+
+	std::vector<int> expected{C};
+	for (int i = C - 1; i >= 0; --i)
+	{
+		if (i % 3 == 0)
+		{
+			expected.push_back(i);
+		}
+	}
+	EXPECT_EQ(expected, unviewed);
+}
+
 TEST(viewable_list, insert_middle)
 {
 	std::unique_ptr<IViewableList<int>> list = std::make_unique<ViewableList<int>>();
@@ -120,6 +120,113 @@ TEST(viewable_map, add_remove_fuzz)
 	}
 }
 
+TEST(viewable_map, view_many_removals)
+{
+	ViewableMap<int32_t, int32_t> map;
+	std::vector<int32_t> unviewed;
+
+	const int C = 100;
+
+	LifetimeDefinition::use([&](Lifetime lifetime) {
+		map.view(lifetime, [&unviewed](Lifetime lt, int32_t const& key, int32_t const& /*value*/) {
+			lt->add_action([&unviewed, key]() { unviewed.push_back(key); });
+		});
+
+		for (int32_t i = 0; i < C; ++i)
+		{
+			map.set(i, i);
+		}
+		for (int32_t i = 0; i < C; i += 5)
+		{
+			for (int32_t j = i + 1; j < i + 5; ++j)
+			{
+				map.remove(j);
+			}
+		}
+		EXPECT_EQ(C - C / 5, unviewed.size());
+		unviewed.clear();
+
+		map.set(C, C);
+		map.set(0, -1);
+	});
+
+	std::vector<int32_t> expected{0, 0, C};
+	for (int32_t i = C - 5; i > 0; i -= 5)
+	{
+		expected.push_back(i);
+	}
+	EXPECT_EQ(expected, unviewed);
+}
+
+TEST(viewable_map, order_after_removals)
+{
+	ViewableMap<int32_t, int32_t> map;
+	const int32_t C = 1000;
+	for (int32_t i = 0; i < C; ++i)
+	{
+		map.set(i, i);
+	}
+	// enough removals to compact the map in between, re-added keys go to the end
+	for (int32_t i = 0; i < C; ++i)
+	{
+		if (i % 3 != 0)
+		{
+			map.remove(i);
+		}
+	}
+	map.set(1, -1);
+	map.set(0, -2);
+	EXPECT_EQ(nullptr, map.get(2));
+	EXPECT_EQ(-2, *map.get(0));
+
+	std::vector<int32_t> expected;
+	for (int32_t i = 0; i < C; i += 3)
+	{
+		expected.push_back(i);
+	}
+	expected.push_back(1);
+	std::vector<int32_t> keys;
+	for (auto it = map.begin(); it != map.end(); ++it)
+	{
+		keys.push_back(it.key());
+	}
+	EXPECT_EQ(expected, keys);
+	EXPECT_EQ(expected.size(), map.size());
+
+	std::vector<int32_t> advised;
+	LifetimeDefinition::use([&](Lifetime lifetime) {
+		map.advise(lifetime, [&advised](IViewableMap<int32_t, int32_t>::Event const& e) { advised.push_back(*e.get_key()); });
+	});
+	EXPECT_EQ(expected, advised);
+}
+
+TEST(viewable_map, in_place_entries_outlive_handlers)
+{
+	static_assert(util::in_place_v<std::string>, "strings are kept in place");
+	ViewableMap<std::string, std::string> map;
+	std::vector<std::string> log;
+	LifetimeDefinition::use([&](Lifetime lifetime) {
+		map.view(lifetime, [&log](Lifetime inner, std::pair<std::string const*, std::string const*> entry) {
+			inner->bracket([&log, entry] { log.push_back("+" + *entry.first + "=" + *entry.second); },
+				[&log, entry] { log.push_back("-" + *entry.first + "=" + *entry.second); });
+		});
+		map.set("a", "first value of a");
+		// enough entries for the storage to grow while the first one is in it
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			map.set(std::to_string(i), std::to_string(i));
+		}
+		for (int32_t i = 0; i < 100; ++i)
+		{
+			map.remove(std::to_string(i));
+		}
+		log.clear();
+		map.set("a", "second value of a");
+		map.remove("a");
+	});
+	EXPECT_EQ(arrayListOf("-a=first value of a"s, "+a=second value of a"s, "-a=second value of a"s), log);
+}
+
 TEST(viewable_map, move)
 {
 	ViewableMap<int, int> set1;
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include "base/RdBindableBase.h"
+#include "impl/RdSignal.h"
+#include "ProtocolPair.h"
+
+#include <string>
+#include <vector>
+
+using namespace rd;
+using namespace rd::benchmarks;
+
+namespace
+{
+// A flat model: the root binds its children under "[index]" names, as collections do with their elements.
+class Root final : public RdBindableBase
+{
+public:
+	std::vector<RdSignal<int32_t>> children;
+
+	explicit Root(size_t size) : children(size)
+	{
+	}
+
+	void identify(Identities const& identities, RdId const& id) const override
+	{
+		RdBindableBase::identify(identities, id);
+		const auto ids = identities.next_range(id, static_cast<int32_t>(children.size()));
+		for (int32_t i = 0; i < ids.size(); ++i)
+		{
+			children[i].identify(identities, ids[i]);
+		}
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		RdBindableBase::init(lifetime);
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			children[i].bind(lifetime, this, "[" + std::to_string(i) + "]");
+		}
+	}
+};
+}	 // namespace
+
+// Identifying, binding and unbinding a whole model.
+
+static void bind_model(benchmark::State& state)
+{
+	const auto n = static_cast<size_t>(state.range(0));
+	ProtocolPair protocols;
+	auto protocol = protocols.client_protocol.get();
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Root root(n);
+		state.ResumeTiming();
+
+		LifetimeDefinition definition(protocols.lifetime_def.lifetime);
+		root.identify(*protocol->get_identity(), RdId(1));
+		root.bind(definition.lifetime, protocol, "root");
+		definition.terminate();
+
+		state.PauseTiming();
+		root.children.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(bind_model)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Rendering the locations of bound entities, as logging does.
+
+static void location_to_string(benchmark::State& state)
+{
+	const size_t n = 1000;
+	// outlives the protocols it's bound to
+	Root root(n);
+	ProtocolPair protocols;
+	root.identify(*protocols.client_protocol->get_identity(), RdId(1));
+	root.bind(protocols.lifetime_def.lifetime, protocols.client_protocol.get(), "root");
+
+	size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(to_string(root.children[i++ % n].get_location()));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(location_to_string);
+
+// Ids of members mixed from their names, as generated identify does.
+
+static void rd_id_mix_name(benchmark::State& state)
+{
+	RdId id(1);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(id = id.mix(".andBackAgain"));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(rd_id_mix_name);
+
+static void rd_id_mix_tail(benchmark::State& state)
+{
+	constexpr RdId::Tail tail(".andBackAgain");
+	RdId id(1);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(id = id.mix(tail));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(rd_id_mix_tail);
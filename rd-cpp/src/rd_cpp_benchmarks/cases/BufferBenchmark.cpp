@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+
+#include "protocol/Buffer.h"
+#include "wire/SendBufferPool.h"
+
+#include <string>
+#include <vector>
+
+using namespace rd;
+
+static void buffer_write_read_primitives(benchmark::State& state)
+{
+	Buffer buffer;
+	int64_t sum = 0;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		for (int32_t i = 0; i < 64; ++i)
+		{
+			buffer.write_integral<int32_t>(i);
+			buffer.write_integral<int64_t>(i);
+			buffer.write_floating_point<double>(i);
+			buffer.write_bool((i & 1) != 0);
+		}
+		buffer.rewind();
+		for (int32_t i = 0; i < 64; ++i)
+		{
+			sum += buffer.read_integral<int32_t>();
+			sum += buffer.read_integral<int64_t>();
+			sum += static_cast<int64_t>(buffer.read_floating_point<double>());
+			sum += buffer.read_bool();
+		}
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * 64 * 4);
+	state.SetBytesProcessed(state.iterations() * 64 * (4 + 8 + 8 + 1));
+}
+
+BENCHMARK(buffer_write_read_primitives);
+
+static void buffer_write_read_wstring(benchmark::State& state)
+{
+	const std::wstring value(static_cast<size_t>(state.range(0)), L'x');
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_wstring(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_wstring());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+
+BENCHMARK(buffer_write_read_wstring)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void buffer_write_read_string(benchmark::State& state)
+{
+	const std::string value(static_cast<size_t>(state.range(0)), 'x');
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_string(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_string());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(buffer_write_read_string)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void buffer_write_read_pod_array(benchmark::State& state)
+{
+	const std::vector<int32_t> value(static_cast<size_t>(state.range(0)), 42);
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_array(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_array<std::vector, int32_t>());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int32_t));
+}
+
+BENCHMARK(buffer_write_read_pod_array)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// shape of the code generated for a list of strings
+
+static void buffer_write_read_string_array(benchmark::State& state)
+{
+	using allocator_t = allocator<Wrapper<std::wstring>>;
+	const std::vector<Wrapper<std::wstring>, allocator_t> value(
+		static_cast<size_t>(state.range(0)), Wrapper<std::wstring>(std::wstring(L"element")));
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_array<std::vector, std::wstring, allocator_t>(
+			value, [&buffer](std::wstring const& it) { buffer.write_wstring(it); });
+		buffer.rewind();
+		benchmark::DoNotOptimize(
+			buffer.read_array<std::vector, std::wstring, allocator_t>([&buffer] { return buffer.read_wstring(); }));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(buffer_write_read_string_array)->RangeMultiplier(16)->Range(16, 1 << 12);
+
+// bulk copy of numeric arrays against writing them number by number
+
+static void buffer_write_read_span(benchmark::State& state)
+{
+	const std::vector<double> value(static_cast<size_t>(state.range(0)), 0.5);
+	std::vector<double> destination(value.size());
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_span(value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_into(destination));
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+
+BENCHMARK(buffer_write_read_span)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+static void buffer_write_read_elementwise(benchmark::State& state)
+{
+	const std::vector<double> value(static_cast<size_t>(state.range(0)), 0.5);
+	std::vector<double> destination(value.size());
+	Buffer buffer;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		buffer.write_integral<int32_t>(static_cast<int32_t>(value.size()));
+		for (double const& it : value)
+		{
+			buffer.write_floating_point(it);
+		}
+		buffer.rewind();
+		destination.resize(static_cast<size_t>(buffer.read_integral<int32_t>()));
+		for (double& it : destination)
+		{
+			it = buffer.read_floating_point<double>();
+		}
+		benchmark::DoNotOptimize(destination.data());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+
+BENCHMARK(buffer_write_read_elementwise)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+// shape of SocketWire sends: a fresh buffer per message against a pooled one, copied out at the exact size when small
+
+static void buffer_send_message_fresh(benchmark::State& state)
+{
+	const std::vector<int32_t> payload(static_cast<size_t>(state.range(0)) / sizeof(int32_t), 42);
+	for (auto _ : state)
+	{
+		Buffer buffer;
+		buffer.write_integral<int32_t>(0);
+		buffer.write_array(payload);
+		benchmark::DoNotOptimize(std::move(buffer).getRealArray());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(buffer_send_message_fresh)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void buffer_send_message_pooled(benchmark::State& state)
+{
+	const std::vector<int32_t> payload(static_cast<size_t>(state.range(0)) / sizeof(int32_t), 42);
+	for (auto _ : state)
+	{
+		SendBufferPool::Lease lease;
+		lease->write_integral<int32_t>(0);
+		lease->write_array(payload);
+		benchmark::DoNotOptimize(lease.take_written());
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(buffer_send_message_pooled)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include "DemoModel/Derived.Generated.h"
+#include "DemoModel/MyScalar.Generated.h"
+#include "protocol/Buffer.h"
+#include "serialization/SerializationCtx.h"
+
+#include <limits>
+
+using namespace rd;
+
+// Serialization throughput of generated structs, see Cpp17Generator.InlineSerializers for the generation mode.
+
+static void demo_scalar_write_read(benchmark::State& state)
+{
+	SerializationCtx ctx{nullptr};
+	Buffer buffer;
+	const auto scalar = demo::MyScalar(true, 98, 32000, 1'000'000'000, -2'000'000'000'000'000'000, 3.14f, -123456789.012345678,
+		std::numeric_limits<uint8_t>::max() - 1, std::numeric_limits<uint16_t>::max() - 1,
+		std::numeric_limits<uint32_t>::max() - 1, std::numeric_limits<uint64_t>::max() - 1, demo::MyEnum::cpp,
+		demo::Flags::anyFlag | demo::Flags::cppFlag, demo::MyInitializedEnum::hundred);
+
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		scalar.write(ctx, buffer);
+		buffer.rewind();
+		benchmark::DoNotOptimize(demo::MyScalar::read(ctx, buffer));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(demo_scalar_write_read);
+
+static void demo_derived_write_read(benchmark::State& state)
+{
+	SerializationCtx ctx{nullptr};
+	Buffer buffer;
+	const auto derived = demo::Derived(L"Cpp instance");
+
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		derived.write(ctx, buffer);
+		buffer.rewind();
+		benchmark::DoNotOptimize(demo::Derived::read(ctx, buffer));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(demo_derived_write_read);
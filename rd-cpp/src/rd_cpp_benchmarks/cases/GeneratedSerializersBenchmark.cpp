@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+
+#include "protocol/Buffer.h"
+#include "serialization/ISerializable.h"
+#include "serialization/Polymorphic.h"
+#include "serialization/SerializationCtx.h"
+
+#include <vector>
+
+using namespace rd;
+
+// MyScalar of DemoModel and an array of it (ClassWithStructArrayField) with the readers and writers Cpp17Generator
+// emits without and with InlineSerializers, written out by hand so that they build without the generated demo
+// sources. DemoModelBenchmark measures the generated code itself.
+
+namespace
+{
+enum class MyEnum
+{
+	kt,
+	net,
+	cpp
+};
+
+enum class Flags
+{
+	noFlags = 0,
+	anyFlag = 1 << 0,
+	ktFlag = 1 << 1,
+	netFlag = 1 << 2,
+	cppFlag = 1 << 3
+};
+
+template <bool Inline>
+class MyScalar final : public ISerializable
+{
+public:
+	bool bool_ = true;
+	int8_t byte_ = 98;
+	int16_t short_ = 32000;
+	int32_t int_ = 1'000'000'000;
+	int64_t long_ = -2'000'000'000'000'000'000;
+	float float_ = 3.14f;
+	double double_ = -123456789.012345678;
+	uint8_t unsigned_byte_ = 254;
+	uint16_t unsigned_short_ = 65534;
+	uint32_t unsigned_int_ = 4'000'000'000u;
+	uint64_t unsigned_long_ = 18'000'000'000'000'000'000ull;
+	MyEnum enum_ = MyEnum::cpp;
+	Flags flags_ = Flags::cppFlag;
+	MyEnum my_initialized_enum_ = MyEnum::net;
+
+	static MyScalar read(SerializationCtx& ctx, Buffer& buffer)
+	{
+		MyScalar res;
+		res.bool_ = buffer.read_bool();
+		res.byte_ = buffer.read_integral<int8_t>();
+		res.short_ = buffer.read_integral<int16_t>();
+		res.int_ = buffer.read_integral<int32_t>();
+		res.long_ = buffer.read_integral<int64_t>();
+		res.float_ = buffer.read_floating_point<float>();
+		res.double_ = buffer.read_floating_point<double>();
+		res.unsigned_byte_ = buffer.read_integral<uint8_t>();
+		res.unsigned_short_ = buffer.read_integral<uint16_t>();
+		res.unsigned_int_ = buffer.read_integral<uint32_t>();
+		res.unsigned_long_ = buffer.read_integral<uint64_t>();
+		if (Inline)
+		{
+			res.enum_ = buffer.read_enum<MyEnum>();
+			res.flags_ = buffer.read_enum_set<Flags>();
+			res.my_initialized_enum_ = buffer.read_enum<MyEnum>();
+		}
+		else
+		{
+			res.enum_ = Polymorphic<MyEnum>::read(ctx, buffer);
+			res.flags_ = Polymorphic<Flags>::read(ctx, buffer);
+			res.my_initialized_enum_ = Polymorphic<MyEnum>::read(ctx, buffer);
+		}
+		return res;
+	}
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		if (Inline)
+		{
+			buffer.require_available(55);
+		}
+		buffer.write_bool(bool_);
+		buffer.write_integral(byte_);
+		buffer.write_integral(short_);
+		buffer.write_integral(int_);
+		buffer.write_integral(long_);
+		buffer.write_floating_point(float_);
+		buffer.write_floating_point(double_);
+		buffer.write_integral(unsigned_byte_);
+		buffer.write_integral(unsigned_short_);
+		buffer.write_integral(unsigned_int_);
+		buffer.write_integral(unsigned_long_);
+		if (Inline)
+		{
+			buffer.write_enum(enum_);
+			buffer.write_enum_set(flags_);
+			buffer.write_enum(my_initialized_enum_);
+		}
+		else
+		{
+			Polymorphic<MyEnum>::write(ctx, buffer, enum_);
+			Polymorphic<Flags>::write(ctx, buffer, flags_);
+			Polymorphic<MyEnum>::write(ctx, buffer, my_initialized_enum_);
+		}
+	}
+};
+
+template <bool Inline>
+void write_array_field(SerializationCtx& ctx, Buffer& buffer, std::vector<MyScalar<Inline>> const& field)
+{
+	using S = MyScalar<Inline>;
+	if (Inline)
+	{
+		buffer.require_available(4 + 55 * field.size()),
+			buffer.write_array<std::vector, S, allocator<S>>(field, [&](S const& it) { rd::wrapper::get(it).write(ctx, buffer); });
+	}
+	else
+	{
+		buffer.write_array<std::vector, S, allocator<S>>(
+			field, [&](S const& it) { rd::Polymorphic<std::decay_t<decltype(it)>>::write(ctx, buffer, it); });
+	}
+}
+
+template <bool Inline>
+void scalar_array_write_read(benchmark::State& state)
+{
+	using S = MyScalar<Inline>;
+	SerializationCtx ctx{nullptr};
+	const std::vector<S> field(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		// a fresh buffer per message, as SocketWire has for the messages bigger than its pooled buffers
+		Buffer buffer;
+		write_array_field<Inline>(ctx, buffer, field);
+		buffer.rewind();
+		benchmark::DoNotOptimize(buffer.read_array<std::vector, S, allocator<S>>([&] { return S::read(ctx, buffer); }));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}	 // namespace
+
+static void demo_scalar_array_polymorphic(benchmark::State& state)
+{
+	scalar_array_write_read<false>(state);
+}
+
+BENCHMARK(demo_scalar_array_polymorphic)->RangeMultiplier(16)->Range(1, 1 << 12);
+
+static void demo_scalar_array_inline(benchmark::State& state)
+{
+	scalar_array_write_read<true>(state);
+}
+
+BENCHMARK(demo_scalar_array_inline)->RangeMultiplier(16)->Range(1, 1 << 12);
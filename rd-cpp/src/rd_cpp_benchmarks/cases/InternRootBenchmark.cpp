@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "ProtocolPair.h"
+#include "serialization/InternedSerializer.h"
+#include "serialization/Polymorphic.h"
+
+#include <string>
+
+using namespace rd;
+using namespace rd::benchmarks;
+
+using ProtocolInterned = InternedSerializer<Polymorphic<std::wstring>, util::getPlatformIndependentHash("Protocol")>;
+
+// Values which are already interned: a lookup on the writing side and an index read on the other one.
+
+static void intern_root_known_value(benchmark::State& state)
+{
+	ProtocolPair protocols;
+	auto& client_ctx = protocols.client_protocol->get_serialization_context();
+	auto& server_ctx = protocols.server_protocol->get_serialization_context();
+
+	const Wrapper<std::wstring> value(std::wstring(L"interned value"));
+	Buffer buffer;
+	ProtocolInterned::write(client_ctx, buffer, value);
+
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		ProtocolInterned::write(client_ctx, buffer, value);
+		buffer.rewind();
+		benchmark::DoNotOptimize(ProtocolInterned::read(server_ctx, buffer));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(intern_root_known_value);
+
+// Every value is new: it's sent to the counterpart before its index can be written.
+
+static void intern_root_new_value(benchmark::State& state)
+{
+	ProtocolPair protocols;
+	auto& client_ctx = protocols.client_protocol->get_serialization_context();
+
+	Buffer buffer;
+	int64_t i = 0;
+	for (auto _ : state)
+	{
+		buffer.rewind();
+		ProtocolInterned::write(client_ctx, buffer, Wrapper<std::wstring>(std::to_wstring(i++)));
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(intern_root_new_value);
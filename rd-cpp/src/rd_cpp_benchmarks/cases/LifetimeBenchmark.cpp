@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include "lifetime/LifetimeDefinition.h"
+
+#include <vector>
+
+using namespace rd;
+
+static void lifetime_create_terminate(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		definition.terminate();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(lifetime_create_terminate);
+
+// nested lifetimes terminated together with their parent
+
+static void lifetime_nested_create_terminate(benchmark::State& state)
+{
+	const auto n = state.range(0);
+	for (auto _ : state)
+	{
+		LifetimeDefinition parent(Lifetime::Eternal());
+		std::vector<LifetimeDefinition> nested;
+		nested.reserve(n);
+		for (int64_t i = 0; i < n; ++i)
+		{
+			nested.emplace_back(parent.lifetime);
+		}
+		parent.terminate();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(lifetime_nested_create_terminate)->RangeMultiplier(10)->Range(10, 10000);
+
+static void lifetime_add_action(benchmark::State& state)
+{
+	const auto n = state.range(0);
+	int64_t counter = 0;
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		for (int64_t i = 0; i < n; ++i)
+		{
+			definition.lifetime->add_action([&counter] { ++counter; });
+		}
+		definition.terminate();
+	}
+	benchmark::DoNotOptimize(counter);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(lifetime_add_action)->RangeMultiplier(10)->Range(10, 10000);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+
+#include "impl/RdSignal.h"
+#include "ProtocolPair.h"
+
+#include <memory>
+#include <vector>
+
+using namespace rd;
+using namespace rd::benchmarks;
+
+// Fire on the client side, serialization and dispatch through the server's MessageBroker to the bound counterpart.
+
+static void message_broker_dispatch(benchmark::State& state)
+{
+	const auto n = state.range(0);
+	// entities outlive the protocols they are bound to
+	std::vector<std::unique_ptr<RdSignal<int32_t>>> client_signals;
+	std::vector<std::unique_ptr<RdSignal<int32_t>>> server_signals;
+	ProtocolPair protocols;
+	int64_t sum = 0;
+	for (int64_t i = 0; i < n; ++i)
+	{
+		client_signals.push_back(std::make_unique<RdSignal<int32_t>>());
+		server_signals.push_back(std::make_unique<RdSignal<int32_t>>());
+		protocols.bind_static(*client_signals.back(), *server_signals.back(), i + 1);
+		server_signals.back()->advise(protocols.lifetime_def.lifetime, [&sum](int32_t const& value) { sum += value; });
+	}
+
+	int32_t value = 0;
+	for (auto _ : state)
+	{
+		client_signals[value % n]->fire(value);
+		++value;
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations());
+	state.SetBytesProcessed(protocols.client_wire->bytes_written);
+}
+
+BENCHMARK(message_broker_dispatch)->Arg(1)->Arg(100)->Arg(10000);
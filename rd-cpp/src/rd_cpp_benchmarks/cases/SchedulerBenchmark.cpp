@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include "lifetime/LifetimeDefinition.h"
+#include "scheduler/SingleThreadScheduler.h"
+#include "scheduler/StealingScheduler.h"
+
+#include "ctpl_stl.h"
+
+#include <atomic>
+#include <string>
+
+using namespace rd;
+
+// A synchronous round trip: an action is queued and waited for, as a caller waiting for its request does.
+// A batch: actions are queued as fast as a wire receives them and waited for at the end, this is the dispatch cost.
+
+namespace
+{
+// the former implementation of SingleThreadScheduler, kept as the baseline
+class CtplScheduler
+{
+	std::atomic_uint32_t tasks_executing{0};
+	ctpl::thread_pool pool{1};
+
+public:
+	CtplScheduler(Lifetime, std::string const&)
+	{
+	}
+
+	void queue(std::function<void()> action)
+	{
+		++tasks_executing;
+		pool.push([this, action](int) {
+			action();
+			--tasks_executing;
+		});
+	}
+
+	void flush()
+	{
+		while (tasks_executing != 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+};
+
+class SpinningScheduler : public SingleThreadScheduler
+{
+public:
+	SpinningScheduler(Lifetime lifetime, std::string name) : SingleThreadScheduler(lifetime, std::move(name), 1000)
+	{
+	}
+};
+
+template <typename S>
+S& scheduler(std::string const& name)
+{
+	// created once and never destroyed, schedulers register loggers by their names
+	static auto definition = new LifetimeDefinition(false);
+	static auto instance = new S(definition->lifetime, name);
+	return *instance;
+}
+}	 // namespace
+
+template <typename S>
+void queue_and_flush(benchmark::State& state, S& s)
+{
+	int64_t executed = 0;
+	for (auto _ : state)
+	{
+		s.queue([&executed] { ++executed; });
+		s.flush();
+	}
+	benchmark::DoNotOptimize(executed);
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void queue_and_flush_single_thread(benchmark::State& state)
+{
+	queue_and_flush(state, scheduler<SingleThreadScheduler>("benchmark-single-thread"));
+}
+
+BENCHMARK(queue_and_flush_single_thread)->UseRealTime();
+
+static void queue_and_flush_single_thread_spinning(benchmark::State& state)
+{
+	queue_and_flush(state, scheduler<SpinningScheduler>("benchmark-single-thread-spinning"));
+}
+
+BENCHMARK(queue_and_flush_single_thread_spinning)->UseRealTime();
+
+static void queue_and_flush_ctpl(benchmark::State& state)
+{
+	queue_and_flush(state, scheduler<CtplScheduler>("benchmark-ctpl"));
+}
+
+BENCHMARK(queue_and_flush_ctpl)->UseRealTime();
+
+static void queue_and_flush_stealing(benchmark::State& state)
+{
+	queue_and_flush(state, scheduler<StealingScheduler>("benchmark-stealing"));
+}
+
+BENCHMARK(queue_and_flush_stealing)->UseRealTime();
+
+template <typename S>
+void queue_batch(benchmark::State& state, S& s)
+{
+	const auto count = state.range(0);
+	std::atomic_int64_t executed{0};
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < count; ++i)
+		{
+			s.queue([&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+		}
+		// with several producers each one waits for the others' actions too
+		s.flush();
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void queue_batch_single_thread(benchmark::State& state)
+{
+	queue_batch(state, scheduler<SingleThreadScheduler>("benchmark-single-thread"));
+}
+
+BENCHMARK(queue_batch_single_thread)->Arg(1000)->ThreadRange(1, 4)->UseRealTime();
+
+static void queue_batch_ctpl(benchmark::State& state)
+{
+	queue_batch(state, scheduler<CtplScheduler>("benchmark-ctpl"));
+}
+
+BENCHMARK(queue_batch_ctpl)->Arg(1000)->ThreadRange(1, 4)->UseRealTime();
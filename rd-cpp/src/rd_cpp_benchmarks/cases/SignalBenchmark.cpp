@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include "lifetime/LifetimeDefinition.h"
+#include "reactive/base/SignalX.h"
+
+using namespace rd;
+
+static void signal_fire(benchmark::State& state)
+{
+	const auto n = state.range(0);
+	Signal<int32_t> signal;
+	int64_t sum = 0;
+	for (int64_t i = 0; i < n; ++i)
+	{
+		signal.advise(Lifetime::Eternal(), [&sum](int32_t const& value) { sum += value; });
+	}
+
+	int32_t value = 0;
+	for (auto _ : state)
+	{
+		signal.fire(++value);
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(signal_fire)->Arg(0)->Arg(1)->Arg(10)->Arg(100);
+
+static void signal_advise_terminate(benchmark::State& state)
+{
+	Signal<int32_t> signal;
+	int64_t sum = 0;
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		signal.advise(definition.lifetime, [&sum](int32_t const& value) { sum += value; });
+		definition.terminate();
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(signal_advise_terminate);
@@ -0,0 +1,244 @@
+#include <benchmark/benchmark.h>
+
+#include "impl/RdSignal.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Identities.h"
+#include "protocol/Protocol.h"
+#include "scheduler/SimpleScheduler.h"
+#include "SimulatedWire.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace rd;
+using namespace rd::benchmarks;
+using namespace std::chrono_literals;
+
+// Protocols over a simulated link. Besides the real time of the serialization, framing and ACK processing,
+// every case reports the virtual throughput and message latency percentiles of the modelled network.
+
+namespace
+{
+struct Scenario
+{
+	const char* name;
+	LinkSettings settings;
+};
+
+LinkSettings link(std::chrono::microseconds latency, std::chrono::microseconds jitter, int64_t bandwidth)
+{
+	LinkSettings settings;
+	settings.latency = latency;
+	settings.jitter = jitter;
+	settings.bandwidth = bandwidth;
+	settings.seed = 42;
+	return settings;
+}
+
+Scenario make_wan()
+{
+	Scenario scenario{"wan", link(20ms, 2ms, 10 << 20)};
+	scenario.settings.reorder_probability = 0.01;
+	scenario.settings.reorder_delay = 5ms;
+	return scenario;
+}
+
+Scenario make_flaky()
+{
+	Scenario scenario{"flaky", link(1ms, 200us, 100 << 20)};
+	scenario.settings.disconnect_probability = 0.001;
+	scenario.settings.reconnect_delay = 50ms;
+	return scenario;
+}
+
+const Scenario scenarios[] = {{"loopback", link(0us, 0us, 0)}, {"lan", link(100us, 10us, 1 << 30)}, make_wan(), make_flaky()};
+
+class SimulatedProtocolPair
+{
+public:
+	LifetimeDefinition lifetime_def{Lifetime::Eternal()};
+	Lifetime lifetime = lifetime_def.lifetime;
+
+	SimpleScheduler client_scheduler;
+	SimpleScheduler server_scheduler;
+
+	SimulatedNetwork network;
+	std::shared_ptr<SimulatedWire> client_wire;
+	std::shared_ptr<SimulatedWire> server_wire;
+
+	std::unique_ptr<Protocol> client_protocol;
+	std::unique_ptr<Protocol> server_protocol;
+
+	explicit SimulatedProtocolPair(LinkSettings const& settings) : network(settings)
+	{
+		client_wire = std::make_shared<SimulatedWire>(network, &client_scheduler, "SimulatedClient");
+		server_wire = std::make_shared<SimulatedWire>(network, &server_scheduler, "SimulatedServer");
+		network.connect(*client_wire, *server_wire);
+		client_protocol = std::make_unique<Protocol>(Identities::CLIENT, &client_scheduler, client_wire, lifetime);
+		server_protocol = std::make_unique<Protocol>(Identities::SERVER, &server_scheduler, server_wire, lifetime);
+	}
+
+	~SimulatedProtocolPair()
+	{
+		lifetime_def.terminate();
+	}
+
+	template <typename T>
+	void bind_static(T& client, T& server, int64_t id) const
+	{
+		statics(client, id).bind(lifetime, client_protocol.get(), "top");
+		statics(server, id).bind(lifetime, server_protocol.get(), "top");
+	}
+};
+
+void report(benchmark::State& state, SimulatedNetwork::Stats const& stats, SimulatedNetwork::time_t elapsed)
+{
+	using benchmark::Counter;
+	const double seconds = std::chrono::duration<double>(elapsed).count();
+	state.counters["virtual_bytes_per_second"] = Counter(seconds > 0 ? static_cast<double>(stats.bytes) / seconds : 0);
+	const auto us = [&stats](double fraction) {
+		return Counter(std::chrono::duration<double, std::micro>(stats.latency_percentile(fraction)).count());
+	};
+	state.counters["p50_us"] = us(0.5);
+	state.counters["p99_us"] = us(0.99);
+	state.counters["p999_us"] = us(0.999);
+	state.counters["retransmitted"] = Counter(static_cast<double>(stats.retransmitted_packages));
+	state.counters["disconnects"] = Counter(static_cast<double>(stats.disconnects));
+}
+}	 // namespace
+
+static void simulated_wire_throughput(benchmark::State& state)
+{
+	constexpr int64_t BATCH = 1000;
+	Scenario const& scenario = scenarios[state.range(0)];
+	state.SetLabel(scenario.name);
+
+	RdSignal<std::wstring> client_signal, server_signal;
+	int64_t received = 0;
+	SimulatedProtocolPair protocols(scenario.settings);
+	protocols.bind_static(client_signal, server_signal, 1);
+	server_signal.advise(protocols.lifetime, [&received](std::wstring const&) { ++received; });
+	protocols.network.run_until_idle();
+	protocols.network.take_stats();
+
+	const std::wstring payload(static_cast<size_t>(state.range(1)), L'x');
+	const auto start = protocols.network.get_now();
+	int64_t sent = 0;
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < BATCH; ++i)
+		{
+			client_signal.fire(payload);
+		}
+		protocols.network.run_until_idle();
+		sent += BATCH;
+		if (received != sent)
+		{
+			state.SkipWithError("messages were lost");
+			break;
+		}
+	}
+	report(state, protocols.network.take_stats(), protocols.network.get_now() - start);
+	state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+BENCHMARK(simulated_wire_throughput)
+	->ArgsProduct({{0, 1, 2, 3}, {16, 1024, 64 * 1024}})
+	->Unit(benchmark::kMillisecond);
+
+static void simulated_wire_request_response(benchmark::State& state)
+{
+	Scenario const& scenario = scenarios[state.range(0)];
+	state.SetLabel(scenario.name);
+
+	RdSignal<int32_t> client_request, server_request;
+	RdSignal<int32_t> client_response, server_response;
+	int64_t responses = 0;
+	SimulatedProtocolPair protocols(scenario.settings);
+	protocols.bind_static(client_request, server_request, 1);
+	protocols.bind_static(client_response, server_response, 2);
+	server_request.advise(protocols.lifetime, [&server_response](int32_t const& value) { server_response.fire(value); });
+	client_response.advise(protocols.lifetime, [&responses](int32_t const&) { ++responses; });
+	protocols.network.run_until_idle();
+	protocols.network.take_stats();
+
+	const auto start = protocols.network.get_now();
+	int32_t sent = 0;
+	for (auto _ : state)
+	{
+		client_request.fire(++sent);
+		protocols.network.run_until_idle();
+		if (responses != sent)
+		{
+			state.SkipWithError("response was lost");
+			break;
+		}
+	}
+	report(state, protocols.network.take_stats(), protocols.network.get_now() - start);
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(simulated_wire_request_response)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+// Interactive messages queued behind large ones, e.g. while the socket doesn't accept more data. With the large ones
+// in the bulk lane the interactive ones overtake every bulk message which hasn't started yet.
+static void simulated_wire_mixed_load(benchmark::State& state)
+{
+	constexpr int32_t BULK_MESSAGES = 8;
+	constexpr int32_t INTERACTIVE_MESSAGES = 256;
+	const bool bulk_lane = state.range(0) != 0;
+	state.SetLabel(bulk_lane ? "bulk_lane" : "single_lane");
+
+	RdSignal<std::wstring> client_bulk, server_bulk;
+	RdSignal<int32_t> client_interactive, server_interactive;
+	if (bulk_lane)
+	{
+		client_bulk.send_priority = SendPriority::Bulk;
+		server_bulk.send_priority = SendPriority::Bulk;
+	}
+	int64_t received = 0;
+	SimulatedProtocolPair protocols(link(100us, 10us, 100 << 20));
+	protocols.bind_static(client_bulk, server_bulk, 1);
+	protocols.bind_static(client_interactive, server_interactive, 2);
+	server_bulk.advise(protocols.lifetime, [&received](std::wstring const&) { ++received; });
+	server_interactive.advise(protocols.lifetime, [&received](int32_t const&) { ++received; });
+	protocols.network.run_until_idle();
+	protocols.network.take_stats();
+
+	const std::wstring payload(512 * 1024, L'x');
+	const auto start = protocols.network.get_now();
+	int64_t sent = 0;
+	for (auto _ : state)
+	{
+		protocols.client_wire->hold();
+		for (int32_t i = 0; i < INTERACTIVE_MESSAGES; ++i)
+		{
+			if (i % (INTERACTIVE_MESSAGES / BULK_MESSAGES) == 0)
+			{
+				client_bulk.fire(payload);
+			}
+			client_interactive.fire(i);
+		}
+		protocols.client_wire->release();
+		protocols.network.run_until_idle();
+		sent += BULK_MESSAGES + INTERACTIVE_MESSAGES;
+		if (received != sent)
+		{
+			state.SkipWithError("messages were lost");
+			break;
+		}
+	}
+	const auto stats = protocols.network.take_stats();
+	report(state, stats, protocols.network.get_now() - start);
+	const auto us = [&stats](double fraction) {
+		return benchmark::Counter(
+			std::chrono::duration<double, std::micro>(stats.latency_percentile(fraction, SendPriority::Interactive)).count());
+	};
+	state.counters["interactive_p50_us"] = us(0.5);
+	state.counters["interactive_p99_us"] = us(0.99);
+	state.counters["interactive_p999_us"] = us(0.999);
+	state.SetItemsProcessed(state.iterations() * (BULK_MESSAGES + INTERACTIVE_MESSAGES));
+}
+
+BENCHMARK(simulated_wire_mixed_load)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
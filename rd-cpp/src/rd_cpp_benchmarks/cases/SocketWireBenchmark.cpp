@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include "impl/RdSignal.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Identities.h"
+#include "protocol/Protocol.h"
+#include "scheduler/SimpleScheduler.h"
+#include "wire/SocketWire.h"
+
+#include "spdlog/spdlog.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace rd;
+
+// End-to-end over a loopback socket: client and server protocols with real SocketWires, handlers run on the receiver threads.
+
+namespace
+{
+class SocketWirePair
+{
+public:
+	LifetimeDefinition lifetime_def{Lifetime::Eternal()};
+	Lifetime lifetime = lifetime_def.lifetime;
+
+	SimpleScheduler server_scheduler;
+	SimpleScheduler client_scheduler;
+
+	std::shared_ptr<SocketWire::Server> server_wire;
+	std::shared_ptr<SocketWire::Client> client_wire;
+
+	std::unique_ptr<Protocol> server_protocol;
+	std::unique_ptr<Protocol> client_protocol;
+
+	SocketWirePair()
+	{
+		// wires log every connect and disconnect at info level
+		spdlog::set_level(spdlog::level::warn);
+
+		server_wire = std::make_shared<SocketWire::Server>(lifetime, &server_scheduler, 0, "BenchmarkServer");
+		server_protocol = std::make_unique<Protocol>(Identities::SERVER, &server_scheduler, server_wire, lifetime);
+		client_wire = std::make_shared<SocketWire::Client>(lifetime, &client_scheduler, server_wire->port, "BenchmarkClient");
+		client_protocol = std::make_unique<Protocol>(Identities::CLIENT, &client_scheduler, client_wire, lifetime);
+	}
+
+	~SocketWirePair()
+	{
+		lifetime_def.terminate();
+	}
+
+	bool wait_connected() const
+	{
+		for (int i = 0; i < 500; ++i)
+		{
+			if (server_wire->connected.get() && client_wire->connected.get())
+			{
+				return true;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return false;
+	}
+
+	template <typename T>
+	void bind_static(T& client, T& server, int64_t id) const
+	{
+		statics(client, id).bind(lifetime, client_protocol.get(), "top");
+		statics(server, id).bind(lifetime, server_protocol.get(), "top");
+	}
+};
+
+class Counter
+{
+	std::mutex lock;
+	std::condition_variable cv;
+	int64_t value = 0;
+
+public:
+	void increment()
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		++value;
+		cv.notify_all();
+	}
+
+	bool wait_for(int64_t expected)
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		return cv.wait_for(guard, std::chrono::seconds(10), [this, expected] { return value >= expected; });
+	}
+};
+}	 // namespace
+
+static void socket_wire_throughput(benchmark::State& state)
+{
+	constexpr int64_t BATCH = 1000;
+	// entities and handler state outlive the wires, whose receiver threads call the handlers
+	RdSignal<std::wstring> client_signal, server_signal;
+	Counter received;
+	SocketWirePair wires;
+	if (!wires.wait_connected())
+	{
+		state.SkipWithError("sockets didn't connect");
+		return;
+	}
+
+	wires.bind_static(client_signal, server_signal, 1);
+	server_signal.advise(wires.lifetime, [&received](std::wstring const&) { received.increment(); });
+
+	const std::wstring payload(static_cast<size_t>(state.range(0)), L'x');
+	int64_t sent = 0;
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < BATCH; ++i)
+		{
+			client_signal.fire(payload);
+		}
+		sent += BATCH;
+		if (!received.wait_for(sent))
+		{
+			state.SkipWithError("messages weren't delivered in time");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * BATCH);
+	state.SetBytesProcessed(state.iterations() * BATCH * state.range(0) * 2);
+}
+
+BENCHMARK(socket_wire_throughput)->RangeMultiplier(16)->Range(16, 1 << 14)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void socket_wire_round_trip(benchmark::State& state)
+{
+	RdSignal<int32_t> client_ping, server_ping;
+	RdSignal<int32_t> client_pong, server_pong;
+	Counter replies;
+	SocketWirePair wires;
+	if (!wires.wait_connected())
+	{
+		state.SkipWithError("sockets didn't connect");
+		return;
+	}
+
+	wires.bind_static(client_ping, server_ping, 1);
+	wires.bind_static(client_pong, server_pong, 2);
+	server_ping.advise(wires.lifetime, [&server_pong](int32_t const& value) { server_pong.fire(value); });
+	client_pong.advise(wires.lifetime, [&replies](int32_t const&) { replies.increment(); });
+
+	int32_t sent = 0;
+	for (auto _ : state)
+	{
+		client_ping.fire(++sent);
+		if (!replies.wait_for(sent))
+		{
+			state.SkipWithError("reply wasn't delivered in time");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(socket_wire_round_trip)->UseRealTime()->Unit(benchmark::kMicrosecond);
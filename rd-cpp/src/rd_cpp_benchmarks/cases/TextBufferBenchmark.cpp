@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include "RdTextBuffer.h"
+#include "ProtocolPair.h"
+
+#include <string>
+
+using namespace rd;
+using namespace rd::benchmarks;
+
+static std::wstring make_document(size_t length)
+{
+	std::wstring text;
+	text.reserve(length);
+	for (size_t i = 0; i < length; ++i)
+	{
+		text.push_back(i % 80 == 79 ? L'\n' : static_cast<wchar_t>(L'a' + i % 26));
+	}
+	return text;
+}
+
+// Keystrokes at a cursor wandering through the document, the cost must not grow with the document size.
+
+template <typename Storage>
+static void text_storage_typing(benchmark::State& state)
+{
+	Storage text(make_document(static_cast<size_t>(state.range(0))));
+	size_t cursor = text.size() / 2;
+	for (auto _ : state)
+	{
+		text.insert(cursor, L"x");
+		cursor = (cursor * 7 + 13) % text.size();
+	}
+	benchmark::DoNotOptimize(text.size());
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(text_storage_typing, TextRope)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 23);
+BENCHMARK_TEMPLATE(text_storage_typing, std::wstring)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 23);
+
+// Slave edits synchronized to the master through the protocol: change serialization, versioning and both documents.
+
+static void text_buffer_typing(benchmark::State& state)
+{
+	// entities outlive the protocols they are bound to
+	RdTextBuffer client_buffer(false);
+	RdTextBuffer server_buffer(true);
+	ProtocolPair protocols;
+	protocols.bind_identified(client_buffer, server_buffer, RdId(1));
+	server_buffer.reset(make_document(static_cast<size_t>(state.range(0))));
+
+	int32_t cursor = static_cast<int32_t>(client_buffer.length() / 2);
+	for (auto _ : state)
+	{
+		client_buffer.insert(cursor, L"x");
+		cursor = static_cast<int32_t>((static_cast<size_t>(cursor) * 7 + 13) % client_buffer.length());
+	}
+	benchmark::DoNotOptimize(server_buffer.length());
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(text_buffer_typing)->Arg(1 << 10)->Arg(1 << 20)->Arg(1 << 23);
+
+// Paste of range(0) characters into the middle of a 1M document and its undo.
+
+static void text_buffer_paste(benchmark::State& state)
+{
+	RdTextBuffer client_buffer(false);
+	RdTextBuffer server_buffer(true);
+	ProtocolPair protocols;
+	protocols.bind_identified(client_buffer, server_buffer, RdId(1));
+	server_buffer.reset(make_document(1 << 20));
+
+	const std::wstring paste = make_document(static_cast<size_t>(state.range(0)));
+	const auto offset = static_cast<int32_t>(client_buffer.length() / 2);
+	for (auto _ : state)
+	{
+		client_buffer.insert(offset, paste);
+		client_buffer.remove(offset, static_cast<int32_t>(paste.size()));
+	}
+	benchmark::DoNotOptimize(server_buffer.length());
+	state.SetItemsProcessed(state.iterations() * 2);
+	state.SetBytesProcessed(protocols.client_wire->bytes_written);
+}
+
+BENCHMARK(text_buffer_paste)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
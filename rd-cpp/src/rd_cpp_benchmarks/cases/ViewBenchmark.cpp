@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include "lifetime/LifetimeDefinition.h"
+#include "reactive/ViewableList.h"
+#include "reactive/ViewableMap.h"
+#include "reactive/ViewableSet.h"
+
+using namespace rd;
+
+// Bind/unbind of a large collection: RdMap/RdList::init view the whole collection to bind its children,
+// the view is dropped when the model is unbound.
+
+static void view_map_bind_unbind(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableMap<int32_t, int32_t> map;
+	for (int32_t i = 0; i < n; ++i)
+	{
+		map.set(i, i);
+	}
+
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		map.view(definition.lifetime, [](Lifetime lf, int32_t const& key, int32_t const& value) { benchmark::DoNotOptimize(lf); });
+		definition.terminate();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(view_map_bind_unbind)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+static void view_set_bind_unbind(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableSet<int32_t> set;
+	for (int32_t i = 0; i < n; ++i)
+	{
+		set.add(i);
+	}
+
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		set.view(definition.lifetime, [](Lifetime lf, int32_t const& value) { benchmark::DoNotOptimize(lf); });
+		definition.terminate();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(view_set_bind_unbind)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+static void view_list_bind_unbind(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableList<int32_t> list;
+	for (int32_t i = 0; i < n; ++i)
+	{
+		list.add(i);
+	}
+
+	for (auto _ : state)
+	{
+		LifetimeDefinition definition(Lifetime::Eternal());
+		list.view(definition.lifetime, [](Lifetime lf, size_t index, int32_t const& value) { benchmark::DoNotOptimize(lf); });
+		definition.terminate();
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(view_list_bind_unbind)->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond);
+
+// Churn under a live view: every removal terminates an entry lifetime and every addition creates one.
+
+static void view_map_churn(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableMap<int32_t, int32_t> map;
+	for (int32_t i = 0; i < n; ++i)
+	{
+		map.set(i, i);
+	}
+
+	LifetimeDefinition definition(Lifetime::Eternal());
+	map.view(definition.lifetime, [](Lifetime lf, int32_t const& key, int32_t const& value) { benchmark::DoNotOptimize(lf); });
+
+	int32_t next = n;
+	for (auto _ : state)
+	{
+		map.remove(next - n);
+		map.set(next, next);
+		++next;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(view_map_churn)->RangeMultiplier(10)->Range(1000, 100000);
@@ -0,0 +1,362 @@
+#include <benchmark/benchmark.h>
+
+#include "lifetime/LifetimeDefinition.h"
+#include "memory/MonotonicArena.h"
+#include "memory/PoolArena.h"
+#include "reactive/ViewableList.h"
+#include "reactive/ViewableMap.h"
+#include "reactive/ViewableSet.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using namespace rd;
+
+// Mutations of collections with a single subscriber, which is the usual shape for models bound to a protocol.
+
+static void viewable_map_set_remove(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	int64_t events = 0;
+	for (auto _ : state)
+	{
+		ViewableMap<int32_t, int32_t> map;
+		LifetimeDefinition definition(Lifetime::Eternal());
+		map.advise(definition.lifetime, [&events](IViewableMap<int32_t, int32_t>::Event const&) { ++events; });
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.set(i, i);
+		}
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.set(i, -i);
+		}
+		for (int32_t i = n - 1; i >= 0; --i)
+		{
+			map.remove(i);
+		}
+	}
+	benchmark::DoNotOptimize(events);
+	state.SetItemsProcessed(state.iterations() * n * 3);
+}
+
+BENCHMARK(viewable_map_set_remove)->RangeMultiplier(10)->Range(100, 10000);
+
+// Removal in insertion order shifted every following entry before the collections left tombstones instead.
+
+static void viewable_map_remove_in_order(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	for (auto _ : state)
+	{
+		ViewableMap<int32_t, int32_t> map;
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.set(i, i);
+		}
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.remove(i);
+		}
+		benchmark::DoNotOptimize(map.size());
+	}
+	state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+BENCHMARK(viewable_map_remove_in_order)->RangeMultiplier(10)->Range(1000, 200000)->Unit(benchmark::kMillisecond);
+
+static void viewable_set_remove_in_order(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	for (auto _ : state)
+	{
+		ViewableSet<int32_t> set;
+		for (int32_t i = 0; i < n; ++i)
+		{
+			set.add(i);
+		}
+		for (int32_t i = 0; i < n; ++i)
+		{
+			set.remove(i);
+		}
+		benchmark::DoNotOptimize(set.size());
+	}
+	state.SetItemsProcessed(state.iterations() * n * 2);
+}
+
+BENCHMARK(viewable_set_remove_in_order)->RangeMultiplier(10)->Range(1000, 200000)->Unit(benchmark::kMillisecond);
+
+static void viewable_map_iterate_after_removals(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableMap<int32_t, int32_t> map;
+	int64_t sum = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		map.clear();
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.set(i, i);
+		}
+		state.ResumeTiming();
+		// every other entry is removed, then the rest is iterated twice
+		for (int32_t i = 0; i < n; i += 2)
+		{
+			map.remove(i);
+		}
+		for (int32_t pass = 0; pass < 2; ++pass)
+		{
+			for (auto const& value : map)
+			{
+				sum += value;
+			}
+		}
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * n * 3 / 2);
+}
+
+BENCHMARK(viewable_map_iterate_after_removals)->RangeMultiplier(10)->Range(1000, 200000)->Unit(benchmark::kMillisecond);
+
+// Small values are kept in the storage of the collections instead of each being wrapped in its own allocation.
+
+namespace
+{
+struct SmallValue
+{
+	int32_t id;
+	int32_t version;
+	double weight;
+
+	friend bool operator==(SmallValue const& lhs, SmallValue const& rhs)
+	{
+		return lhs.id == rhs.id && lhs.version == rhs.version && lhs.weight == rhs.weight;
+	}
+
+	friend bool operator!=(SmallValue const& lhs, SmallValue const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+};
+
+// fills [map] as a protocol does over time, with unrelated allocations between the entries
+void fill_interleaved(ViewableMap<int32_t, SmallValue>& map, int32_t n)
+{
+	std::vector<std::unique_ptr<char[]>> unrelated;
+	unrelated.reserve(n);
+	for (int32_t i = 0; i < n; ++i)
+	{
+		map.set(i, SmallValue{i, 0, i * 0.5});
+		unrelated.emplace_back(new char[48]);
+	}
+}
+}	 // namespace
+
+static void viewable_map_memory_per_entry(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	double bytes_per_entry = 0;
+	for (auto _ : state)
+	{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+		const size_t before = mallinfo2().uordblks;
+#endif
+		ViewableMap<int32_t, SmallValue> map;
+		for (int32_t i = 0; i < n; ++i)
+		{
+			map.set(i, SmallValue{i, 0, i * 0.5});
+		}
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+		bytes_per_entry = static_cast<double>(mallinfo2().uordblks - before) / n;
+#endif
+		benchmark::DoNotOptimize(map.size());
+	}
+	state.counters["bytes_per_entry"] = bytes_per_entry;
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(viewable_map_memory_per_entry)->RangeMultiplier(100)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+static void viewable_map_iterate_small_values(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableMap<int32_t, SmallValue> map;
+	fill_interleaved(map, n);
+	double sum = 0;
+	for (auto _ : state)
+	{
+		for (auto it = map.begin(); it != map.end(); ++it)
+		{
+			sum += it.value().weight;
+		}
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(viewable_map_iterate_small_values)->RangeMultiplier(100)->Range(100, 1000000);
+
+static void viewable_map_lookup_small_values(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	ViewableMap<int32_t, SmallValue> map;
+	fill_interleaved(map, n);
+	double sum = 0;
+	uint32_t key = 0;
+	for (auto _ : state)
+	{
+		// a multiplicative step visits the keys out of order
+		key = (key + 2654435761u) % static_cast<uint32_t>(n);
+		sum += map.get(static_cast<int32_t>(key))->weight;
+	}
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(viewable_map_lookup_small_values)->RangeMultiplier(100)->Range(100, 1000000);
+
+static void viewable_list_add_set_remove(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	int64_t events = 0;
+	for (auto _ : state)
+	{
+		ViewableList<int32_t> list;
+		LifetimeDefinition definition(Lifetime::Eternal());
+		list.advise(definition.lifetime, [&events](IViewableList<int32_t>::Event const&) { ++events; });
+		for (int32_t i = 0; i < n; ++i)
+		{
+			list.add(i);
+		}
+		for (int32_t i = 0; i < n; ++i)
+		{
+			list.set(i, -i);
+		}
+		for (int32_t i = n - 1; i >= 0; --i)
+		{
+			list.removeAt(i);
+		}
+	}
+	benchmark::DoNotOptimize(events);
+	state.SetItemsProcessed(state.iterations() * n * 3);
+}
+
+BENCHMARK(viewable_list_add_set_remove)->RangeMultiplier(10)->Range(100, 10000);
+
+static void viewable_list_insert_front(benchmark::State& state)
+{
+	const auto n = static_cast<int32_t>(state.range(0));
+	for (auto _ : state)
+	{
+		ViewableList<int32_t> list;
+		for (int32_t i = 0; i < n; ++i)
+		{
+			list.add(0, i);
+		}
+		benchmark::DoNotOptimize(list.size());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(viewable_list_insert_front)->RangeMultiplier(10)->Range(100, 10000);
+
+// A viewed model built and torn down with its lifetime: entries, wrapped values, view lifetimes and listeners come
+// from the global heap (0), a pool arena (1) or a monotonic arena (2) attached to the lifetime of the model.
+
+namespace
+{
+struct ModelEntry
+{
+	int64_t payload[12];
+
+	friend bool operator==(ModelEntry const& lhs, ModelEntry const& rhs)
+	{
+		return std::equal(std::begin(lhs.payload), std::end(lhs.payload), std::begin(rhs.payload));
+	}
+
+	friend bool operator!=(ModelEntry const& lhs, ModelEntry const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+};
+
+std::shared_ptr<memory_resource> model_resource(int64_t kind)
+{
+	switch (kind)
+	{
+		case 1:
+			return std::make_shared<PoolArena>();
+		case 2:
+			return std::make_shared<MonotonicArena>();
+		default:
+			return nullptr;
+	}
+}
+}	 // namespace
+
+static void viewable_map_model_teardown(benchmark::State& state)
+{
+	using model_t = ViewableMap<int32_t, ModelEntry, std::allocator<int32_t>, resource_allocator<ModelEntry>>;
+	const auto n = static_cast<int32_t>(state.range(0));
+	int64_t views = 0;
+	for (auto _ : state)
+	{
+		auto resource = model_resource(state.range(1));
+		LifetimeDefinition definition(Lifetime::Eternal(), resource);
+		model_t model((resource_allocator<ModelEntry>(resource.get())));
+		model.view(definition.lifetime, [&views](Lifetime entry_lifetime, std::pair<int32_t const*, ModelEntry const*>) {
+			entry_lifetime->add_action([&views] { ++views; });
+		});
+		for (int32_t i = 0; i < n; ++i)
+		{
+			model.set(i, ModelEntry{{i}});
+		}
+		definition.terminate();
+	}
+	benchmark::DoNotOptimize(views);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(viewable_map_model_teardown)
+	->ArgsProduct({{1000, 100000}, {0, 1, 2}})
+	->Unit(benchmark::kMillisecond);
+
+// The same model, only its teardown is timed: the lifetime terminated, then the model and the resource released.
+
+static void viewable_map_model_teardown_only(benchmark::State& state)
+{
+	using model_t = ViewableMap<int32_t, ModelEntry, std::allocator<int32_t>, resource_allocator<ModelEntry>>;
+	const auto n = static_cast<int32_t>(state.range(0));
+	int64_t views = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto definition = std::make_unique<LifetimeDefinition>(Lifetime::Eternal(), model_resource(state.range(1)));
+		auto model = std::make_unique<model_t>(resource_allocator<ModelEntry>(definition->lifetime->resource().get()));
+		model->view(definition->lifetime, [&views](Lifetime entry_lifetime, std::pair<int32_t const*, ModelEntry const*>) {
+			entry_lifetime->add_action([&views] { ++views; });
+		});
+		for (int32_t i = 0; i < n; ++i)
+		{
+			model->set(i, ModelEntry{{i}});
+		}
+		state.ResumeTiming();
+
+		definition->terminate();
+		model.reset();
+		definition.reset();
+	}
+	benchmark::DoNotOptimize(views);
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(viewable_map_model_teardown_only)
+	->ArgsProduct({{1000, 100000}, {0, 1, 2}})
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,33 @@
+#include "DirectWire.h"
+
+namespace rd
+{
+namespace benchmarks
+{
+DirectWire::DirectWire(IScheduler* scheduler) : WireBase(scheduler)
+{
+	connected.set(true);
+}
+
+void DirectWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) const
+{
+	if (record_to_snapshot(id, writer))
+	{
+		return;
+	}
+
+	Buffer buffer;
+	write_context(buffer);
+	writer(buffer);
+	bytes_written += buffer.get_position();
+	buffer.rewind();
+
+	counterpart->dispatch(id, std::move(buffer));
+}
+
+void DirectWire::dispatch(RdId const& id, Buffer message) const
+{
+	message_broker.dispatch(id, std::move(message));
+}
+}	 // namespace benchmarks
+}	 // namespace rd
@@ -0,0 +1,35 @@
+#ifndef RD_CPP_BENCHMARKS_DIRECTWIRE_H
+#define RD_CPP_BENCHMARKS_DIRECTWIRE_H
+
+#include "base/WireBase.h"
+
+namespace rd
+{
+namespace benchmarks
+{
+/**
+ * \brief Wire which hands every message synchronously to the counterpart's message broker, so that
+ * benchmarks measure serialization and dispatch only.
+ */
+class DirectWire : public WireBase
+{
+public:
+	DirectWire const* counterpart = nullptr;
+
+	mutable int64_t bytes_written = 0;
+
+	// region ctor/dtor
+
+	explicit DirectWire(IScheduler* scheduler);
+
+	virtual ~DirectWire() override = default;
+	// endregion
+
+	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
+
+	void dispatch(RdId const& id, Buffer message) const;
+};
+}	 // namespace benchmarks
+}	 // namespace rd
+
+#endif	  // RD_CPP_BENCHMARKS_DIRECTWIRE_H
@@ -0,0 +1,23 @@
+#include "ProtocolPair.h"
+
+namespace rd
+{
+namespace benchmarks
+{
+ProtocolPair::ProtocolPair()
+{
+	client_wire = std::make_shared<DirectWire>(&client_scheduler);
+	server_wire = std::make_shared<DirectWire>(&server_scheduler);
+	client_wire->counterpart = server_wire.get();
+	server_wire->counterpart = client_wire.get();
+
+	client_protocol = std::make_unique<Protocol>(Identities::CLIENT, &client_scheduler, client_wire, lifetime_def.lifetime);
+	server_protocol = std::make_unique<Protocol>(Identities::SERVER, &server_scheduler, server_wire, lifetime_def.lifetime);
+}
+
+ProtocolPair::~ProtocolPair()
+{
+	lifetime_def.terminate();
+}
+}	 // namespace benchmarks
+}	 // namespace rd
@@ -0,0 +1,66 @@
+#ifndef RD_CPP_BENCHMARKS_PROTOCOLPAIR_H
+#define RD_CPP_BENCHMARKS_PROTOCOLPAIR_H
+
+#include "DirectWire.h"
+#include "lifetime/LifetimeDefinition.h"
+#include "protocol/Identities.h"
+#include "protocol/Protocol.h"
+#include "scheduler/SimpleScheduler.h"
+
+#include <memory>
+#include <string>
+
+namespace rd
+{
+namespace benchmarks
+{
+/**
+ * \brief Client and server protocols connected by \ref DirectWire, entities bound by \ref bind_static on both sides
+ * talk to each other synchronously.
+ */
+class ProtocolPair
+{
+public:
+	LifetimeDefinition lifetime_def{Lifetime::Eternal()};
+
+	SimpleScheduler client_scheduler;
+	SimpleScheduler server_scheduler;
+
+	std::shared_ptr<DirectWire> client_wire;
+	std::shared_ptr<DirectWire> server_wire;
+
+	std::unique_ptr<Protocol> client_protocol;
+	std::unique_ptr<Protocol> server_protocol;
+
+	// region ctor/dtor
+
+	ProtocolPair();
+
+	ProtocolPair(ProtocolPair const&) = delete;
+
+	ProtocolPair& operator=(ProtocolPair const&) = delete;
+
+	~ProtocolPair();
+	// endregion
+
+	template <typename T>
+	void bind_static(T& client, T& server, int64_t id, std::string const& name = "top") const
+	{
+		statics(client, id).bind(lifetime_def.lifetime, client_protocol.get(), name);
+		statics(server, id).bind(lifetime_def.lifetime, server_protocol.get(), name);
+	}
+
+	/// \brief Like \ref bind_static, but also assigns ids to the children of the entities, as generated roots do.
+	template <typename T>
+	void bind_identified(T& client, T& server, RdId const& id, std::string const& name = "top") const
+	{
+		client.identify(*client_protocol->get_identity(), id);
+		client.bind(lifetime_def.lifetime, client_protocol.get(), name);
+		server.identify(*server_protocol->get_identity(), id);
+		server.bind(lifetime_def.lifetime, server_protocol.get(), name);
+	}
+};
+}	 // namespace benchmarks
+}	 // namespace rd
+
+#endif	  // RD_CPP_BENCHMARKS_PROTOCOLPAIR_H
@@ -0,0 +1,354 @@
+#include "SimulatedWire.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace rd
+{
+namespace benchmarks
+{
+// length and sequence number, as in SocketWire
+static constexpr int64_t PACKAGE_HEADER_LENGTH = sizeof(int32_t) + sizeof(sequence_number_t);
+
+namespace
+{
+SimulatedNetwork::time_t percentile(std::vector<SimulatedNetwork::time_t> const& latencies, double fraction)
+{
+	if (latencies.empty())
+	{
+		return SimulatedNetwork::time_t(0);
+	}
+	std::vector<SimulatedNetwork::time_t> sorted = latencies;
+	const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+	std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+	return sorted[index];
+}
+}	 // namespace
+
+SimulatedNetwork::time_t SimulatedNetwork::Stats::latency_percentile(double fraction) const
+{
+	return percentile(latencies, fraction);
+}
+
+SimulatedNetwork::time_t SimulatedNetwork::Stats::latency_percentile(double fraction, SendPriority lane) const
+{
+	return percentile(lane_latencies[static_cast<size_t>(lane)], fraction);
+}
+
+SimulatedNetwork::SimulatedNetwork(LinkSettings settings) : settings(settings), random(settings.seed)
+{
+}
+
+// std distributions are implementation defined, these keep the results the same on every platform
+
+double SimulatedNetwork::next_probability()
+{
+	return static_cast<double>(random() >> 11) * (1.0 / static_cast<double>(1ull << 53));
+}
+
+SimulatedNetwork::time_t SimulatedNetwork::next_jitter()
+{
+	const auto jitter = static_cast<uint64_t>(time_t(settings.jitter).count());
+	if (jitter == 0)
+	{
+		return time_t(0);
+	}
+	return time_t(static_cast<int64_t>(random() % (2 * jitter + 1)) - static_cast<int64_t>(jitter));
+}
+
+void SimulatedNetwork::schedule(time_t at, std::function<void()> action)
+{
+	events.push(Event{(std::max)(at, now), next_order++, epoch, std::move(action)});
+}
+
+void SimulatedNetwork::connect(SimulatedWire& client, SimulatedWire& server)
+{
+	client.index = 0;
+	server.index = 1;
+	wires = {&client, &server};
+	reconnect();
+}
+
+void SimulatedNetwork::disconnect()
+{
+	// send processors stop before the in-flight packages are dropped, so nothing is sent into the dead connection
+	for (auto* wire : wires)
+	{
+		wire->set_paused(true);
+		wire->async_send_buffer.pause("Disconnected");
+		wire->connected.set(false);
+	}
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	++epoch;
+	++stats.disconnects;
+	disconnect_pending = false;
+	link_free_at = {now, now};
+	for (auto* wire : wires)
+	{
+		wire->early_packages.clear();
+	}
+	schedule(now + settings.reconnect_delay, [this] { reconnect(); });
+}
+
+void SimulatedNetwork::reconnect()
+{
+	for (auto* wire : wires)
+	{
+		wire->set_paused(false);
+		wire->connected.set(true);
+		wire->async_send_buffer.resume();
+	}
+}
+
+bool SimulatedNetwork::transmit(SimulatedWire const& from, Buffer::ByteArray const& package, sequence_number_t seqn, bool retransmit)
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+
+	const size_t direction = from.index;
+	SimulatedWire* to = wires[1 - direction];
+
+	time_t& free_at = link_free_at[direction];
+	free_at = (std::max)(free_at, now);
+	if (settings.bandwidth > 0)
+	{
+		free_at += time_t((static_cast<int64_t>(package.size()) + PACKAGE_HEADER_LENGTH) * 1000000000 / settings.bandwidth);
+	}
+	time_t arrival = free_at + settings.latency + next_jitter();
+	if (settings.reorder_probability > 0 && next_probability() < settings.reorder_probability)
+	{
+		arrival += settings.reorder_delay;
+	}
+
+	++(retransmit ? stats.retransmitted_packages : stats.packages);
+	schedule(arrival, [to, package, seqn] { to->receive_package(package, seqn); });
+
+	if (!disconnect_pending && settings.disconnect_probability > 0 && next_probability() < settings.disconnect_probability)
+	{
+		// the packages which have left the link by then still arrive
+		disconnect_pending = true;
+		schedule(free_at, [this] { disconnect(); });
+	}
+	return true;
+}
+
+void SimulatedNetwork::acknowledge(SimulatedWire const& from, sequence_number_t seqn)
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+
+	// acknowledgements aren't jittered, so they arrive in order like in a stream
+	const size_t direction = from.index;
+	SimulatedWire* to = wires[1 - direction];
+
+	time_t& free_at = link_free_at[direction];
+	free_at = (std::max)(free_at, now);
+	if (settings.bandwidth > 0)
+	{
+		free_at += time_t(PACKAGE_HEADER_LENGTH * 1000000000 / settings.bandwidth);
+	}
+	schedule(free_at + settings.latency, [to, seqn] { to->async_send_buffer.acknowledge(seqn); });
+}
+
+void SimulatedNetwork::record(time_t sent, size_t size, SendPriority lane)
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	++stats.messages;
+	stats.bytes += static_cast<int64_t>(size);
+	stats.latencies.push_back(now - sent);
+	stats.lane_latencies[static_cast<size_t>(lane)].push_back(now - sent);
+}
+
+void SimulatedNetwork::run_until_idle()
+{
+	while (true)
+	{
+		// packages are handed over by the send processor threads, wait for them to keep the order of events deterministic
+		for (auto* wire : wires)
+		{
+			wire->wait_sent();
+		}
+
+		Event event;
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			if (events.empty())
+			{
+				return;
+			}
+			event = events.top();
+			events.pop();
+			if (event.epoch != epoch)
+			{
+				continue;
+			}
+			now = (std::max)(now, event.time);
+		}
+		event.action();
+	}
+}
+
+SimulatedNetwork::time_t SimulatedNetwork::get_now()
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	return now;
+}
+
+SimulatedNetwork::Stats SimulatedNetwork::take_stats()
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	return std::exchange(stats, Stats{});
+}
+
+constexpr size_t SimulatedWire::CHUNK_SIZE;
+
+SimulatedWire::SimulatedWire(SimulatedNetwork& network, IScheduler* scheduler, std::string id)
+	: WireBase(scheduler), network(network), id(std::move(id))
+{
+	async_send_buffer.pause("initial");
+	async_send_buffer.start();
+}
+
+SimulatedWire::~SimulatedWire()
+{
+	async_send_buffer.terminate(std::chrono::milliseconds(1000));
+}
+
+void SimulatedWire::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const
+{
+	RD_ASSERT_MSG(!rd_id.isNull(), "id mustn't be null");
+	if (record_to_snapshot(rd_id, writer))
+	{
+		return;
+	}
+
+	Buffer buffer;
+	buffer.write_integral<int32_t>(0);	  // placeholder for length
+	rd_id.write(buffer);
+	write_context(buffer);
+	writer(buffer);
+
+	const auto len = static_cast<int32_t>(buffer.get_position());
+	buffer.rewind();
+	buffer.write_integral<int32_t>(len - 4);
+	buffer.set_position(len);
+
+	const auto priority = get_send_priority(rd_id);
+	{
+		std::lock_guard<decltype(send_lock)> guard(send_lock);
+		put_packages += (static_cast<size_t>(len) + CHUNK_SIZE - 1) / CHUNK_SIZE;	   // split like in put()
+		send_times[static_cast<size_t>(priority)].push_back(network.get_now());
+	}
+	async_send_buffer.put(std::move(buffer).getRealArray(), priority);
+}
+
+void SimulatedWire::hold()
+{
+	async_send_buffer.pause("hold");
+}
+
+void SimulatedWire::release()
+{
+	async_send_buffer.resume();
+}
+
+bool SimulatedWire::send0(Buffer::ByteArray const& package, sequence_number_t seqn) const
+{
+	bool retransmit = false;
+	{
+		std::lock_guard<decltype(send_lock)> guard(send_lock);
+		retransmit = seqn <= max_sent_seqn;
+	}
+	network.transmit(*this, package, seqn, retransmit);
+	{
+		std::lock_guard<decltype(send_lock)> guard(send_lock);
+		max_sent_seqn = (std::max)(max_sent_seqn, seqn);
+	}
+	send_cv.notify_all();
+	return true;
+}
+
+void SimulatedWire::wait_sent() const
+{
+	std::unique_lock<decltype(send_lock)> guard(send_lock);
+	send_cv.wait(guard, [this] { return paused || max_sent_seqn >= put_packages; });
+}
+
+void SimulatedWire::set_paused(bool value)
+{
+	{
+		std::lock_guard<decltype(send_lock)> guard(send_lock);
+		paused = value;
+	}
+	send_cv.notify_all();
+}
+
+void SimulatedWire::receive_package(Buffer::ByteArray package, sequence_number_t seqn)
+{
+	// duplicates come from retransmission after reconnect, the acknowledgement of a later package covers them
+	if (seqn <= max_received_seqn)
+	{
+		return;
+	}
+	if (seqn != max_received_seqn + 1)
+	{
+		early_packages.emplace(seqn, std::move(package));
+		return;
+	}
+
+	while (true)
+	{
+		max_received_seqn = seqn;
+		network.acknowledge(*this, seqn);
+		stream.insert(stream.end(), package.begin(), package.end());
+
+		auto it = early_packages.find(seqn + 1);
+		if (it == early_packages.end())
+		{
+			break;
+		}
+		++seqn;
+		package = std::move(it->second);
+		early_packages.erase(it);
+	}
+	dispatch_messages();
+}
+
+void SimulatedWire::dispatch_messages()
+{
+	SimulatedWire const* counterpart = network.wires[1 - index];
+	while (stream.size() - stream_position >= sizeof(int32_t))
+	{
+		int32_t len = 0;
+		std::copy_n(stream.begin() + stream_position, sizeof(len), reinterpret_cast<Buffer::word_t*>(&len));
+		const size_t message_end = stream_position + sizeof(int32_t) + len;
+		if (stream.size() < message_end)
+		{
+			break;
+		}
+		RdId::hash_t hash = 0;
+		const size_t id_position = stream_position + sizeof(int32_t);
+		std::copy_n(stream.begin() + id_position, sizeof(hash), reinterpret_cast<Buffer::word_t*>(&hash));
+		Buffer::ByteArray message(stream.begin() + id_position + sizeof(hash), stream.begin() + message_end);
+		stream_position = message_end;
+
+		// the entities are bound on both sides under the same ids
+		const auto lane = counterpart->get_send_priority(RdId(hash));
+		SimulatedNetwork::time_t sent{};
+		{
+			std::lock_guard<decltype(send_lock)> guard(counterpart->send_lock);
+			auto& times = counterpart->send_times[static_cast<size_t>(lane)];
+			sent = times.front();
+			times.pop_front();
+		}
+		network.record(sent, sizeof(int32_t) + len, lane);
+
+		message_broker.dispatch(RdId(hash), Buffer(std::move(message)));
+	}
+	if (stream_position == stream.size())
+	{
+		stream.clear();
+		stream_position = 0;
+	}
+}
+}	 // namespace benchmarks
+}	 // namespace rd
@@ -0,0 +1,205 @@
+#ifndef RD_CPP_BENCHMARKS_SIMULATEDWIRE_H
+#define RD_CPP_BENCHMARKS_SIMULATEDWIRE_H
+
+#include "base/WireBase.h"
+#include "wire/ByteBufferAsyncProcessor.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace rd
+{
+namespace benchmarks
+{
+class SimulatedWire;
+
+/**
+ * \brief Properties of a simulated link, the same in both directions.
+ */
+struct LinkSettings
+{
+	std::chrono::microseconds latency{100};
+	/// \brief Each package is delayed by an additional uniformly distributed [-jitter, jitter].
+	std::chrono::microseconds jitter{0};
+	/// \brief Bytes per second, 0 means unlimited.
+	int64_t bandwidth = 0;
+	/// \brief Probability of a package to be delayed by [reorder_delay] and overtaken by the following ones.
+	double reorder_probability = 0;
+	std::chrono::microseconds reorder_delay{0};
+	/// \brief Probability of the connection to break when a package has been put on the link.
+	double disconnect_probability = 0;
+	std::chrono::microseconds reconnect_delay{10000};
+	uint64_t seed = 0;
+};
+
+/**
+ * \brief Deterministic in-process network for a pair of \ref SimulatedWire.
+ *
+ * \details Time is virtual: nothing happens until \ref run_until_idle delivers the scheduled packages in the order of
+ * their arrival time, so the results depend on [LinkSettings] only and not on the machine. Packages are delivered
+ * to the wire in sequence order like TCP does, a reordered package stalls the following ones. A disconnect drops
+ * everything in flight, the wires pause their send processors and on reconnect the unacknowledged packages are sent again.
+ */
+class SimulatedNetwork
+{
+public:
+	using time_t = std::chrono::nanoseconds;
+
+	struct Stats
+	{
+		int64_t messages = 0;
+		int64_t bytes = 0;
+		int64_t packages = 0;
+		int64_t retransmitted_packages = 0;
+		int64_t disconnects = 0;
+		/// \brief Virtual time from sending a message to its dispatch on the other side.
+		std::vector<time_t> latencies;
+		/// \brief The same latencies by SendPriority of the sending entity.
+		std::array<std::vector<time_t>, 3> lane_latencies;
+
+		/// \param fraction in [0, 1]
+		time_t latency_percentile(double fraction) const;
+
+		time_t latency_percentile(double fraction, SendPriority lane) const;
+	};
+
+private:
+	struct Event
+	{
+		time_t time;
+		uint64_t order;
+		uint64_t epoch;
+		std::function<void()> action;
+	};
+
+	struct Later
+	{
+		bool operator()(Event const& a, Event const& b) const
+		{
+			return a.time > b.time || (a.time == b.time && a.order > b.order);
+		}
+	};
+
+	LinkSettings settings;
+	std::mt19937_64 random;
+
+	std::mutex lock;
+	std::priority_queue<Event, std::vector<Event>, Later> events;
+	time_t now{0};
+	uint64_t next_order = 0;
+	uint64_t epoch = 0;
+	std::array<SimulatedWire*, 2> wires{};
+	std::array<time_t, 2> link_free_at{};
+	bool disconnect_pending = false;
+	Stats stats;
+
+	double next_probability();
+
+	time_t next_jitter();
+
+	void schedule(time_t at, std::function<void()> action);
+
+	void disconnect();
+
+	void reconnect();
+
+	bool transmit(SimulatedWire const& from, Buffer::ByteArray const& package, sequence_number_t seqn, bool retransmit);
+
+	void acknowledge(SimulatedWire const& from, sequence_number_t seqn);
+
+	void record(time_t sent, size_t size, SendPriority lane);
+
+	friend class SimulatedWire;
+
+public:
+	// region ctor/dtor
+
+	explicit SimulatedNetwork(LinkSettings settings);
+
+	SimulatedNetwork(SimulatedNetwork const&) = delete;
+
+	SimulatedNetwork& operator=(SimulatedNetwork const&) = delete;
+	// endregion
+
+	/// \brief Connects the wires, which must outlive neither the network nor each other.
+	void connect(SimulatedWire& client, SimulatedWire& server);
+
+	/// \brief Delivers packages and acknowledgements until nothing is in flight.
+	void run_until_idle();
+
+	time_t get_now();
+
+	Stats take_stats();
+};
+
+/**
+ * \brief Wire over \ref SimulatedNetwork, frames messages and splits them into packages the same way SocketWire does
+ * and uses the same ByteBufferAsyncProcessor for sequencing, acknowledgement and retransmission.
+ */
+class SimulatedWire : public WireBase
+{
+	SimulatedNetwork& network;
+	size_t index = 0;
+	std::string id;
+
+	mutable std::mutex send_lock;
+	mutable std::condition_variable send_cv;
+	mutable bool paused = true;
+	mutable int64_t put_packages = 0;
+	mutable sequence_number_t max_sent_seqn = 0;
+	// by SendPriority, the lanes may overtake each other
+	mutable std::array<std::deque<SimulatedNetwork::time_t>, 3> send_times;
+
+	static constexpr size_t CHUNK_SIZE = 16370;
+
+	mutable ByteBufferAsyncProcessor async_send_buffer{
+		id + "-AsyncSendProcessor",
+		[this](Buffer::ByteArray const& it, sequence_number_t seqn) -> bool { return this->send0(it, seqn); }, CHUNK_SIZE};
+
+	// receiving side, accessed by the network only
+	sequence_number_t max_received_seqn = 0;
+	std::map<sequence_number_t, Buffer::ByteArray> early_packages;
+	Buffer::ByteArray stream;
+	size_t stream_position = 0;
+
+	bool send0(Buffer::ByteArray const& package, sequence_number_t seqn) const;
+
+	void wait_sent() const;
+
+	void set_paused(bool value);
+
+	void receive_package(Buffer::ByteArray package, sequence_number_t seqn);
+
+	void dispatch_messages();
+
+	friend class SimulatedNetwork;
+
+public:
+	// region ctor/dtor
+
+	SimulatedWire(SimulatedNetwork& network, IScheduler* scheduler, std::string id);
+
+	virtual ~SimulatedWire() override;
+	// endregion
+
+	void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const override;
+
+	/// \brief Keeps the messages in the send queue until \ref release, as a socket that doesn't accept more data does.
+	void hold();
+
+	void release();
+};
+}	 // namespace benchmarks
+}	 // namespace rd
+
+#endif	  // RD_CPP_BENCHMARKS_SIMULATEDWIRE_H
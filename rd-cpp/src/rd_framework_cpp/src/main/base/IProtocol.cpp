@@ -4,6 +4,7 @@
 #include "protocol/Identities.h"
 #include "base/IWire.h"
 #include "base/IProtocol.h"
+#include "context/ProtocolContexts.h"
 //#include "serialization/SerializationCtx.h"
 
 #include <utility>
@@ -34,6 +35,11 @@ const IWire* IProtocol::get_wire() const
 	return wire.get();
 }
 
+ProtocolContexts const& IProtocol::get_contexts() const
+{
+	return *contexts;
+}
+
 const Serializers& IProtocol::get_serializers() const
 {
 	return *serializers;
@@ -18,6 +18,8 @@ namespace rd
 // region predeclared
 
 class SerializationCtx;
+
+class ProtocolContexts;
 // endregion
 
 /**
@@ -35,6 +37,7 @@ protected:
 
 	std::shared_ptr<Identities> identity;
 	IScheduler* scheduler = nullptr;
+	std::shared_ptr<ProtocolContexts> contexts;
 
 public:
 	std::shared_ptr<IWire> wire;
@@ -59,6 +62,11 @@ public:
 
 	const IWire* get_wire() const;
 
+	/**
+	 * \brief Contexts whose values travel with the messages of this protocol.
+	 */
+	ProtocolContexts const& get_contexts() const;
+
 	const Serializers& get_serializers() const;
 
 	const RName& get_location() const override;
@@ -4,6 +4,7 @@
 #include "IRdBindable.h"
 #include "scheduler/base/IScheduler.h"
 #include "IRdWireable.h"
+#include "SendPriority.h"
 
 #include <rd_framework_export.h>
 
@@ -21,6 +22,19 @@ public:
 	 * Otherwise, local changes can be performed only on the UI thread.
 	 */
 	bool async = false;
+
+	/**
+	 * \brief Lane of the messages sent by this object, must be set before it's bound. Messages of other objects may
+	 * overtake the ones of a bulk object, so its messages mustn't create objects the others refer to.
+	 */
+	SendPriority send_priority = SendPriority::Interactive;
+
+	/**
+	 * \brief If set to true, a message of this object still waiting to be sent is dropped when the next one that
+	 * supersedes it is sent, see \ref IWire::send_latest. Supported by \ref RdProperty and \ref RdMap, whose
+	 * messages for the same key supersede each other.
+	 */
+	bool coalesce_sent = false;
 	// region ctor/dtor
 
 	IRdReactive() = default;
@@ -39,6 +53,15 @@ public:
 	 * \param buffer where serialised info is stored
 	 */
 	virtual void on_wire_received(Buffer buffer) const = 0;
+
+	/**
+	 * \brief Whether a received message still waiting in the queue of the wire scheduler is dropped when the next one
+	 * for this object arrives, see \ref RdPropertyBase::coalesce_received.
+	 */
+	virtual bool is_coalescing_received() const
+	{
+		return false;
+	}
 };
 }	 // namespace rd
 
@@ -12,6 +12,8 @@ RD_PUSH_STL_EXPORTS_WARNINGS
 namespace rd
 {
 class RdReactiveBase;
+
+class ProtocolContexts;
 /**
  * \brief Sends and receives serialized object data over a network or a similar connection.
  */
@@ -37,6 +39,29 @@ public:
 	 */
 	virtual void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const = 0;
 
+	/**
+	 * \brief Sends like [send], but only the latest of the messages with the same [id] and [key] matters: a message
+	 * sent before which hasn't gone out yet is dropped, e.g. a value of a property set again. Wires without an outgoing
+	 * queue send every message.
+	 * \param key distinguishes the messages of the recipient that don't supersede each other, e.g. the serialized keys
+	 * of a map.
+	 */
+	virtual void send_latest(RdId const& id, std::string const& /*key*/, std::function<void(Buffer& buffer)> writer) const
+	{
+		send(id, std::move(writer));
+	}
+
+	/**
+	 * \brief Runs [action] and sends the messages it sends through this wire as a single snapshot, e.g. the initial
+	 * values of a model being bound. The counterpart applies them in order, in one task of its default scheduler.
+	 * Wires that don't support snapshots send the messages one by one.
+	 * \param action sends the messages of the snapshot.
+	 */
+	virtual void send_snapshot(std::function<void()> action) const
+	{
+		action();
+	}
+
 	/**
 	 * \brief Adds a [handler] for receiving updated values of the object with the given [id]. The handler is removed
 	 * when the given [lifetime] is terminated.
@@ -44,6 +69,14 @@ public:
 	 * \param entity to be subscripted
 	 */
 	virtual void advise(Lifetime lifetime, RdReactiveBase const* entity) const = 0;
+
+	/**
+	 * \brief Called by the protocol that owns the wire, the wire writes and reads the values of [contexts] in the
+	 * headers of messages. Wires forwarding messages to another wire ignore it.
+	 */
+	virtual void setup_contexts(ProtocolContexts const* /*contexts*/) const
+	{
+	}
 };
 }	 // namespace rd
 
@@ -4,6 +4,20 @@
 
 namespace rd
 {
+namespace
+{
+// shared by all the entities that were never bound
+RName const& not_bound_location()
+{
+	static const RName location("<<not bound>>");
+	return location;
+}
+}	 // namespace
+
+RdBindableBase::RdBindableBase() : location(not_bound_location())
+{
+}
+
 std::string RdBindableBase::toString() const
 {
 	return "location=" + to_string(location) + ",rdid=" + to_string(rdid);
@@ -30,9 +30,7 @@ protected:
 public:
 	// region ctor/dtor
 
-	RdBindableBase() : location("<<not bound>>")
-	{
-	}
+	RdBindableBase();
 
 	RdBindableBase(RdBindableBase&& other) = default;
 
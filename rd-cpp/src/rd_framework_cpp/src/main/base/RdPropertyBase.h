@@ -22,6 +22,12 @@ public:
 
 	bool is_master = false;
 
+	/**
+	 * \brief If set to true, a received value still waiting in the queue of the wire scheduler is dropped when the
+	 * next one arrives, so [on_wire_received] runs once per burst with the latest value, e.g. for properties bound to UI.
+	 */
+	bool coalesce_received = false;
+
 	// region ctor/dtor
 
 	RdPropertyBase() = default;
@@ -73,12 +79,24 @@ public:
 			{
 				master_version++;
 			}
-			get_wire()->send(rdid, [this, &v](Buffer& buffer) {
+			auto writer = [this, &v](Buffer& buffer) {
 				buffer.write_integral<int32_t>(master_version);
 				S::write(this->get_serialization_context(), buffer, v);
-				spdlog::get("logSend")->trace("SEND property {} + {}:: ver = {}, value = {}", to_string(location), to_string(rdid),
-					std::to_string(master_version), to_string(v));
-			});
+				auto logger = spdlog::get("logSend");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace("SEND property {} + {}:: ver = {}, value = {}", to_string(location), to_string(rdid),
+						std::to_string(master_version), to_string(v));
+				}
+			};
+			if (coalesce_sent)
+			{
+				get_wire()->send_latest(rdid, {}, writer);
+			}
+			else
+			{
+				get_wire()->send(rdid, writer);
+			}
 		});
 
 		get_wire()->advise(lifetime, this);
@@ -94,14 +112,23 @@ public:
 		}
 	}
 
+	bool is_coalescing_received() const override
+	{
+		return coalesce_received;
+	}
+
 	void on_wire_received(Buffer buffer) const override
 	{
 		int32_t version = buffer.read_integral<int32_t>();
 		WT v = S::read(this->get_serialization_context(), buffer);
 
 		bool rejected = is_master && version < master_version;
-		spdlog::get("logSend")->trace("RECV property {} {}:: oldver={}, ver={}, value = {}{}", to_string(location), to_string(rdid),
-			master_version, version, to_string(v), (rejected ? ">> REJECTED" : ""));
+		auto logger = spdlog::get("logSend");
+		if (logger->should_log(spdlog::level::trace))
+		{
+			logger->trace("RECV property {} {}:: oldver={}, ver={}, value = {}{}", to_string(location), to_string(rdid),
+				master_version, version, to_string(v), (rejected ? ">> REJECTED" : ""));
+		}
 		if (rejected)
 		{
 			return;
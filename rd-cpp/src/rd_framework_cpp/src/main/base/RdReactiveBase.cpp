@@ -12,11 +12,13 @@ std::shared_ptr<spdlog::logger> logSend =
 RdReactiveBase::RdReactiveBase(RdReactiveBase&& other) : RdBindableBase(std::move(other)) /*, async(other.async)*/
 {
 	async = other.async;
+	send_priority = other.send_priority;
 }
 
 RdReactiveBase& RdReactiveBase::operator=(RdReactiveBase&& other)
 {
 	async = other.async;
+	send_priority = other.send_priority;
 	static_cast<RdBindableBase&>(*this) = std::move(other);
 	return *this;
 }
@@ -0,0 +1,25 @@
+#ifndef RD_CPP_SENDPRIORITY_H
+#define RD_CPP_SENDPRIORITY_H
+
+#include <cstdint>
+
+namespace rd
+{
+/**
+ * \brief Lane of the messages of an entity in the send queue of a wire.
+ *
+ * Wires with a send queue send the queued messages of a lane before the ones of the lanes after it, the messages of
+ * the same lane are sent in order. A message can't be interrupted once it's being sent.
+ */
+enum class SendPriority : int8_t
+{
+	/// \brief Service messages the other messages may depend on: wire capabilities, interned values and context
+	/// declarations.
+	Control,
+	Interactive,
+	/// \brief Large values that may be overtaken by the messages of the other lanes.
+	Bulk
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_SENDPRIORITY_H
@@ -1,9 +1,158 @@
 #include "WireBase.h"
 
+#include "context/ProtocolContexts.h"
+
+#include <cstring>
+
 namespace rd
 {
+namespace
+{
+struct SnapshotRecording
+{
+	WireBase const* wire;
+	Buffer buffer;
+	int32_t count = 0;
+
+	explicit SnapshotRecording(WireBase const* wire) : wire(wire)
+	{
+	}
+};
+
+// the snapshot being recorded by this thread
+thread_local SnapshotRecording* recording = nullptr;
+
+class RecordingGuard
+{
+	SnapshotRecording* outer;
+
+public:
+	explicit RecordingGuard(SnapshotRecording* current) : outer(recording)
+	{
+		recording = current;
+	}
+
+	RecordingGuard(RecordingGuard const&) = delete;
+
+	RecordingGuard& operator=(RecordingGuard const&) = delete;
+
+	~RecordingGuard()
+	{
+		recording = outer;
+	}
+};
+}	 // namespace
+
 void WireBase::advise(Lifetime lifetime, const RdReactiveBase* entity) const
 {
 	message_broker.advise_on(lifetime, entity);
+
+	if (entity->send_priority != SendPriority::Interactive && !lifetime->is_terminated())
+	{
+		const RdId id = entity->get_id();
+		{
+			std::lock_guard<decltype(priorities_lock)> guard(priorities_lock);
+			priorities[id] = entity->send_priority;
+			priorities_count = priorities.size();
+		}
+		lifetime->add_action([this, id] {
+			std::lock_guard<decltype(priorities_lock)> guard(priorities_lock);
+			priorities.erase(id);
+			priorities_count = priorities.size();
+		});
+	}
+}
+
+SendPriority WireBase::get_send_priority(RdId const& id) const
+{
+	if (priorities_count.load(std::memory_order_relaxed) == 0)
+	{
+		return SendPriority::Interactive;
+	}
+	std::lock_guard<decltype(priorities_lock)> guard(priorities_lock);
+	auto it = priorities.find(id);
+	return it == priorities.end() ? SendPriority::Interactive : it->second;
+}
+
+void WireBase::setup_contexts(ProtocolContexts const* new_contexts) const
+{
+	contexts = new_contexts;
+	message_broker.set_contexts(new_contexts);
+}
+
+void WireBase::write_context(Buffer& buffer) const
+{
+	if (contexts)
+	{
+		contexts->write_current_message_context(buffer);
+	}
+	else
+	{
+		ProtocolContexts::write_empty_contexts(buffer);
+	}
+}
+
+void WireBase::send_snapshot(std::function<void()> action) const
+{
+	if (recording && recording->wire == this)
+	{
+		// nested snapshots are a part of the outer one
+		action();
+		return;
+	}
+
+	SnapshotRecording snapshot(this);
+	{
+		RecordingGuard guard(&snapshot);
+		action();
+	}
+	if (snapshot.count == 0)
+	{
+		return;
+	}
+
+	auto send_snapshot_message = [&] {
+		send(MessageBroker::SNAPSHOT_ID, [&](Buffer& buffer) {
+			const auto size = snapshot.buffer.get_position();
+			buffer.write_integral<int32_t>(snapshot.count);
+			buffer.require_available(size);
+			memcpy(buffer.current_pointer(), snapshot.buffer.data(), size);
+			buffer.set_position(buffer.get_position() + size);
+		});
+	};
+	if (contexts)
+	{
+		// the messages of the snapshot carry their own context headers
+		contexts->send_without_contexts(send_snapshot_message);
+	}
+	else
+	{
+		send_snapshot_message();
+	}
+}
+
+bool WireBase::record_to_snapshot(
+	RdId const& id, std::function<void(Buffer& buffer)> const& writer, StringEncoding encoding) const
+{
+	if (!recording || recording->wire != this)
+	{
+		return false;
+	}
+
+	// written apart, so that the messages the writer sends itself (e.g. interned values) go first
+	Buffer message;
+	message.set_string_encoding(encoding);
+	write_context(message);
+	writer(message);
+	const auto size = message.get_position();
+
+	Buffer& buffer = recording->buffer;
+	buffer.write_integral<int32_t>(static_cast<int32_t>(size + sizeof(RdId::hash_t)));
+	id.write(buffer);
+	buffer.require_available(size);
+	memcpy(buffer.current_pointer(), message.data(), size);
+	buffer.set_position(buffer.get_position() + size);
+	++recording->count;
+	return true;
 }
 }	 // namespace rd
@@ -5,6 +5,9 @@
 #include "base/IWire.h"
 #include "protocol/MessageBroker.h"
 
+#include <atomic>
+#include <mutex>
+
 #include <rd_framework_export.h>
 
 namespace rd
@@ -16,6 +19,31 @@ protected:
 
 	MessageBroker message_broker;
 
+	mutable ProtocolContexts const* contexts = nullptr;
+
+	// lanes of the advised entities which aren't interactive
+	mutable std::mutex priorities_lock;
+	mutable rd::unordered_map<RdId, SendPriority> priorities;
+	mutable std::atomic<size_t> priorities_count{0};
+
+	/**
+	 * \brief Lane of the messages sent to [id], see \ref IRdReactive::send_priority.
+	 */
+	SendPriority get_send_priority(RdId const& id) const;
+
+	/**
+	 * \brief Writes the context header of a message, the values of the contexts current for this thread.
+	 */
+	void write_context(Buffer& buffer) const;
+
+	/**
+	 * \brief Called by [send] implementations first, appends the message to the snapshot being recorded by this
+	 * thread, if any.
+	 * \return true if the message was recorded and mustn't be sent.
+	 */
+	bool record_to_snapshot(RdId const& id, std::function<void(Buffer& buffer)> const& writer,
+		StringEncoding encoding = StringEncoding::Utf16) const;
+
 public:
 	// region ctor/dtor
 	explicit WireBase(IScheduler* scheduler) : scheduler(scheduler), message_broker(scheduler)
@@ -26,6 +54,10 @@ public:
 	// endregion
 
 	virtual void advise(Lifetime lifetime, RdReactiveBase const* entity) const override;
+
+	void setup_contexts(ProtocolContexts const* new_contexts) const override;
+
+	void send_snapshot(std::function<void()> action) const override;
 };
 }	 // namespace rd
 
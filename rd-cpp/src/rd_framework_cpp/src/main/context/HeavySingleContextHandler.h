@@ -0,0 +1,232 @@
+#ifndef RD_CPP_HEAVYSINGLECONTEXTHANDLER_H
+#define RD_CPP_HEAVYSINGLECONTEXTHANDLER_H
+
+#include "context/ISingleContextHandler.h"
+#include "context/ProtocolContexts.h"
+#include "base/RdReactiveBase.h"
+#include "reactive/base/SignalX.h"
+#include "scheduler/SynchronousScheduler.h"
+#include "std/unordered_map.h"
+#include "std/unordered_set.h"
+
+#include <mutex>
+#include <vector>
+
+namespace rd
+{
+/**
+ * \brief Handler of a heavy context, every value is sent to the counterpart once and then referred to by its id.
+ *
+ * The values used by both sides form the value set of the protocol, which backs per-context entities.
+ * Values are never removed from the set.
+ *
+ * Interning goes through messages addressed to the handler, which only the C++ implementation understands. Each side
+ * announces it interns once bound, and values are written inline, in the format every implementation reads, until the
+ * announcement of the counterpart arrives.
+ */
+template <typename T, typename S>
+class HeavySingleContextHandler final : public RdReactiveBase, public ISingleContextHandler
+{
+private:
+	static constexpr int32_t INVALID_ID = -1;
+	// tags of the announcements, in place of the id of an interned value
+	static constexpr int32_t INTERNING_REQUEST = -1;
+	static constexpr int32_t INTERNING_REPLY = -2;
+
+	RdContext<T, S> const& context;
+	ProtocolContexts const& contexts;
+
+	mutable std::recursive_mutex lock;
+	// the counterpart announced it reads interned values, and it's bound as it sent the announcement
+	mutable bool counterpart_interns = false;
+	// ids of the values interned by this side
+	mutable rd::unordered_map<T, int32_t> my_ids;
+	// values interned by the counterpart, indexed by their ids
+	mutable std::vector<T> counterpart_values;
+	mutable std::vector<T> value_set;
+	mutable rd::unordered_set<T> value_set_index;
+	Signal<T> value_added;
+
+	void add_to_value_set(T const& value) const
+	{
+		if (value_set_index.insert(value).second)
+		{
+			value_set.push_back(value);
+			value_added.fire(value);
+		}
+	}
+
+	int32_t intern(T const& value) const
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		auto it = my_ids.find(value);
+		if (it != my_ids.end())
+		{
+			return it->second;
+		}
+		if (!is_bound() || !counterpart_interns)
+		{
+			add_to_value_set(value);
+			return INVALID_ID;
+		}
+
+		const auto id = static_cast<int32_t>(my_ids.size());
+		my_ids.emplace(value, id);
+		add_to_value_set(value);
+		// sent under the lock, so that the counterpart knows the id before any message that refers to it
+		contexts.send_without_contexts([&] {
+			get_wire()->send(rdid, [&](Buffer& buffer) {
+				buffer.write_integral<int32_t>(id);
+				S::write(get_serialization_context(), buffer, value);
+			});
+		});
+		return id;
+	}
+
+	void announce_interning(int32_t tag) const
+	{
+		contexts.send_without_contexts(
+			[&] { get_wire()->send(rdid, [tag](Buffer& buffer) { buffer.write_integral<int32_t>(tag); }); });
+	}
+
+public:
+	// region ctor/dtor
+
+	HeavySingleContextHandler(RdContext<T, S> const& context, ProtocolContexts const& contexts)
+		: context(context), contexts(contexts)
+	{
+		async = true;
+		// interned values are sent before the messages that refer to them
+		send_priority = SendPriority::Control;
+	}
+
+	virtual ~HeavySingleContextHandler() = default;
+	// endregion
+
+	RdContextBase const& get_context() const override
+	{
+		return context;
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return &SynchronousScheduler::Instance();
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		RdReactiveBase::init(lifetime);
+		get_wire()->advise(lifetime, this);
+		// lost if the counterpart isn't bound yet, then its own request arrives once it is
+		announce_interning(INTERNING_REQUEST);
+	}
+
+	void on_wire_received(Buffer buffer) const override
+	{
+		const auto id = buffer.read_integral<int32_t>();
+		if (id < 0)
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			counterpart_interns = true;
+			if (id == INTERNING_REQUEST)
+			{
+				announce_interning(INTERNING_REPLY);
+			}
+			return;
+		}
+		T value = wrapper::get<T>(S::read(get_serialization_context(), buffer));
+
+		std::lock_guard<decltype(lock)> guard(lock);
+		if (counterpart_values.size() <= static_cast<size_t>(id))
+		{
+			counterpart_values.resize(static_cast<size_t>(id) + 1);
+		}
+		counterpart_values[id] = value;
+		add_to_value_set(value);
+	}
+
+	void write_value(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		optional<T> const& value = context.get_value();
+		if (!value)
+		{
+			buffer.write_integral<int32_t>(INVALID_ID);
+			buffer.write_bool(false);
+			return;
+		}
+		const int32_t id = intern(*value);
+		buffer.write_integral<int32_t>(id);
+		if (id == INVALID_ID)
+		{
+			buffer.write_bool(true);
+			S::write(ctx, buffer, *value);
+		}
+	}
+
+	std::unique_ptr<IContextValue> read_value(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		const auto id = buffer.read_integral<int32_t>();
+		if (id == INVALID_ID)
+		{
+			if (!buffer.read_bool())
+			{
+				return context.make_value(nullopt);
+			}
+			T value = wrapper::get<T>(S::read(ctx, buffer));
+			{
+				std::lock_guard<decltype(lock)> guard(lock);
+				add_to_value_set(value);
+			}
+			return context.make_value(std::move(value));
+		}
+
+		std::lock_guard<decltype(lock)> guard(lock);
+		RD_ASSERT_THROW_MSG(id >= 0 && static_cast<size_t>(id) < counterpart_values.size(),
+			"Unknown id " + std::to_string(id) + " of context " + context.key);
+		return context.make_value(counterpart_values[id]);
+	}
+
+	void register_value_in_value_set() const override
+	{
+		optional<T> const& value = context.get_value();
+		if (value)
+		{
+			intern(*value);
+		}
+	}
+
+	bool contains_value(T const& value) const
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return value_set_index.count(value) > 0;
+	}
+
+	/**
+	 * \brief Calls \p handler for every value of the value set, including the values added later.
+	 *
+	 * The handler is called under the lock of the handler, on the thread that added the value.
+	 */
+	void view_values(Lifetime lifetime, std::function<void(T const&)> handler) const
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		// the handler may add values itself
+		for (size_t i = 0; i < value_set.size(); ++i)
+		{
+			const T value = value_set[i];
+			handler(value);
+		}
+		value_added.advise(lifetime, std::move(handler));
+	}
+};
+
+template <typename T, typename S>
+constexpr int32_t HeavySingleContextHandler<T, S>::INVALID_ID;
+
+template <typename T, typename S>
+constexpr int32_t HeavySingleContextHandler<T, S>::INTERNING_REQUEST;
+
+template <typename T, typename S>
+constexpr int32_t HeavySingleContextHandler<T, S>::INTERNING_REPLY;
+}	 // namespace rd
+
+#endif	  // RD_CPP_HEAVYSINGLECONTEXTHANDLER_H
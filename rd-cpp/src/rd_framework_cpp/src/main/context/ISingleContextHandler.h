@@ -0,0 +1,41 @@
+#ifndef RD_CPP_ISINGLECONTEXTHANDLER_H
+#define RD_CPP_ISINGLECONTEXTHANDLER_H
+
+#include "context/RdContext.h"
+#include "protocol/Buffer.h"
+#include "serialization/SerializationCtx.h"
+
+#include <memory>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Writes and reads the values of one context in the headers of wire messages.
+ */
+class RD_FRAMEWORK_API ISingleContextHandler
+{
+public:
+	virtual ~ISingleContextHandler() = default;
+
+	virtual RdContextBase const& get_context() const = 0;
+
+	/**
+	 * \brief Writes the value of the context current for this thread.
+	 */
+	virtual void write_value(SerializationCtx& ctx, Buffer& buffer) const = 0;
+
+	/**
+	 * \brief Reads a value written by #write_value of the counterpart.
+	 */
+	virtual std::unique_ptr<IContextValue> read_value(SerializationCtx& ctx, Buffer& buffer) const = 0;
+
+	/**
+	 * \brief Adds the value current for this thread to the value set of the protocol, does nothing for light contexts.
+	 */
+	virtual void register_value_in_value_set() const = 0;
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_ISINGLECONTEXTHANDLER_H
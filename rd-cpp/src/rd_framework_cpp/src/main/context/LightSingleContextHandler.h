@@ -0,0 +1,56 @@
+#ifndef RD_CPP_LIGHTSINGLECONTEXTHANDLER_H
+#define RD_CPP_LIGHTSINGLECONTEXTHANDLER_H
+
+#include "context/ISingleContextHandler.h"
+
+namespace rd
+{
+/**
+ * \brief Handler of a light context, every message carries the value itself.
+ */
+template <typename T, typename S>
+class LightSingleContextHandler final : public ISingleContextHandler
+{
+	RdContext<T, S> const& context;
+
+public:
+	// region ctor/dtor
+
+	explicit LightSingleContextHandler(RdContext<T, S> const& context) : context(context)
+	{
+	}
+
+	virtual ~LightSingleContextHandler() = default;
+	// endregion
+
+	RdContextBase const& get_context() const override
+	{
+		return context;
+	}
+
+	void write_value(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		optional<T> const& value = context.get_value();
+		buffer.write_bool(static_cast<bool>(value));
+		if (value)
+		{
+			S::write(ctx, buffer, *value);
+		}
+	}
+
+	std::unique_ptr<IContextValue> read_value(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		if (!buffer.read_bool())
+		{
+			return context.make_value(nullopt);
+		}
+		return context.make_value(wrapper::get<T>(S::read(ctx, buffer)));
+	}
+
+	void register_value_in_value_set() const override
+	{
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_LIGHTSINGLECONTEXTHANDLER_H
@@ -0,0 +1,155 @@
+#include "ProtocolContexts.h"
+
+#include "scheduler/SynchronousScheduler.h"
+
+namespace rd
+{
+namespace
+{
+// kept out of the exported class, thread local data can't be a part of a dll interface
+thread_local int32_t without_contexts = 0;
+}	 // namespace
+
+ProtocolContexts::WithoutContextsGuard::WithoutContextsGuard()
+{
+	++without_contexts;
+}
+
+ProtocolContexts::WithoutContextsGuard::~WithoutContextsGuard()
+{
+	--without_contexts;
+}
+
+ProtocolContexts::MessageContext::MessageContext(std::vector<std::unique_ptr<IContextValue>> values) : values(std::move(values))
+{
+}
+
+ProtocolContexts::ProtocolContexts()
+{
+	async = true;
+	// declarations are sent before the messages that carry the declared contexts
+	send_priority = SendPriority::Control;
+}
+
+IScheduler* ProtocolContexts::get_wire_scheduler() const
+{
+	// declarations must be known before the messages that carry the declared contexts are handled
+	return &SynchronousScheduler::Instance();
+}
+
+void ProtocolContexts::init(Lifetime lifetime) const
+{
+	RdReactiveBase::init(lifetime);
+	get_wire()->advise(lifetime, this);
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	for (auto handler : handler_order)
+	{
+		declare_handler(lifetime, *handler);
+	}
+}
+
+void ProtocolContexts::on_wire_received(Buffer buffer) const
+{
+	// written as a polymorphic RdContext with an empty body
+	const RdId type_id = RdId::read(buffer);
+	const auto body_size = buffer.read_integral<int32_t>();
+	buffer.set_position(buffer.get_position() + body_size);
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	counterpart_contexts.push_back(type_id);
+}
+
+void ProtocolContexts::add_handler(RdContextBase const& context, std::unique_ptr<ISingleContextHandler> handler) const
+{
+	ISingleContextHandler const& added = *handler;
+	handlers.emplace(context.get_type_id(), std::move(handler));
+	handler_order.push_back(&added);
+	if (is_bound())
+	{
+		declare_handler(*bind_lifetime, added);
+	}
+}
+
+void ProtocolContexts::declare_handler(Lifetime lifetime, ISingleContextHandler const& handler) const
+{
+	RdContextBase const& context = handler.get_context();
+	send_without_contexts([&] {
+		if (auto bindable = dynamic_cast<IRdBindable const*>(&handler))
+		{
+			bindable->set_id(rdid.mix(context.key));
+			bindable->bind(lifetime, this, context.key);
+		}
+		get_wire()->send(rdid, [&context](Buffer& buffer) {
+			context.get_type_id().write(buffer);
+			buffer.write_integral<int32_t>(0);
+		});
+	});
+
+	// the handler starts writing values only after the counterpart knows about it
+	handlers_to_write.push_back(&handler);
+	handlers_to_write_count = handlers_to_write.size();
+}
+
+ISingleContextHandler const* ProtocolContexts::find_handler(RdId const& type_id) const
+{
+	auto it = handlers.find(type_id);
+	return it == handlers.end() ? nullptr : it->second.get();
+}
+
+ISingleContextHandler const& ProtocolContexts::get_context_handler(RdContextBase const& context) const
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	ISingleContextHandler const* handler = find_handler(context.get_type_id());
+	RD_ASSERT_THROW_MSG(handler != nullptr, "Context " + context.key + " isn't registered");
+	return *handler;
+}
+
+bool ProtocolContexts::is_send_without_contexts() const
+{
+	return without_contexts > 0;
+}
+
+void ProtocolContexts::write_current_message_context(Buffer& buffer) const
+{
+	if (is_send_without_contexts() || handlers_to_write_count == 0)
+	{
+		write_empty_contexts(buffer);
+		return;
+	}
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	buffer.write_integral<int16_t>(static_cast<int16_t>(handlers_to_write.size()));
+	for (auto handler : handlers_to_write)
+	{
+		handler->write_value(get_serialization_context(), buffer);
+	}
+}
+
+ProtocolContexts::MessageContext ProtocolContexts::read_context(Buffer& buffer) const
+{
+	const auto count = static_cast<size_t>(buffer.read_integral<int16_t>());
+	if (count == 0)
+	{
+		return MessageContext();
+	}
+
+	std::lock_guard<decltype(lock)> guard(lock);
+	RD_ASSERT_THROW_MSG(count <= counterpart_contexts.size(), "We know of " + std::to_string(counterpart_contexts.size()) +
+																 " remote contexts, received " + std::to_string(count));
+	std::vector<std::unique_ptr<IContextValue>> values;
+	values.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		ISingleContextHandler const* handler = find_handler(counterpart_contexts[i]);
+		RD_ASSERT_THROW_MSG(handler != nullptr, "Context " + to_string(counterpart_contexts[i]) + " isn't registered");
+		values.push_back(handler->read_value(get_serialization_context(), buffer));
+	}
+	return MessageContext(std::move(values));
+}
+
+void ProtocolContexts::write_empty_contexts(Buffer& buffer)
+{
+	buffer.write_integral<int16_t>(0);
+}
+}	 // namespace rd
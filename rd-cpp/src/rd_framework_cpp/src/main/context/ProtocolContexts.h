@@ -0,0 +1,203 @@
+#ifndef RD_CPP_PROTOCOLCONTEXTS_H
+#define RD_CPP_PROTOCOLCONTEXTS_H
+
+#include "context/ISingleContextHandler.h"
+#include "base/RdReactiveBase.h"
+#include "std/unordered_map.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+// region predeclared
+
+template <typename T, typename S>
+class LightSingleContextHandler;
+
+template <typename T, typename S>
+class HeavySingleContextHandler;
+// endregion
+
+/**
+ * \brief Tracks the contexts of a protocol and writes and reads their values in the headers of wire messages.
+ *
+ * The header is the number of contexts followed by their values, in the order the contexts were declared to the
+ * counterpart. A context is declared when it's registered in a bound protocol, its values are written from then on.
+ */
+class RD_FRAMEWORK_API ProtocolContexts final : public RdReactiveBase
+{
+private:
+	mutable std::recursive_mutex lock;
+	mutable rd::unordered_map<RdId, std::unique_ptr<ISingleContextHandler>> handlers;
+	// registration order
+	mutable std::vector<ISingleContextHandler const*> handler_order;
+	// handlers declared to the counterpart, the header of every message contains their values
+	mutable std::vector<ISingleContextHandler const*> handlers_to_write;
+	mutable std::atomic<size_t> handlers_to_write_count{0};
+	// type ids of the contexts in the order the counterpart declared them
+	mutable std::vector<RdId> counterpart_contexts;
+
+	void add_handler(RdContextBase const& context, std::unique_ptr<ISingleContextHandler> handler) const;
+
+	void declare_handler(Lifetime lifetime, ISingleContextHandler const& handler) const;
+
+	ISingleContextHandler const* find_handler(RdId const& type_id) const;
+
+public:
+	/**
+	 * \brief Values of the contexts read from a message header.
+	 */
+	class RD_FRAMEWORK_API MessageContext
+	{
+		std::vector<std::unique_ptr<IContextValue>> values;
+
+	public:
+		// region ctor/dtor
+
+		MessageContext() = default;
+
+		explicit MessageContext(std::vector<std::unique_ptr<IContextValue>> values);
+
+		MessageContext(MessageContext&&) = default;
+
+		MessageContext& operator=(MessageContext&&) = default;
+		// endregion
+
+		/**
+		 * \brief Runs \p action with the values current for this thread.
+		 */
+		template <typename F>
+		void update(F&& action)
+		{
+			if (values.empty())
+			{
+				action();
+				return;
+			}
+
+			struct leave_guard
+			{
+				std::vector<std::unique_ptr<IContextValue>>& values;
+
+				~leave_guard()
+				{
+					for (auto it = values.rbegin(); it != values.rend(); ++it)
+					{
+						(*it)->leave();
+					}
+				}
+			};
+
+			for (auto& value : values)
+			{
+				value->enter();
+			}
+			leave_guard guard{values};
+			action();
+		}
+	};
+
+	// region ctor/dtor
+
+	ProtocolContexts();
+
+	virtual ~ProtocolContexts() = default;
+	// endregion
+
+	IScheduler* get_wire_scheduler() const override;
+
+	void init(Lifetime lifetime) const override;
+
+	void on_wire_received(Buffer buffer) const override;
+
+	/**
+	 * \brief Registers a context to be used with this protocol. Must be called on the scheduler of the protocol,
+	 * both sides have to register the context before it gets a value.
+	 */
+	template <typename T, typename S>
+	void register_context(RdContext<T, S> const& context) const
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		if (find_handler(context.get_type_id()) != nullptr)
+		{
+			return;
+		}
+		if (context.heavy)
+		{
+			add_handler(context, std::make_unique<HeavySingleContextHandler<T, S>>(context, *this));
+		}
+		else
+		{
+			add_handler(context, std::make_unique<LightSingleContextHandler<T, S>>(context));
+		}
+	}
+
+	/**
+	 * \brief Handler of a registered context.
+	 */
+	ISingleContextHandler const& get_context_handler(RdContextBase const& context) const;
+
+	/**
+	 * \brief Handler of a registered heavy context, which gives access to the value set of the context.
+	 */
+	template <typename T, typename S>
+	HeavySingleContextHandler<T, S> const& get_value_set(RdContext<T, S> const& context) const
+	{
+		RD_ASSERT_MSG(context.heavy, "Only heavy contexts have value sets, " + context.key + " is not heavy");
+		return static_cast<HeavySingleContextHandler<T, S> const&>(get_context_handler(context));
+	}
+
+	bool is_send_without_contexts() const;
+
+	/**
+	 * \brief Messages sent from this thread carry no context values while the guard is alive.
+	 */
+	class RD_FRAMEWORK_API WithoutContextsGuard
+	{
+	public:
+		// region ctor/dtor
+
+		WithoutContextsGuard();
+
+		WithoutContextsGuard(WithoutContextsGuard const&) = delete;
+
+		WithoutContextsGuard& operator=(WithoutContextsGuard const&) = delete;
+
+		~WithoutContextsGuard();
+		// endregion
+	};
+
+	/**
+	 * \brief Runs \p action, messages it sends carry no context values.
+	 */
+	template <typename F>
+	auto send_without_contexts(F&& action) const -> typename util::result_of_t<F()>
+	{
+		WithoutContextsGuard guard;
+		return action();
+	}
+
+	/**
+	 * \brief Writes the values of the contexts current for this thread.
+	 */
+	void write_current_message_context(Buffer& buffer) const;
+
+	MessageContext read_context(Buffer& buffer) const;
+
+	static void write_empty_contexts(Buffer& buffer);
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#include "context/LightSingleContextHandler.h"
+#include "context/HeavySingleContextHandler.h"
+
+#endif	  // RD_CPP_PROTOCOLCONTEXTS_H
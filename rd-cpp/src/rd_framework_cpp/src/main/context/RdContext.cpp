@@ -0,0 +1,26 @@
+#include "RdContext.h"
+
+#include "std/unordered_map.h"
+
+#include <mutex>
+
+namespace rd
+{
+RdContextBase::RdContextBase(std::string key, bool heavy) : slot(slot_of(key)), key(std::move(key)), heavy(heavy)
+{
+}
+
+size_t RdContextBase::slot_of(std::string const& key)
+{
+	static std::mutex lock;
+	static rd::unordered_map<std::string, size_t> slots;
+
+	std::lock_guard<std::mutex> guard(lock);
+	return slots.emplace(key, slots.size()).first->second;
+}
+
+RdId RdContextBase::get_type_id() const
+{
+	return RdId(util::getPlatformIndependentHash("RdContext-" + key));
+}
+}	 // namespace rd
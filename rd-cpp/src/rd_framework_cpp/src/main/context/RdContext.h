@@ -0,0 +1,220 @@
+#ifndef RD_CPP_RDCONTEXT_H
+#define RD_CPP_RDCONTEXT_H
+
+#include "protocol/RdId.h"
+#include "serialization/Polymorphic.h"
+
+#include "thirdparty.hpp"
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Context value received with a message, current for the thread that handles the message.
+ */
+class RD_FRAMEWORK_API IContextValue
+{
+public:
+	virtual ~IContextValue() = default;
+
+	/**
+	 * \brief Makes the value current for this thread.
+	 */
+	virtual void enter() = 0;
+
+	/**
+	 * \brief Restores the value that was current before #enter.
+	 */
+	virtual void leave() = 0;
+};
+
+/**
+ * \brief Untyped part of \ref RdContext.
+ */
+class RD_FRAMEWORK_API RdContextBase
+{
+private:
+	size_t slot;
+
+	static size_t slot_of(std::string const& key);
+
+protected:
+	size_t get_slot() const
+	{
+		return slot;
+	}
+
+public:
+	/**
+	 * \brief Textual name of the context, used to match it with the counterpart.
+	 */
+	const std::string key;
+
+	/**
+	 * \brief Heavy contexts intern their values and maintain the set of values used by the protocol,
+	 * light contexts send values as is.
+	 */
+	const bool heavy;
+
+	// region ctor/dtor
+
+	RdContextBase(std::string key, bool heavy);
+
+	RdContextBase(RdContextBase const&) = delete;
+
+	RdContextBase& operator=(RdContextBase const&) = delete;
+
+	virtual ~RdContextBase() = default;
+	// endregion
+
+	/**
+	 * \brief Id this context is declared with to the counterpart, the same as the type id of RdContext in other rd
+	 * implementations.
+	 */
+	RdId get_type_id() const;
+};
+
+/**
+ * \brief Describes a context and provides access to its value.
+ *
+ * The value is thread-local and travels with the wire messages: handlers of a message see the value that was current
+ * on the thread that sent it. Contexts with the same key share the value. A context has to be registered in
+ * \ref ProtocolContexts of both sides before it is used, and has to outlive the protocols it's registered in.
+ *
+ * \tparam T type of the value
+ * \tparam S "SerDes" for the value
+ */
+template <typename T, typename S = Polymorphic<T>>
+class RdContext : public RdContextBase
+{
+private:
+	static std::deque<optional<T>>& values()
+	{
+		// a deque doesn't move its elements on growth, so references returned by get_value stay valid
+		static thread_local std::deque<optional<T>> values;
+		return values;
+	}
+
+	optional<T>& current() const
+	{
+		auto& all = values();
+		if (all.size() <= get_slot())
+		{
+			all.resize(get_slot() + 1);
+		}
+		return all[get_slot()];
+	}
+
+	class Value final : public IContextValue
+	{
+		RdContext const& context;
+		optional<T> value;
+
+	public:
+		Value(RdContext const& context, optional<T> value) : context(context), value(std::move(value))
+		{
+		}
+
+		void enter() override
+		{
+			std::swap(context.current(), value);
+		}
+
+		void leave() override
+		{
+			std::swap(context.current(), value);
+		}
+	};
+
+public:
+	using value_type = T;
+	using serializer = S;
+
+	/**
+	 * \brief Restores the previous value of the context on destruction.
+	 */
+	class Cookie
+	{
+		RdContext const* context;
+		optional<T> old_value;
+
+	public:
+		// region ctor/dtor
+
+		Cookie(RdContext const* context, optional<T> old_value) : context(context), old_value(std::move(old_value))
+		{
+		}
+
+		Cookie(Cookie const&) = delete;
+
+		Cookie(Cookie&& other) noexcept : context(other.context), old_value(std::move(other.old_value))
+		{
+			other.context = nullptr;
+		}
+
+		~Cookie()
+		{
+			if (context)
+			{
+				context->current() = std::move(old_value);
+			}
+		}
+		// endregion
+	};
+
+	// region ctor/dtor
+
+	RdContext(std::string key, bool heavy) : RdContextBase(std::move(key), heavy)
+	{
+	}
+
+	virtual ~RdContext() = default;
+	// endregion
+
+	/**
+	 * \brief The value of the context for this thread.
+	 */
+	optional<T> const& get_value() const
+	{
+		return current();
+	}
+
+	/**
+	 * \brief The value used as a key by per-context entities like \ref RdPerContextMap.
+	 */
+	virtual optional<T> const& get_value_for_per_context_entity() const
+	{
+		return get_value();
+	}
+
+	/**
+	 * \brief Changes the value of the context for this thread until the returned cookie is destroyed.
+	 */
+	Cookie update_value(optional<T> new_value) const
+	{
+		optional<T>& value = current();
+		Cookie cookie(this, std::move(value));
+		value = std::move(new_value);
+		return cookie;
+	}
+
+	/**
+	 * \brief Wraps a value received from the wire, so that it can be made current for the thread of the handler.
+	 */
+	std::unique_ptr<IContextValue> make_value(optional<T> value) const
+	{
+		return std::make_unique<Value>(*this, std::move(value));
+	}
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_RDCONTEXT_H
@@ -2,6 +2,8 @@
 
 #include "protocol/Buffer.h"
 
+#include <algorithm>
+
 namespace rd
 {
 ExtWire::ExtWire()
@@ -17,11 +19,10 @@ ExtWire::ExtWire()
 					{
 						return;
 					}
-					// auto[id, payload] = std::move(sendQ.front());
 					auto it = std::move(sendQ.front());
-					sendQ.pop();
+					sendQ.pop_front();
 					realWire->send(
-						it.first, [payload = std::move(it.second)](Buffer& buffer) { buffer.write_byte_array_raw(payload); });
+						it.id, [payload = std::move(it.payload)](Buffer& buffer) { buffer.write_byte_array_raw(payload); });
 				}
 			}
 		}
@@ -39,12 +40,53 @@ void ExtWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) c
 		std::lock_guard<decltype(lock)> guard(lock);
 		if (!sendQ.empty() || !connected.get())
 		{
-			Buffer buffer;
-			writer(buffer);
-			sendQ.emplace(id, buffer.getRealArray());
+			enqueue(id, writer, {});
 			return;
 		}
 	}
 	realWire->send(id, std::move(writer));
 }
+
+void ExtWire::send_latest(RdId const& id, std::string const& key, std::function<void(Buffer& buffer)> writer) const
+{
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		if (!sendQ.empty() || !connected.get())
+		{
+			const RdId::hash_t hash = id.get_hash();
+			std::string coalescing_key(reinterpret_cast<char const*>(&hash), sizeof(hash));
+			coalescing_key += key;
+			enqueue(id, writer, std::move(coalescing_key));
+			return;
+		}
+	}
+	realWire->send_latest(id, key, std::move(writer));
+}
+
+void ExtWire::enqueue(RdId const& id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const
+{
+	Buffer buffer;
+	writer(buffer);
+	if (!coalescing_key.empty())
+	{
+		auto it = std::find_if(
+			sendQ.begin(), sendQ.end(), [&](Message const& message) { return message.coalescing_key == coalescing_key; });
+		if (it != sendQ.end())
+		{
+			sendQ.erase(it);
+		}
+	}
+	sendQ.push_back(Message{id, buffer.getRealArray(), std::move(coalescing_key)});
+}
+
+void ExtWire::send_snapshot(std::function<void()> action) const
+{
+	if (realWire == nullptr)
+	{
+		action();
+		return;
+	}
+	// messages queued until the connection are sent one by one
+	realWire->send_snapshot(std::move(action));
+}
 }	 // namespace rd
@@ -5,8 +5,9 @@
 #include "protocol/RdId.h"
 #include "protocol/Buffer.h"
 
-#include <queue>
+#include <deque>
 #include <mutex>
+#include <string>
 #include <functional>
 
 #include <rd_framework_export.h>
@@ -19,7 +20,17 @@ class RD_FRAMEWORK_API ExtWire final : public IWire
 {
 	mutable std::mutex lock;
 
-	mutable std::queue<std::pair<RdId, Buffer::ByteArray> > sendQ;
+	struct Message
+	{
+		RdId id;
+		Buffer::ByteArray payload;
+		// empty unless the message was sent by send_latest, see SocketWire::Base::send_latest
+		std::string coalescing_key;
+	};
+
+	mutable std::deque<Message> sendQ;
+
+	void enqueue(RdId const& id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const;
 
 public:
 	ExtWire();
@@ -29,6 +40,14 @@ public:
 	void advise(Lifetime lifetime, RdReactiveBase const* entity) const override;
 
 	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
+
+	/**
+	 * \brief Forwarded to the real wire once connected, until then a queued message with the same id and key is
+	 * replaced.
+	 */
+	void send_latest(RdId const& id, std::string const& key, std::function<void(Buffer& buffer)> writer) const override;
+
+	void send_snapshot(std::function<void()> action) const override;
 };
 }	 // namespace rd
 
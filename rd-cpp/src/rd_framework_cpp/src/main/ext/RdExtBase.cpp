@@ -26,8 +26,8 @@ void RdExtBase::init(Lifetime lifetime) const
 	extWire->realWire = parentWire.get();
 	lifetime->bracket(
 		[&] {
-			extProtocol =
-				std::make_shared<Protocol>(parentProtocol->identity, sc, std::static_pointer_cast<IWire>(extWire), lifetime);
+			extProtocol = std::make_shared<Protocol>(
+				parentProtocol->identity, sc, std::static_pointer_cast<IWire>(extWire), lifetime, parentProtocol->contexts);
 		},
 		[this] { extProtocol = nullptr; });
 
@@ -0,0 +1,149 @@
+#ifndef RD_CPP_ASYNCRDMAP_H
+#define RD_CPP_ASYNCRDMAP_H
+
+#include "impl/RdMap.h"
+#include "scheduler/SynchronousScheduler.h"
+
+#include <mutex>
+
+namespace rd
+{
+/**
+ * \brief Thread-agnostic version of \ref RdMap.
+ *
+ * May be read and modified from any thread, also before it's bound. Local changes are sent to the wire right away on the
+ * thread that made them, messages from the wire are applied on the thread that receives them. Both happen under the
+ * same lock, so the other side sees the changes in the order they were made. Handlers are called synchronously
+ * under the lock on the thread that made the change. Values are not bound, so they mustn't be bindable entities.
+ *
+ * Pointers returned by #get and #set stay valid only while nobody else modifies the map, use #with_lock to
+ * iterate the map or to read values that other threads may change.
+ *
+ * \tparam K type of stored keys
+ * \tparam V type of stored values
+ * \tparam KS "SerDes" for keys
+ * \tparam VS "SerDes" for values
+ */
+template <typename K, typename V, typename KS = Polymorphic<K>, typename VS = Polymorphic<V>, typename KA = std::allocator<K>,
+	typename VA = std::allocator<V>>
+class AsyncRdMap final : public RdMap<K, V, KS, VS, KA, VA>
+{
+private:
+	using base = RdMap<K, V, KS, VS, KA, VA>;
+	using WK = typename IViewableMap<K, V>::WK;
+	using WV = typename IViewableMap<K, V>::WV;
+	using OV = typename IViewableMap<K, V>::OV;
+
+	mutable std::recursive_mutex lock;
+
+public:
+	using Event = typename base::Event;
+
+	// region ctor/dtor
+
+	AsyncRdMap()
+	{
+		this->async = true;
+		this->optimize_nested = true;
+	}
+
+	AsyncRdMap(AsyncRdMap&& other) : base(std::move(other))
+	{
+	}
+
+	AsyncRdMap& operator=(AsyncRdMap&& other)
+	{
+		static_cast<base&>(*this) = std::move(other);
+		return *this;
+	}
+
+	virtual ~AsyncRdMap() = default;
+	// endregion
+
+	static AsyncRdMap read(SerializationCtx& /*ctx*/, Buffer& buffer)
+	{
+		AsyncRdMap res;
+		RdId id = RdId::read(buffer);
+		withId(res, id);
+		return res;
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return &SynchronousScheduler::Instance();
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::init(lifetime);
+	}
+
+	void on_wire_received(Buffer buffer) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::on_wire_received(std::move(buffer));
+	}
+
+	/**
+	 * \brief Runs \p action under the lock of the map, no other thread modifies the map meanwhile.
+	 */
+	template <typename F>
+	auto with_lock(F&& action) const -> typename util::result_of_t<F()>
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return action();
+	}
+
+	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::advise(lifetime, std::move(handler));
+	}
+
+	V const* get(K const& key) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::get(key);
+	}
+
+	V const* set(WK key, WV value) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::set(std::move(key), std::move(value));
+	}
+
+	OV remove(K const& key) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::remove(key);
+	}
+
+	void clear() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::clear();
+	}
+
+	size_t size() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::size();
+	}
+
+	bool empty() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::empty();
+	}
+
+	friend std::string to_string(AsyncRdMap const& value)
+	{
+		return value.with_lock([&] { return to_string(static_cast<base const&>(value)); });
+	}
+};
+}	 // namespace rd
+
+static_assert(std::is_move_constructible<rd::AsyncRdMap<int, int>>::value, "Is move constructible AsyncRdMap<int, int>");
+
+#endif	  // RD_CPP_ASYNCRDMAP_H
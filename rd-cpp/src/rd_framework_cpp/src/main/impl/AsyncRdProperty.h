@@ -0,0 +1,131 @@
+#ifndef RD_CPP_ASYNCRDPROPERTY_H
+#define RD_CPP_ASYNCRDPROPERTY_H
+
+#include "impl/RdProperty.h"
+#include "scheduler/SynchronousScheduler.h"
+
+#include <mutex>
+
+namespace rd
+{
+/**
+ * \brief Thread-agnostic version of \ref RdProperty.
+ *
+ * Follows the rules of \ref AsyncRdMap: may be set from any thread, the value goes to the wire right away under the lock
+ * of the property, handlers are called under the lock on the thread that set the value. The reference returned by #get
+ * may be invalidated by a concurrent #set, use #with_lock to read the value.
+ *
+ * \tparam T type of stored value
+ * \tparam S "SerDes" for value
+ */
+template <typename T, typename S = Polymorphic<T>, typename A = allocator<T>>
+class AsyncRdProperty final : public RdProperty<T, S, A>
+{
+private:
+	using base = RdProperty<T, S, A>;
+
+	mutable std::recursive_mutex lock;
+
+public:
+	// region ctor/dtor
+
+	AsyncRdProperty()
+	{
+		this->async = true;
+		this->optimize_nested = true;
+	}
+
+	template <typename F>
+	explicit AsyncRdProperty(F&& value) : base(std::forward<F>(value))
+	{
+		this->async = true;
+		this->optimize_nested = true;
+	}
+
+	AsyncRdProperty(AsyncRdProperty&& other) : base(std::move(other))
+	{
+	}
+
+	AsyncRdProperty& operator=(AsyncRdProperty&& other)
+	{
+		static_cast<base&>(*this) = std::move(other);
+		return *this;
+	}
+
+	virtual ~AsyncRdProperty() = default;
+	// endregion
+
+	static AsyncRdProperty read(SerializationCtx& ctx, Buffer& buffer)
+	{
+		RdId id = RdId::read(buffer);
+		AsyncRdProperty property;
+		withId(property, id);
+		const bool has_value = buffer.read_bool();
+		if (has_value)
+		{
+			property.value = S::read(ctx, buffer);
+		}
+		return property;
+	}
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::write(ctx, buffer);
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return &SynchronousScheduler::Instance();
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::init(lifetime);
+	}
+
+	void on_wire_received(Buffer buffer) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::on_wire_received(std::move(buffer));
+	}
+
+	/**
+	 * \brief Runs \p action under the lock of the property, no other thread changes the value meanwhile.
+	 */
+	template <typename F>
+	auto with_lock(F&& action) const -> typename util::result_of_t<F()>
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return action();
+	}
+
+	T const& get() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::get();
+	}
+
+	void set(value_or_wrapper<T> new_value) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::set(std::move(new_value));
+	}
+
+	void advise(Lifetime lifetime, std::function<void(T const&)> handler) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::advise(lifetime, std::move(handler));
+	}
+
+	friend std::string to_string(AsyncRdProperty const& value)
+	{
+		return value.with_lock([&] { return to_string(static_cast<base const&>(value)); });
+	}
+};
+}	 // namespace rd
+
+static_assert(std::is_move_constructible<rd::AsyncRdProperty<int>>::value, "Is move constructible AsyncRdProperty<int>");
+
+#endif	  // RD_CPP_ASYNCRDPROPERTY_H
@@ -0,0 +1,149 @@
+#ifndef RD_CPP_ASYNCRDSET_H
+#define RD_CPP_ASYNCRDSET_H
+
+#include "impl/RdSet.h"
+#include "scheduler/SynchronousScheduler.h"
+
+#include <mutex>
+
+namespace rd
+{
+/**
+ * \brief Thread-agnostic version of \ref RdSet.
+ *
+ * Follows the rules of \ref AsyncRdMap: may be used from any thread, changes go to the wire right away under the lock
+ * of the set, handlers are called under the lock on the thread that made the change. Use #with_lock to iterate.
+ *
+ * \tparam T type of stored values
+ * \tparam S "SerDes" for values
+ */
+template <typename T, typename S = Polymorphic<T>, typename A = allocator<T>>
+class AsyncRdSet final : public RdSet<T, S, A>
+{
+private:
+	using base = RdSet<T, S, A>;
+	using WT = typename IViewableSet<T>::WT;
+	using set = typename base::set;
+
+	mutable std::recursive_mutex lock;
+
+public:
+	using Event = typename base::Event;
+
+	// region ctor/dtor
+
+	AsyncRdSet()
+	{
+		this->async = true;
+	}
+
+	AsyncRdSet(AsyncRdSet&& other) : base(std::move(other))
+	{
+	}
+
+	AsyncRdSet& operator=(AsyncRdSet&& other)
+	{
+		static_cast<base&>(*this) = std::move(other);
+		return *this;
+	}
+
+	virtual ~AsyncRdSet() = default;
+	// endregion
+
+	static AsyncRdSet read(SerializationCtx& /*ctx*/, Buffer& buffer)
+	{
+		AsyncRdSet result;
+		RdId id = RdId::read(buffer);
+		withId(result, std::move(id));
+		return result;
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return &SynchronousScheduler::Instance();
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::init(lifetime);
+	}
+
+	void on_wire_received(Buffer buffer) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::on_wire_received(std::move(buffer));
+	}
+
+	/**
+	 * \brief Runs \p action under the lock of the set, no other thread modifies the set meanwhile.
+	 */
+	template <typename F>
+	auto with_lock(F&& action) const -> typename util::result_of_t<F()>
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return action();
+	}
+
+	bool add(WT value) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::add(std::move(value));
+	}
+
+	bool addAll(std::vector<WT> elements) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::addAll(std::move(elements));
+	}
+
+	void clear() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::clear();
+	}
+
+	bool remove(T const& value) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return base::remove(value);
+	}
+
+	// reads bypass local_change, so that handlers may query the set they're notified by
+
+	size_t size() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return set::size();
+	}
+
+	bool contains(T const& value) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return set::contains(value);
+	}
+
+	bool empty() const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		return set::empty();
+	}
+
+	void advise(Lifetime lifetime, std::function<void(Event const&)> handler) const override
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		base::advise(lifetime, std::move(handler));
+	}
+
+	using IViewableSet<T>::advise;
+
+	friend std::string to_string(AsyncRdSet const& value)
+	{
+		return value.with_lock([&] { return to_string(static_cast<base const&>(value)); });
+	}
+};
+}	 // namespace rd
+
+static_assert(std::is_move_constructible<rd::AsyncRdSet<int>>::value, "Is move constructible AsyncRdSet<int>");
+
+#endif	  // RD_CPP_ASYNCRDSET_H
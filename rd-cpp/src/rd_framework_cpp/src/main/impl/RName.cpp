@@ -2,8 +2,37 @@
 
 #include "thirdparty.hpp"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
 namespace rd
 {
+namespace
+{
+/**
+ * \brief Separators are few and shared by all the names, they are kept once for the lifetime of the process.
+ */
+string_view intern_separator(string_view separator)
+{
+	static const string_view known[] = {".", "::", ""};
+	for (auto const& it : known)
+	{
+		if (it == separator)
+		{
+			return it;
+		}
+	}
+
+	static std::mutex lock;
+	// node based, so the strings never move
+	static std::unordered_set<std::string> interned;
+	std::lock_guard<std::mutex> guard(lock);
+	return *interned.emplace(separator.data(), separator.size()).first;
+}
+}	 // namespace
+
 class RNameImpl
 {
 public:
@@ -14,18 +43,55 @@ public:
 	RNameImpl(RName&& other) noexcept = delete;
 	RNameImpl& operator=(const RNameImpl& other) = delete;
 	RNameImpl& operator=(RNameImpl&& other) noexcept = delete;
+
+	~RNameImpl();
 	// endregion
 
-	friend std::string to_string(RNameImpl const& value);
+	std::string const& render() const;
 
 private:
 	RName parent;
-	std::string local_name, separator;
+	std::string local_name;
+	string_view separator;
+
+	// the whole path, built on the first request, names are mostly rendered for logging only
+	mutable std::atomic<std::string const*> rendered{nullptr};
 };
 
 RNameImpl::RNameImpl(RName parent, string_view localName, string_view separator)
-	: parent(parent), local_name(localName), separator(separator)
+	: parent(std::move(parent)), local_name(localName), separator(intern_separator(separator))
+{
+}
+
+RNameImpl::~RNameImpl()
+{
+	delete rendered.load(std::memory_order_relaxed);
+}
+
+std::string const& RNameImpl::render() const
 {
+	if (!parent)
+	{
+		return local_name;
+	}
+	std::string const* res = rendered.load(std::memory_order_acquire);
+	if (res != nullptr)
+	{
+		return *res;
+	}
+
+	std::string const& prefix = parent.impl->render();
+	auto path = std::make_unique<std::string>();
+	path->reserve(prefix.size() + separator.size() + local_name.size());
+	*path += prefix;
+	path->append(separator.data(), separator.size());
+	*path += local_name;
+	// a concurrent render may have won, its result is the same
+	if (rendered.compare_exchange_strong(res, path.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+	{
+		return *path.release();
+	}
+	return *res;
 }
 
 RName::RName(RName parent, string_view localName, string_view separator)
@@ -40,25 +106,11 @@ RName RName::sub(string_view localName, string_view separator) const
 
 std::string to_string(RName const& value)
 {
-	std::string res;
 	if (value.impl)
 	{
-		res = to_string(*value.impl);
-	}
-	return res;
-}
-
-std::string to_string(RNameImpl const& value)
-{
-	if (value.parent)
-	{
-		std::string res;
-		res = to_string(value.parent);
-		res += value.separator;
-		res += value.local_name;
-		return res;
+		return value.impl->render();
 	}
-	return value.local_name;
+	return {};
 }
 
 RName::RName(string_view local_name) : RName(RName(), local_name, "")
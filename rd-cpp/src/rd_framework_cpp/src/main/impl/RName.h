@@ -14,6 +14,9 @@ class RNameImpl;
 
 /**
  * \brief Recursive name. For constructs like Aaaa.Bbb::CCC
+ *
+ * A name refers to its parent and keeps only its own part, the whole path is built on the first \ref to_string and
+ * reused afterwards.
  */
 class RD_FRAMEWORK_API RName
 {
@@ -45,6 +48,8 @@ public:
 	friend std::string RD_FRAMEWORK_API to_string(RName const& value);
 
 private:
+	friend class RNameImpl;
+
 	std::shared_ptr<RNameImpl> impl;
 };
 }	 // namespace rd
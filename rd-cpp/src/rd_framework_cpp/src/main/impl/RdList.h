@@ -22,7 +22,7 @@ private:
 	using WT = typename IViewableList<T>::WT;
 
 	//		mutable ViewableList<T> list;
-	using list = ViewableList<T>;
+	using list = ViewableList<T, A>;
 	mutable int64_t next_version = 1;
 
 	std::string logmsg(Op op, int64_t version, int32_t key, T const* value = nullptr) const
@@ -40,6 +40,10 @@ public:
 
 	RdList() = default;
 
+	explicit RdList(A const& alloc) : list(alloc)
+	{
+	}
+
 	RdList(RdList&&) = default;
 
 	RdList& operator=(RdList&&) = default;
@@ -99,7 +103,11 @@ public:
 					{
 						S::write(this->get_serialization_context(), buffer, *new_value);
 					}
-					spdlog::get("logSend")->trace(logmsg(op, next_version - 1, e.get_index(), new_value));
+					auto logger = spdlog::get("logSend");
+					if (logger->should_log(spdlog::level::trace))
+					{
+						logger->trace(logmsg(op, next_version - 1, e.get_index(), new_value));
+					}
 				});
 			});
 		});
@@ -133,7 +141,11 @@ public:
 			{
 				auto value = S::read(this->get_serialization_context(), buffer);
 
-				spdlog::get("logReceived")->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				}
 
 				(index < 0) ? list::add(std::move(value)) : list::add(static_cast<size_t>(index), std::move(value));
 				break;
@@ -142,14 +154,22 @@ public:
 			{
 				auto value = S::read(this->get_serialization_context(), buffer);
 
-				spdlog::get("logReceived")->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace(logmsg(op, version, index, &(wrapper::get<T>(value))));
+				}
 
 				list::set(static_cast<size_t>(index), std::move(value));
 				break;
 			}
 			case Op::REMOVE:
 			{
-				spdlog::get("logReceived")->trace(logmsg(op, version, index));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace(logmsg(op, version, index));
+				}
 
 				list::removeAt(static_cast<size_t>(index));
 				break;
@@ -22,14 +22,14 @@ namespace rd
  */
 template <typename K, typename V, typename KS = Polymorphic<K>, typename VS = Polymorphic<V>, typename KA = std::allocator<K>,
 	typename VA = std::allocator<V>>
-class RdMap final : public RdReactiveBase, public ViewableMap<K, V, KA, VA>, public ISerializable
+class RdMap : public RdReactiveBase, public ViewableMap<K, V, KA, VA>, public ISerializable
 {
 private:
 	using WK = typename IViewableMap<K, V>::WK;
 	using WV = typename IViewableMap<K, V>::WV;
 	using OV = typename IViewableMap<K, V>::OV;
 
-	using map = ViewableMap<K, V>;
+	using map = ViewableMap<K, V, KA, VA>;
 	mutable int64_t next_version = 0;
 	mutable ordered_map<K const*, int64_t, wrapper::TransparentHash<K>, wrapper::TransparentKeyEqual<K>> pendingForAck;
 
@@ -50,6 +50,12 @@ public:
 
 	bool optimize_nested = false;
 
+	/**
+	 * \brief Whether the entries the map holds when it's bound are sent to the counterpart. Cleared for maps both sides
+	 * restored from the same checkpoint (see \ref CheckpointSync), their values must not be bindable then.
+	 */
+	bool initial_sync = true;
+
 	using Event = typename IViewableMap<K, V>::Event;
 
 	using key_type = K;
@@ -59,6 +65,10 @@ public:
 
 	RdMap() = default;
 
+	explicit RdMap(VA const& alloc) : map(alloc)
+	{
+	}
+
 	RdMap(RdMap&&) = default;
 
 	RdMap& operator=(RdMap&&) = default;
@@ -85,7 +95,7 @@ public:
 	{
 		RdBindableBase::init(lifetime);
 
-		local_change([this, lifetime]() {
+		auto send_changes = [this, lifetime]() {
 			advise(lifetime, [this, lifetime](Event e) {
 				if (!is_local_change)
 					return;
@@ -98,7 +108,7 @@ public:
 					identifyPolymorphic(*new_value, *identity, identity->next(rdid));
 				}
 
-				get_wire()->send(rdid, [this, e](Buffer& buffer) {
+				auto writer = [this, e](Buffer& buffer) {
 					int32_t versionedFlag = ((is_master ? 1 : 0)) << versionedFlagShift;
 					Op op = static_cast<Op>(e.v.index());
 
@@ -108,6 +118,9 @@ public:
 
 					if (is_master)
 					{
+						// only the latest version is acknowledged once the messages before it are superseded, and the
+						// key is re-pointed to the one the entry has now
+						pendingForAck.unordered_erase(e.get_key());
 						pendingForAck.emplace(e.get_key(), version);
 						buffer.write_integral(version);
 					}
@@ -120,10 +133,35 @@ public:
 						VS::write(this->get_serialization_context(), buffer, *new_value);
 					}
 
-					spdlog::get("logSend")->trace("SEND{}", logmsg(op, next_version - 1, e.get_key(), new_value));
-				});
+					auto logger = spdlog::get("logSend");
+					if (logger->should_log(spdlog::level::trace))
+					{
+						logger->trace("SEND{}", logmsg(op, next_version - 1, e.get_key(), new_value));
+					}
+				};
+				if (coalesce_sent)
+				{
+					// the changes of an entry supersede each other
+					Buffer serialized_key;
+					KS::write(this->get_serialization_context(), serialized_key, *e.get_key());
+					const std::string key(reinterpret_cast<char const*>(serialized_key.data()), serialized_key.get_position());
+					get_wire()->send_latest(rdid, key, writer);
+				}
+				else
+				{
+					get_wire()->send(rdid, writer);
+				}
 			});
-		});
+		};
+		if (initial_sync)
+		{
+			local_change(send_changes);
+		}
+		else
+		{
+			// the entries are only sent when they are changed
+			send_changes();
+		}
 
 		get_wire()->advise(lifetime, this);
 
@@ -169,7 +207,8 @@ public:
 						// side effect
 						if (pendingVersion == version)
 						{
-							pendingForAck.erase(key);	 // else we don't need to remove, silently drop
+							// the order of pending keys doesn't matter, unordered_erase is O(1)
+							pendingForAck.unordered_erase(key);	   // else we don't need to remove, silently drop
 						}
 						// return good result
 					}
@@ -181,7 +220,11 @@ public:
 			}
 			if (errmsg.empty())
 			{
-				spdlog::get("logReceived")->trace(logmsg(Op::ACK, version, &(wrapper::get<K>(key))));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace(logmsg(Op::ACK, version, &(wrapper::get<K>(key))));
+				}
 			}
 			else
 			{
@@ -202,7 +245,11 @@ public:
 
 			if (msg_versioned || !is_master || pendingForAck.count(key) == 0)
 			{
-				spdlog::get("logReceived")->trace("RECV{}", logmsg(op, version, &(wrapper::get<K>(key)), value));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace("RECV{}", logmsg(op, version, &(wrapper::get<K>(key)), value));
+				}
 				if (value.has_value())
 				{
 					map::set(std::move(key), *std::move(value));
@@ -214,7 +261,11 @@ public:
 			}
 			else
 			{
-				spdlog::get("logReceived")->trace("{} >> REJECTED", logmsg(op, version, &(wrapper::get<K>(key)), value));
+				auto logger = spdlog::get("logReceived");
+				if (logger->should_log(spdlog::level::trace))
+				{
+					logger->trace("{} >> REJECTED", logmsg(op, version, &(wrapper::get<K>(key)), value));
+				}
 			}
 
 			if (msg_versioned)
@@ -224,7 +275,7 @@ public:
 						innerBuffer.write_integral<int32_t>((1u << versionedFlagShift) | static_cast<int32_t>(Op::ACK));
 						innerBuffer.write_integral<int64_t>(version);
 						// KS::write(this->get_serialization_context(), innerBuffer, wrapper::get<K>(key));
-						innerBuffer.write_byte_array_raw(serialized_key.getArray());
+						innerBuffer.write_byte_array_raw(serialized_key.getRealArray());
 						// logSend.trace(logmsg(Op::ACK, version, serialized_key));
 					});
 				get_wire()->send(rdid, std::move(writer));
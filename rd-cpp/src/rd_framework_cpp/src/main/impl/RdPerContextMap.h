@@ -0,0 +1,164 @@
+#ifndef RD_CPP_RDPERCONTEXTMAP_H
+#define RD_CPP_RDPERCONTEXTMAP_H
+
+#include "base/RdBindableBase.h"
+#include "base/IProtocol.h"
+#include "context/ProtocolContexts.h"
+#include "reactive/ViewableMap.h"
+#include "serialization/ISerializable.h"
+
+#include <functional>
+
+namespace rd
+{
+/**
+ * \brief Map with a value for every value of a heavy context known to the protocol.
+ *
+ * A single bound entity serves all the values of the context: the entries are created and bound on both sides as
+ * soon as a value enters the value set of the protocol, see \ref HeavySingleContextHandler. The map is changed on
+ * the scheduler of the protocol.
+ *
+ * \tparam K type of the context values
+ * \tparam V type of the bindable values
+ * \tparam S "SerDes" of the context values
+ */
+template <typename K, typename V, typename S = Polymorphic<K>>
+class RdPerContextMap final : public RdBindableBase, public ISerializable
+{
+public:
+	using value_factory_t = std::function<V(bool is_master)>;
+
+private:
+	RdContext<K, S> const& context;
+	value_factory_t value_factory;
+	ViewableMap<K, V> map;
+
+	void add_value(Lifetime lifetime, K const& key) const
+	{
+		if (lifetime->is_terminated() || map.get(key) != nullptr)
+		{
+			return;
+		}
+		map.set(key, value_factory(is_master));
+	}
+
+public:
+	bool is_master = false;
+
+	using key_type = K;
+	using value_type = V;
+
+	// region ctor/dtor
+
+	RdPerContextMap(RdContext<K, S> const& context, value_factory_t value_factory)
+		: context(context), value_factory(std::move(value_factory))
+	{
+	}
+
+	RdPerContextMap(RdPerContextMap&&) = default;
+
+	virtual ~RdPerContextMap() = default;
+	// endregion
+
+	static RdPerContextMap read(RdContext<K, S> const& context, value_factory_t value_factory, Buffer& buffer)
+	{
+		RdPerContextMap res(context, std::move(value_factory));
+		RdId id = RdId::read(buffer);
+		withId(res, id);
+		return res;
+	}
+
+	void write(SerializationCtx& /*ctx*/, Buffer& buffer) const override
+	{
+		rdid.write(buffer);
+	}
+
+	void init(Lifetime lifetime) const override
+	{
+		RdBindableBase::init(lifetime);
+
+		auto const& value_set = get_protocol()->get_contexts().get_value_set(context);
+
+		// values created before the bind survive only if the protocol knows their keys
+		std::vector<K> unknown;
+		for (auto it = map.begin(); it != map.end(); ++it)
+		{
+			if (!value_set.contains_value(it.key()))
+			{
+				unknown.push_back(it.key());
+			}
+		}
+		for (auto const& key : unknown)
+		{
+			map.remove(key);
+		}
+
+		map.view(lifetime, [this](Lifetime lf, K const& key, V const& value) {
+			value.identify(*get_protocol()->get_identity(), rdid.mix(to_string(key)));
+			value.bind(lf, this, "[" + to_string(key) + "]");
+		});
+
+		value_set.view_values(lifetime, [this, lifetime](K const& key) {
+			get_protocol()->get_scheduler()->invoke_or_queue([this, lifetime, key] { add_value(lifetime, key); });
+		});
+	}
+
+	/**
+	 * \brief The value for \p key, created on the fly while the map isn't bound.
+	 */
+	V const* get(K const& key) const
+	{
+		if (!is_bound())
+		{
+			if (map.get(key) == nullptr)
+			{
+				map.set(key, value_factory(false));
+			}
+		}
+		else
+		{
+			get_protocol()->get_scheduler()->assert_thread();
+		}
+		return map.get(key);
+	}
+
+	/**
+	 * \brief The value for the current value of the context.
+	 */
+	V const& get_for_current_context() const
+	{
+		optional<K> const& key = context.get_value_for_per_context_entity();
+		RD_ASSERT_THROW_MSG(key, "No " + context.key + " set for getting value for it");
+		V const* value = get(*key);
+		RD_ASSERT_THROW_MSG(value, "No value in " + to_string(location) + " for " + context.key + " = " + to_string(*key));
+		return *value;
+	}
+
+	size_t size() const
+	{
+		return map.size();
+	}
+
+	void view(Lifetime lifetime, std::function<void(Lifetime, K const&, V const&)> handler) const
+	{
+		map.view(lifetime, std::move(handler));
+	}
+
+	void advise_add_remove(Lifetime lifetime, std::function<void(AddRemove, K const&, V const&)> handler) const
+	{
+		map.advise_add_remove(lifetime, std::move(handler));
+	}
+
+	friend std::string to_string(RdPerContextMap const& value)
+	{
+		std::string res = "[";
+		for (auto it = value.map.begin(); it != value.map.end(); ++it)
+		{
+			res += to_string(it.key()) + "=>" + to_string(it.value()) + ",";
+		}
+		return res + "]";
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_RDPERCONTEXTMAP_H
@@ -15,7 +15,7 @@ namespace rd
  * \tparam S "SerDes" for value
  */
 template <typename T, typename S = Polymorphic<T>, typename A = allocator<T>>
-class RdProperty final : public RdPropertyBase<T, S>, public ISerializable
+class RdProperty : public RdPropertyBase<T, S>, public ISerializable
 {
 public:
 	using value_type = T;
@@ -15,13 +15,13 @@ namespace rd
  * \tparam S "SerDes" for values
  */
 template <typename T, typename S = Polymorphic<T>, typename A = allocator<T>>
-class RdSet final : public RdReactiveBase, public ViewableSet<T, A>, public ISerializable
+class RdSet : public RdReactiveBase, public ViewableSet<T, A>, public ISerializable
 {
 private:
 	using WT = typename IViewableSet<T>::WT;
 
 protected:
-	using set = ViewableSet<T>;
+	using set = ViewableSet<T, A>;
 
 public:
 	using Event = typename IViewableSet<T>::Event;
@@ -32,6 +32,10 @@ public:
 
 	RdSet() = default;
 
+	explicit RdSet(A const& alloc) : set(alloc)
+	{
+	}
+
 	RdSet(RdSet&&) = default;
 
 	RdSet& operator=(RdSet&&) = default;
@@ -68,7 +72,12 @@ public:
 					buffer.write_enum<AddRemove>(kind);
 					S::write(this->get_serialization_context(), buffer, v);
 
-					spdlog::get("logSend")->trace("SENDset {} {}:: {}:: {}", to_string(location), to_string(rdid), to_string(kind), to_string(v));
+					auto logger = spdlog::get("logSend");
+					if (logger->should_log(spdlog::level::trace))
+					{
+						logger->trace(
+							"SENDset {} {}:: {}:: {}", to_string(location), to_string(rdid), to_string(kind), to_string(v));
+					}
 				});
 			});
 		});
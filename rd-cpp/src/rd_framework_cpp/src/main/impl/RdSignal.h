@@ -77,7 +77,11 @@ public:
 	void on_wire_received(Buffer buffer) const override
 	{
 		auto value = S::read(this->get_serialization_context(), buffer);
-		spdlog::get("logReceived")->trace("RECV{}", logmsg(wrapper::get<T>(value)));
+		auto logger = spdlog::get("logReceived");
+		if (logger->should_log(spdlog::level::trace))
+		{
+			logger->trace("RECV{}", logmsg(wrapper::get<T>(value)));
+		}
 
 		signal.fire(wrapper::get<T>(value));
 	}
@@ -98,7 +102,11 @@ public:
 		if (async && !is_bound()) return;
 
 		get_wire()->send(rdid, [this, &value](Buffer& buffer) {
-			spdlog::get("logSend")->trace("SEND{}", logmsg(value));
+			auto logger = spdlog::get("logSend");
+			if (logger->should_log(spdlog::level::trace))
+			{
+				logger->trace("SEND{}", logmsg(value));
+			}
 			S::write(get_serialization_context(), buffer, value);
 		});
 		signal.fire(value);
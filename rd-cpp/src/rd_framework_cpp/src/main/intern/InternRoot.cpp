@@ -8,6 +8,8 @@ namespace rd
 InternRoot::InternRoot()
 {
 	async = true;
+	// interned values are sent before the messages that refer to them
+	send_priority = SendPriority::Control;
 }
 
 IScheduler* InternRoot::get_wire_scheduler() const
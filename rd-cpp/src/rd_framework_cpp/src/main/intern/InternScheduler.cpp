@@ -9,6 +9,7 @@ thread_local int32_t InternScheduler::active_counts = 0;
 InternScheduler::InternScheduler()
 {
 	out_of_order_execution = true;
+	executes_inline = true;
 }
 
 void InternScheduler::queue(std::function<void()> action)
@@ -0,0 +1,266 @@
+#include "Checkpoint.h"
+
+#include "util/hashing.h"
+
+#include "spdlog/spdlog.h"
+
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#endif
+
+namespace rd
+{
+constexpr int32_t Checkpoint::MAGIC;
+constexpr int32_t Checkpoint::FORMAT_VERSION;
+
+// [magic][format version][serialization hash][table size][table][sections],
+// the table holds [key][content hash][offset][size] of every section, offsets are from the end of the table
+namespace
+{
+constexpr size_t HEADER_SIZE = sizeof(int32_t) + sizeof(int32_t) + sizeof(int64_t) + sizeof(int32_t);
+
+using chunks_t = std::vector<std::pair<uint8_t const*, size_t>>;
+
+// returns once the content is on the disk, so that the rename can't be persisted before it
+bool write_file_synced(std::string const& path, chunks_t const& chunks)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	bool written = true;
+	for (auto const& chunk : chunks)
+	{
+		DWORD size = 0;
+		written = written && WriteFile(file, chunk.first, static_cast<DWORD>(chunk.second), &size, nullptr) != 0 &&
+				  size == chunk.second;
+	}
+	written = written && FlushFileBuffers(file) != 0;
+	return CloseHandle(file) != 0 && written;
+#else
+	const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		return false;
+	}
+	bool written = true;
+	for (auto const& chunk : chunks)
+	{
+		size_t done = 0;
+		while (written && done < chunk.second)
+		{
+			const ssize_t size = ::write(fd, chunk.first + done, chunk.second - done);
+			written = size > 0;
+			done += written ? static_cast<size_t>(size) : 0;
+		}
+	}
+	written = written && ::fsync(fd) == 0;
+	return ::close(fd) == 0 && written;
+#endif
+}
+
+bool replace_file(std::string const& from, std::string const& to)
+{
+#ifdef _WIN32
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	if (std::rename(from.c_str(), to.c_str()) != 0)
+	{
+		return false;
+	}
+	// the rename is an entry of the directory, it's persisted with the directory
+	const auto separator = to.find_last_of('/');
+	const std::string directory = separator == std::string::npos ? "." : separator == 0 ? "/" : to.substr(0, separator);
+	const int fd = ::open(directory.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		::fsync(fd);
+		::close(fd);
+	}
+	return true;
+#endif
+}
+}	 // namespace
+
+Checkpoint::Checkpoint(std::unique_ptr<MappedFile> file) : file(std::move(file))
+{
+}
+
+std::unique_ptr<Checkpoint> Checkpoint::open(std::string const& path, int64_t serialization_hash)
+{
+	auto file = MappedFile::open(path);
+	if (!file)
+	{
+		return nullptr;
+	}
+	if (file->size() < HEADER_SIZE)
+	{
+		spdlog::warn("Checkpoint {} is damaged", path);
+		return nullptr;
+	}
+
+	Buffer header(Buffer::ByteArray(file->data(), file->data() + HEADER_SIZE));
+	if (header.read_integral<int32_t>() != MAGIC || header.read_integral<int32_t>() != FORMAT_VERSION)
+	{
+		spdlog::warn("Checkpoint {} has unknown format", path);
+		return nullptr;
+	}
+	if (header.read_integral<int64_t>() != serialization_hash)
+	{
+		spdlog::info("Checkpoint {} was written for other models", path);
+		return nullptr;
+	}
+	const auto table_size = static_cast<size_t>(header.read_integral<int32_t>());
+	if (file->size() - HEADER_SIZE < table_size)
+	{
+		spdlog::warn("Checkpoint {} is damaged", path);
+		return nullptr;
+	}
+
+	std::unique_ptr<Checkpoint> result(new Checkpoint(std::move(file)));
+	uint8_t const* table_begin = result->file->data() + HEADER_SIZE;
+	Buffer table(Buffer::ByteArray(table_begin, table_begin + table_size));
+	const size_t sections_begin = HEADER_SIZE + table_size;
+	try
+	{
+		const auto count = table.read_integral<int32_t>();
+		for (int32_t i = 0; i < count; ++i)
+		{
+			std::string key = table.read_string();
+			Section section{};
+			section.content_hash = table.read_integral<int64_t>();
+			section.offset = sections_begin + static_cast<size_t>(table.read_integral<int64_t>());
+			section.size = static_cast<size_t>(table.read_integral<int64_t>());
+			if (section.offset > result->file->size() || result->file->size() - section.offset < section.size)
+			{
+				throw std::out_of_range("Section " + key + " is out of the file");
+			}
+			result->sections[std::move(key)] = section;
+		}
+	}
+	catch (std::exception const& e)
+	{
+		spdlog::warn("Checkpoint {} is damaged: {}", path, e.what());
+		return nullptr;
+	}
+	return result;
+}
+
+int64_t Checkpoint::content_hash(uint8_t const* data, size_t size)
+{
+	return util::getPlatformIndependentHash(string_view(reinterpret_cast<char const*>(data), size));
+}
+
+Checkpoint::Section const* Checkpoint::find_intact(std::string const& key) const
+{
+	auto it = sections.find(key);
+	if (it == sections.end())
+	{
+		return nullptr;
+	}
+	Section const& section = it->second;
+	if (content_hash(file->data() + section.offset, section.size) != section.content_hash)
+	{
+		spdlog::warn("Checkpoint section {} is damaged", key);
+		return nullptr;
+	}
+	return &section;
+}
+
+bool Checkpoint::contains(std::string const& key) const
+{
+	return find_intact(key) != nullptr;
+}
+
+int64_t Checkpoint::get_content_hash(std::string const& key) const
+{
+	Section const* section = find_intact(key);
+	return section == nullptr ? 0 : section->content_hash;
+}
+
+Buffer Checkpoint::read(std::string const& key) const
+{
+	Section const* section = find_intact(key);
+	if (section == nullptr)
+	{
+		return Buffer(0);
+	}
+	uint8_t const* begin = file->data() + section->offset;
+	return Buffer(Buffer::ByteArray(begin, begin + section->size));
+}
+
+CheckpointWriter::CheckpointWriter(int64_t serialization_hash) : serialization_hash(serialization_hash)
+{
+}
+
+void CheckpointWriter::add(std::string key, std::function<void(Buffer& buffer)> const& writer)
+{
+	Buffer content;
+	writer(content);
+	for (auto& section : sections)
+	{
+		if (section.key == key)
+		{
+			section.content = std::move(content);
+			return;
+		}
+	}
+	sections.push_back(Section{std::move(key), std::move(content)});
+}
+
+bool CheckpointWriter::commit(std::string const& path) const
+{
+	Buffer table;
+	table.write_integral<int32_t>(static_cast<int32_t>(sections.size()));
+	size_t offset = 0;
+	for (auto const& section : sections)
+	{
+		const size_t size = section.content.get_position();
+		table.write_string(section.key);
+		table.write_integral<int64_t>(Checkpoint::content_hash(section.content.data(), size));
+		table.write_integral<int64_t>(static_cast<int64_t>(offset));
+		table.write_integral<int64_t>(static_cast<int64_t>(size));
+		offset += size;
+	}
+	const size_t table_size = table.get_position();
+
+	Buffer header;
+	header.write_integral<int32_t>(Checkpoint::MAGIC);
+	header.write_integral<int32_t>(Checkpoint::FORMAT_VERSION);
+	header.write_integral<int64_t>(serialization_hash);
+	header.write_integral<int32_t>(static_cast<int32_t>(table_size));
+
+	const std::string temp_path = path + ".tmp";
+	chunks_t chunks{{header.data(), header.get_position()}, {table.data(), table_size}};
+	for (auto const& section : sections)
+	{
+		chunks.emplace_back(section.content.data(), section.content.get_position());
+	}
+	if (!write_file_synced(temp_path, chunks))
+	{
+		spdlog::warn("Couldn't write checkpoint {}", temp_path);
+		std::remove(temp_path.c_str());
+		return false;
+	}
+	if (!replace_file(temp_path, path))
+	{
+		spdlog::warn("Couldn't replace checkpoint {}", path);
+		std::remove(temp_path.c_str());
+		return false;
+	}
+	return true;
+}
+}	 // namespace rd
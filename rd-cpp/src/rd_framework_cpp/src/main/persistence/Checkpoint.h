@@ -0,0 +1,119 @@
+#ifndef RD_CPP_CHECKPOINT_H
+#define RD_CPP_CHECKPOINT_H
+
+#include "persistence/MappedFile.h"
+#include "protocol/Buffer.h"
+#include "std/unordered_map.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief State of models saved to a file, read back on a restart of the process.
+ *
+ * The file holds named sections, the serialized state of a model each, along with the hash of their content. The file
+ * is versioned by the serialization hash of the models (see \ref RdExtBase::serializationHash), so that a checkpoint
+ * written by another version of the models is never read. Sections are read from the mapping of the file only when
+ * they are asked for, and checked against their hash every time: a damaged section is treated as missing.
+ *
+ * Sections are written without intern roots in the serialization context, intern ids are only valid within a
+ * connection.
+ */
+class RD_FRAMEWORK_API Checkpoint final
+{
+	struct Section
+	{
+		int64_t content_hash;
+		size_t offset;
+		size_t size;
+	};
+
+	std::unique_ptr<MappedFile> file;
+	rd::unordered_map<std::string, Section> sections;
+
+	explicit Checkpoint(std::unique_ptr<MappedFile> file);
+
+	/**
+	 * \return the section [key] if its content still matches its hash, nullptr if it's missing or damaged.
+	 */
+	Section const* find_intact(std::string const& key) const;
+
+public:
+	static constexpr int32_t MAGIC = 0x4B434452;	// "RDCK"
+	static constexpr int32_t FORMAT_VERSION = 1;
+
+	// region ctor/dtor
+
+	Checkpoint(Checkpoint const&) = delete;
+
+	Checkpoint& operator=(Checkpoint const&) = delete;
+	// endregion
+
+	/**
+	 * \return the checkpoint at [path], nullptr if there is none, or it was written for other models or is damaged.
+	 */
+	static std::unique_ptr<Checkpoint> open(std::string const& path, int64_t serialization_hash);
+
+	/**
+	 * \brief The hash of the serialized state of a model, as it's stored for its section.
+	 */
+	static int64_t content_hash(uint8_t const* data, size_t size);
+
+	bool contains(std::string const& key) const;
+
+	/**
+	 * \return the content hash of the section [key], 0 if there is no such section or it's damaged.
+	 */
+	int64_t get_content_hash(std::string const& key) const;
+
+	/**
+	 * \brief Copies the section [key] out of the file, the buffer is empty if there is no such section or it's damaged.
+	 */
+	Buffer read(std::string const& key) const;
+};
+
+/**
+ * \brief Collects the sections of a checkpoint and replaces the file with them.
+ */
+class RD_FRAMEWORK_API CheckpointWriter final
+{
+	struct Section
+	{
+		std::string key;
+		Buffer content;
+	};
+
+	int64_t serialization_hash;
+	std::vector<Section> sections;
+
+public:
+	// region ctor/dtor
+
+	explicit CheckpointWriter(int64_t serialization_hash);
+	// endregion
+
+	/**
+	 * \brief Adds the section [key] written by [writer], the last section with the same key wins.
+	 */
+	void add(std::string key, std::function<void(Buffer& buffer)> const& writer);
+
+	/**
+	 * \brief Writes the checkpoint next to [path], syncs it to the disk and moves it over the previous one, so that a
+	 * crash leaves either of them intact.
+	 * \return false if the file couldn't be written.
+	 */
+	bool commit(std::string const& path) const;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_CHECKPOINT_H
@@ -0,0 +1,110 @@
+#include "CheckpointSync.h"
+
+#include <vector>
+
+namespace rd
+{
+// messages are [is reply][count] followed by [key][content hash] of the offers or [key][warm] of the reply
+
+void CheckpointSync::offer(std::string key, int64_t content_hash) const
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	offers[std::move(key)] = content_hash;
+}
+
+void CheckpointSync::provide(std::string key, std::function<int64_t()> content_hash) const
+{
+	std::lock_guard<decltype(lock)> guard(lock);
+	providers[std::move(key)] = std::move(content_hash);
+}
+
+void CheckpointSync::init(Lifetime lifetime) const
+{
+	RdReactiveBase::init(lifetime);
+	get_wire()->advise(lifetime, this);
+
+	// the owning side only replies, the restoring side sends its offers even if there are none
+	std::lock_guard<decltype(lock)> guard(lock);
+	if (!providers.empty())
+	{
+		return;
+	}
+	get_wire()->send(rdid, [this](Buffer& buffer) {
+		buffer.write_bool(false);
+		buffer.write_integral<int32_t>(static_cast<int32_t>(offers.size()));
+		for (auto const& offer : offers)
+		{
+			buffer.write_string(offer.first);
+			buffer.write_integral<int64_t>(offer.second);
+		}
+	});
+}
+
+void CheckpointSync::on_wire_received(Buffer buffer) const
+{
+	if (buffer.read_bool())
+	{
+		on_reply_received(buffer);
+	}
+	else
+	{
+		on_offers_received(buffer);
+	}
+}
+
+void CheckpointSync::on_offers_received(Buffer& buffer) const
+{
+	rd::unordered_map<std::string, int64_t> counterpart_offers;
+	const auto count = buffer.read_integral<int32_t>();
+	for (int32_t i = 0; i < count; ++i)
+	{
+		std::string key = buffer.read_string();
+		counterpart_offers[std::move(key)] = buffer.read_integral<int64_t>();
+	}
+
+	std::vector<Reconciliation> owned;
+	std::vector<Reconciliation> reply;
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		for (auto const& provider : providers)
+		{
+			auto it = counterpart_offers.find(provider.first);
+			owned.push_back(Reconciliation{provider.first, it != counterpart_offers.end() && it->second == provider.second()});
+		}
+		// the models this side doesn't own are cold
+		for (auto const& offer : counterpart_offers)
+		{
+			if (providers.count(offer.first) == 0)
+			{
+				reply.push_back(Reconciliation{offer.first, false});
+			}
+		}
+	}
+	reply.insert(reply.end(), owned.begin(), owned.end());
+
+	get_wire()->send(rdid, [&](Buffer& message) {
+		message.write_bool(true);
+		message.write_integral<int32_t>(static_cast<int32_t>(reply.size()));
+		for (auto const& reconciliation : reply)
+		{
+			message.write_string(reconciliation.key);
+			message.write_bool(reconciliation.warm);
+		}
+	});
+	for (auto const& reconciliation : owned)
+	{
+		reconciled.fire(reconciliation);
+	}
+}
+
+void CheckpointSync::on_reply_received(Buffer& buffer) const
+{
+	const auto count = buffer.read_integral<int32_t>();
+	for (int32_t i = 0; i < count; ++i)
+	{
+		std::string key = buffer.read_string();
+		const bool warm = buffer.read_bool();
+		reconciled.fire(Reconciliation{std::move(key), warm});
+	}
+}
+}	 // namespace rd
@@ -0,0 +1,76 @@
+#ifndef RD_CPP_CHECKPOINTSYNC_H
+#define RD_CPP_CHECKPOINTSYNC_H
+
+#include "base/RdReactiveBase.h"
+#include "reactive/base/SignalX.h"
+#include "std/unordered_map.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Decides which models restored from a \ref Checkpoint on a restart needn't be sent again.
+ *
+ * The side that restored models offers the content hashes of their sections when the entity is bound. The side that
+ * owns the models compares them with the hashes of its current state and replies. Both sides then fire \ref reconciled
+ * for every model: a warm model is bound without sending its entries (see \ref RdMap::initial_sync), a cold one is
+ * cleared by the restoring side and bound as usual.
+ *
+ * Both sides must be C++, other implementations of the protocol don't know this entity.
+ */
+class RD_FRAMEWORK_API CheckpointSync final : public RdReactiveBase
+{
+public:
+	struct Reconciliation
+	{
+		std::string key;
+		bool warm;
+	};
+
+private:
+	mutable std::mutex lock;
+	// content hashes of the restored sections
+	mutable rd::unordered_map<std::string, int64_t> offers;
+	// content hashes of the current state of the owned models
+	mutable rd::unordered_map<std::string, std::function<int64_t()>> providers;
+
+	void on_offers_received(Buffer& buffer) const;
+
+	void on_reply_received(Buffer& buffer) const;
+
+public:
+	Signal<Reconciliation> reconciled;
+
+	// region ctor/dtor
+
+	CheckpointSync() = default;
+
+	virtual ~CheckpointSync() = default;
+	// endregion
+
+	/**
+	 * \brief Called by the restoring side before the entity is bound, for every model restored from the checkpoint.
+	 */
+	void offer(std::string key, int64_t content_hash) const;
+
+	/**
+	 * \brief Called by the owning side before the entity is bound, for every model the counterpart may have restored.
+	 */
+	void provide(std::string key, std::function<int64_t()> content_hash) const;
+
+	void init(Lifetime lifetime) const override;
+
+	void on_wire_received(Buffer buffer) const override;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_CHECKPOINTSYNC_H
@@ -0,0 +1,52 @@
+#ifndef RD_CPP_MAPCHECKPOINT_H
+#define RD_CPP_MAPCHECKPOINT_H
+
+#include "impl/RdMap.h"
+#include "persistence/Checkpoint.h"
+
+namespace rd
+{
+/**
+ * \brief Writes the entries of [map] in its order, as a section of a checkpoint.
+ *
+ * [ctx] should have no intern roots, values are written in full then.
+ */
+template <typename K, typename V, typename KS, typename VS, typename KA, typename VA>
+void write_map_checkpoint(SerializationCtx& ctx, Buffer& buffer, RdMap<K, V, KS, VS, KA, VA> const& map)
+{
+	buffer.write_integral<int32_t>(static_cast<int32_t>(map.size()));
+	for (auto it = map.begin(); it != map.end(); ++it)
+	{
+		KS::write(ctx, buffer, it.key());
+		VS::write(ctx, buffer, it.value());
+	}
+}
+
+/**
+ * \brief Puts the entries of a section written by \ref write_map_checkpoint into [map], which isn't bound yet.
+ */
+template <typename K, typename V, typename KS, typename VS, typename KA, typename VA>
+void read_map_checkpoint(SerializationCtx& ctx, Buffer& buffer, RdMap<K, V, KS, VS, KA, VA> const& map)
+{
+	const auto count = buffer.read_integral<int32_t>();
+	for (int32_t i = 0; i < count; ++i)
+	{
+		auto key = KS::read(ctx, buffer);
+		auto value = VS::read(ctx, buffer);
+		map.set(std::move(key), std::move(value));
+	}
+}
+
+/**
+ * \brief The content hash [map] would have in a checkpoint, compared with the one of the counterpart's checkpoint.
+ */
+template <typename K, typename V, typename KS, typename VS, typename KA, typename VA>
+int64_t map_content_hash(SerializationCtx& ctx, RdMap<K, V, KS, VS, KA, VA> const& map)
+{
+	Buffer buffer;
+	write_map_checkpoint(ctx, buffer, map);
+	return Checkpoint::content_hash(buffer.data(), buffer.get_position());
+}
+}	 // namespace rd
+
+#endif	  // RD_CPP_MAPCHECKPOINT_H
@@ -0,0 +1,99 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+namespace rd
+{
+#ifdef _WIN32
+
+std::unique_ptr<MappedFile> MappedFile::open(std::string const& path)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	// the mapping keeps the file open
+	CloseHandle(file);
+	if (mapping == nullptr)
+	{
+		return nullptr;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		return nullptr;
+	}
+
+	std::unique_ptr<MappedFile> result(new MappedFile());
+	result->handle = mapping;
+	result->begin = static_cast<uint8_t const*>(view);
+	result->length = static_cast<size_t>(size.QuadPart);
+	return result;
+}
+
+MappedFile::~MappedFile()
+{
+	UnmapViewOfFile(begin);
+	CloseHandle(static_cast<HANDLE>(handle));
+}
+
+#else
+
+std::unique_ptr<MappedFile> MappedFile::open(std::string const& path)
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	struct stat st
+	{
+	};
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+	const auto size = static_cast<size_t>(st.st_size);
+	void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps the file open
+	close(fd);
+	if (view == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<MappedFile> result(new MappedFile());
+	result->begin = static_cast<uint8_t const*>(view);
+	result->length = size;
+	return result;
+}
+
+MappedFile::~MappedFile()
+{
+	munmap(const_cast<uint8_t*>(begin), length);
+}
+
+#endif
+}	 // namespace rd
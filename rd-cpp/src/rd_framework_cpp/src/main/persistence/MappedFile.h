@@ -0,0 +1,51 @@
+#ifndef RD_CPP_MAPPEDFILE_H
+#define RD_CPP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Read-only view of a whole file mapped into memory. The pages are loaded by the OS when they are touched.
+ */
+class RD_FRAMEWORK_API MappedFile final
+{
+	void* handle = nullptr;
+	uint8_t const* begin = nullptr;
+	size_t length = 0;
+
+	MappedFile() = default;
+
+public:
+	// region ctor/dtor
+
+	MappedFile(MappedFile const&) = delete;
+
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	~MappedFile();
+	// endregion
+
+	/**
+	 * \return the mapping of the file at [path], nullptr if the file doesn't exist, is empty or can't be mapped.
+	 */
+	static std::unique_ptr<MappedFile> open(std::string const& path);
+
+	uint8_t const* data() const
+	{
+		return begin;
+	}
+
+	size_t size() const
+	{
+		return length;
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_MAPPEDFILE_H
@@ -19,6 +19,30 @@ Buffer::Buffer(ByteArray array, size_t offset) : data_(std::move(array)), offset
 {
 }
 
+Buffer Buffer::view(word_t const* data, size_t size)
+{
+	Buffer buffer(size_t{0});
+	buffer.view_data = data;
+	buffer.view_size = size;
+	return buffer;
+}
+
+bool Buffer::is_view() const
+{
+	return view_data != nullptr;
+}
+
+void Buffer::detach()
+{
+	if (view_data == nullptr)
+	{
+		return;
+	}
+	data_.assign(view_data, view_data + view_size);
+	view_data = nullptr;
+	view_size = 0;
+}
+
 size_t Buffer::get_position() const
 {
 	return offset;
@@ -43,7 +67,7 @@ void Buffer::read(word_t* dst, size_t size)
 	if (size == 0)
 		return;
 	check_available(size);
-	std::copy(&data_[offset], &data_[offset] + size, dst);
+	std::copy(read_pointer(), read_pointer() + size, dst);
 	offset += size;
 }
 
@@ -58,7 +82,8 @@ void Buffer::write(const word_t* src, size_t size)
 
 void Buffer::require_available(size_t moreSize)
 {
-	if (offset + moreSize >= size())
+	detach();
+	if (offset + moreSize > size())
 	{
 		const size_t new_size = (std::max)(size() * 2, offset + moreSize);
 		data_.resize(new_size);
@@ -70,26 +95,40 @@ void Buffer::rewind()
 	set_position(0);
 }
 
+StringEncoding Buffer::get_string_encoding() const
+{
+	return string_encoding;
+}
+
+void Buffer::set_string_encoding(StringEncoding value)
+{
+	string_encoding = value;
+}
+
 Buffer::ByteArray Buffer::getArray() const&
 {
+	if (view_data != nullptr)
+	{
+		return ByteArray(view_data, view_data + view_size);
+	}
 	return data_;
 }
 
 Buffer::ByteArray Buffer::getArray() &&
 {
+	detach();
 	rewind();
 	return std::move(data_);
 }
 
 Buffer::ByteArray Buffer::getRealArray() const&
 {
-	auto res = getArray();
-	res.resize(offset);
-	return res;
+	return ByteArray(data(), data() + offset);
 }
 
 Buffer::ByteArray Buffer::getRealArray() &&
 {
+	detach();
 	auto res = std::move(data_);
 	res.resize(offset);
 	rewind();
@@ -98,11 +137,12 @@ Buffer::ByteArray Buffer::getRealArray() &&
 
 Buffer::word_t const* Buffer::data() const
 {
-	return data_.data();
+	return view_data != nullptr ? view_data : data_.data();
 }
 
 Buffer::word_t* Buffer::data()
 {
+	detach();
 	return data_.data();
 }
 
@@ -118,7 +158,12 @@ Buffer::word_t* Buffer::current_pointer()
 
 size_t Buffer::size() const
 {
-	return data_.size();
+	return view_data != nullptr ? view_size : data_.size();
+}
+
+Buffer::word_t const* Buffer::read_pointer() const
+{
+	return data() + offset;
 }
 
 /*std::string Buffer::readString() const {
@@ -131,41 +176,48 @@ std::vector<uint8_t> v(value.begin(), value.end());
 writeArray<uint8_t>(v);
 }*/
 
-template <int>
-std::wstring read_wstring_spec(Buffer& buffer)
+void Buffer::write_compact_string_header(size_t byte_count, bool utf8)
 {
-	auto v = buffer.read_array<std::vector, uint16_t>();
-	return std::wstring(v.begin(), v.end());
+	// negative header distinguishes compact strings from UTF-16 ones, whose length is never negative
+	write_integral<int32_t>(~static_cast<int32_t>((byte_count << 1u) | (utf8 ? 1u : 0u)));
 }
 
-template <>
-std::wstring read_wstring_spec<2>(Buffer& buffer)
+std::pair<size_t, bool> Buffer::read_compact_string_header(int32_t header)
 {
-	const int32_t len = buffer.read_integral<int32_t>();
-	RD_ASSERT_MSG(len >= 0, "read null string(length =" + std::to_string(len) + ")");
-	std::wstring result;
-	result.resize(len);
-	buffer.read(reinterpret_cast<Buffer::word_t*>(&result[0]), sizeof(wchar_t) * len);
-	return result;
+	RD_ASSERT_THROW_MSG(string_encoding == StringEncoding::Compact, "read null string(length = " + std::to_string(header) + ")");
+	const auto tagged = static_cast<uint32_t>(~header);
+	const size_t byte_count = tagged >> 1u;
+	check_available(byte_count);
+	return std::make_pair(byte_count, (tagged & 1u) != 0);
 }
 
 std::wstring Buffer::read_wstring()
 {
-	return read_wstring_spec<sizeof(wchar_t)>(*this);
-}
-
-template <int>
-void write_wstring_spec(Buffer& buffer, wstring_view value)
-{
-	const std::vector<uint16_t> v(value.begin(), value.end());
-	buffer.write_array<std::vector, uint16_t>(v);
-}
-
-template <>
-void write_wstring_spec<2>(Buffer& buffer, wstring_view value)
-{
-	buffer.write_integral<int32_t>(static_cast<int32_t>(value.size()));
-	buffer.write(reinterpret_cast<Buffer::word_t const*>(value.data()), sizeof(wchar_t) * value.size());
+	const int32_t header = read_integral<int32_t>();
+	std::wstring result;
+	if (header >= 0)
+	{
+		const size_t units = static_cast<size_t>(header);
+		check_available(2 * units);
+		result.resize(units);
+		result.resize(util::read_utf16(read_pointer(), units, &result[0]));
+		offset += 2 * units;
+	}
+	else
+	{
+		const auto compact = read_compact_string_header(header);
+		result.resize(compact.first);
+		if (compact.second)
+		{
+			result.resize(util::read_utf8(read_pointer(), compact.first, &result[0]));
+		}
+		else
+		{
+			util::read_latin1(read_pointer(), compact.first, &result[0]);
+		}
+		offset += compact.first;
+	}
+	return result;
 }
 
 void Buffer::write_wstring(std::wstring const& value)
@@ -191,7 +243,28 @@ uint16_t* Buffer::read_char16_string()
 
 void Buffer::write_wstring(wstring_view value)
 {
-	write_wstring_spec<sizeof(wchar_t)>(*this, value);
+	if (string_encoding == StringEncoding::Compact)
+	{
+		const bool latin1 = util::is_latin1(value);
+		const size_t byte_count = latin1 ? value.size() : util::utf8_length(value);
+		write_compact_string_header(byte_count, !latin1);
+		require_available(byte_count);
+		if (latin1)
+		{
+			util::write_latin1(value, current_pointer());
+		}
+		else
+		{
+			util::write_utf8(value, current_pointer());
+		}
+		offset += byte_count;
+		return;
+	}
+	const size_t units = util::utf16_length(value);
+	write_integral<int32_t>(static_cast<int32_t>(units));
+	require_available(2 * units);
+	util::write_utf16(value, current_pointer());
+	offset += 2 * units;
 }
 
 void Buffer::write_wstring(Wrapper<std::wstring> const& value)
@@ -199,6 +272,51 @@ void Buffer::write_wstring(Wrapper<std::wstring> const& value)
 	write_wstring(*value);
 }
 
+std::string Buffer::read_string()
+{
+	const int32_t header = read_integral<int32_t>();
+	std::string result;
+	if (header >= 0)
+	{
+		const size_t units = static_cast<size_t>(header);
+		check_available(2 * units);
+		result.resize(util::utf8_length_of_utf16(read_pointer(), units));
+		util::read_utf16(read_pointer(), units, &result[0]);
+		offset += 2 * units;
+	}
+	else
+	{
+		const auto compact = read_compact_string_header(header);
+		if (compact.second)
+		{
+			result.assign(reinterpret_cast<char const*>(read_pointer()), compact.first);
+		}
+		else
+		{
+			result.resize(util::utf8_length_of_latin1(read_pointer(), compact.first));
+			util::read_latin1(read_pointer(), compact.first, &result[0]);
+		}
+		offset += compact.first;
+	}
+	return result;
+}
+
+void Buffer::write_string(string_view value)
+{
+	if (string_encoding == StringEncoding::Compact)
+	{
+		// UTF-8 is always a valid compact payload, no need to look for a narrower representation
+		write_compact_string_header(value.size(), true);
+		write(reinterpret_cast<word_t const*>(value.data()), value.size());
+		return;
+	}
+	const size_t units = util::utf16_length(value);
+	write_integral<int32_t>(static_cast<int32_t>(units));
+	require_available(2 * units);
+	util::write_utf16(value, current_pointer());
+	offset += 2 * units;
+}
+
 int64_t TICKS_AT_EPOCH = 621355968000000000L;
 int64_t TICKS_PER_MILLISECOND = 10000000;
 
@@ -267,6 +385,7 @@ void Buffer::write_byte_array_raw(const ByteArray& array)
 
 Buffer::ByteArray& Buffer::get_data()
 {
+	detach();
 	return data_;
 }
 }	 // namespace rd
@@ -7,6 +7,8 @@
 #include "types/wrapper.h"
 #include "std/allocator.h"
 #include "std/list.h"
+#include "protocol/StringCodec.h"
+#include "protocol/ByteOrder.h"
 
 #include <vector>
 #include <type_traits>
@@ -34,24 +36,47 @@ public:
 	using ByteArray = std::vector<word_t, Allocator>;
 
 private:
-	template <int>
-	friend std::wstring read_wstring_spec(Buffer&);
+	ByteArray data_;
 
-	template <int>
-	friend void write_wstring_spec(Buffer&, wstring_view);
+	// memory of a view, data_ is unused while it's set
+	word_t const* view_data = nullptr;
 
-	ByteArray data_;
+	size_t view_size = 0;
 
 	size_t offset = 0;
 
+	StringEncoding string_encoding = StringEncoding::Utf16;
+
 	// read
 	void read(word_t* dst, size_t size);
 
 	// write
 	void write(const word_t* src, size_t size);
 
+	// numbers are little-endian on the wire, so on other hosts every element is byte-swapped
+	template <typename T>
+	void read_elements(T* dst, size_t count)
+	{
+		read(reinterpret_cast<word_t*>(dst), sizeof(T) * count);
+		util::convert_little_endian<T>(reinterpret_cast<word_t*>(dst), count);
+	}
+
+	template <typename T>
+	void write_elements(T const* src, size_t count)
+	{
+		const size_t start = offset;
+		write(reinterpret_cast<word_t const*>(src), sizeof(T) * count);
+		util::convert_little_endian<T>(data_.data() + start, count);
+	}
+
 	size_t size() const;
 
+	word_t const* read_pointer() const;
+
+	void write_compact_string_header(size_t byte_count, bool utf8);
+
+	std::pair<size_t, bool> read_compact_string_header(int32_t header);
+
 public:
 	// region ctor/dtor
 
@@ -69,44 +94,131 @@ public:
 
 	Buffer& operator=(Buffer&&) noexcept = default;
 
+	/**
+	 * \brief Read-only buffer over [size] bytes of external memory, which must outlive it or its \ref detach.
+	 * Anything that may modify the bytes (writes, mutable access, taking the array) copies them first.
+	 */
+	static Buffer view(word_t const* data, size_t size);
+
 	// endregion
 
+	bool is_view() const;
+
+	/**
+	 * \brief Makes a view own a copy of the viewed bytes, does nothing for other buffers.
+	 */
+	void detach();
+
 	size_t get_position() const;
 
 	void set_position(size_t value);
 
+	/**
+	 * \brief Makes room for [size] more bytes. Calling it up front for a series of writes of a known total size
+	 * grows the buffer at most once instead of doubling it step by step.
+	 */
 	void require_available(size_t size);
 
 	void check_available(size_t moreSize) const;
 
 	void rewind();
 
+	StringEncoding get_string_encoding() const;
+
+	/**
+	 * \brief Sets representation used by subsequent string writes. Reads accept UTF-16 strings always and compact ones
+	 * only when it's \ref StringEncoding::Compact, which must be set just for messages of a negotiated connection.
+	 */
+	void set_string_encoding(StringEncoding value);
+
 	template <typename T, typename = typename std::enable_if_t<std::is_integral<T>::value, T>>
 	T read_integral()
 	{
 		T result;
-		read(reinterpret_cast<word_t*>(&result), sizeof(T));
+		read_elements(&result, 1);
 		return result;
 	}
 
 	template <typename T, typename = typename std::enable_if_t<std::is_integral<T>::value>>
 	void write_integral(T const& value)
 	{
-		write(reinterpret_cast<word_t const*>(&value), sizeof(T));
+		write_elements(&value, 1);
 	}
 
 	template <typename T, typename = typename std::enable_if_t<std::is_floating_point<T>::value, T>>
 	T read_floating_point()
 	{
 		T result;
-		read(reinterpret_cast<word_t*>(&result), sizeof(T));
+		read_elements(&result, 1);
 		return result;
 	}
 
 	template <typename T, typename = typename std::enable_if_t<std::is_floating_point<T>::value>>
 	void write_floating_point(T const& value)
 	{
-		write(reinterpret_cast<word_t const*>(&value), sizeof(T));
+		write_elements(&value, 1);
+	}
+
+	/**
+	 * \brief Writes [count] elements starting at [data] in the format of \ref write_array.
+	 */
+	template <typename T, typename = typename std::enable_if_t<util::is_pod_v<T>>>
+	void write_span(T const* data, size_t count)
+	{
+		RD_ASSERT_MSG(count <= static_cast<size_t>(INT32_MAX), "span is too long(length = " + std::to_string(count) + ")");
+		require_available(sizeof(int32_t) + sizeof(T) * count);
+		write_integral<int32_t>(static_cast<int32_t>(count));
+		write_elements(data, count);
+	}
+
+	/**
+	 * \brief Writes any contiguous range, e.g. std::vector, std::array or a built-in array.
+	 */
+	template <typename R>
+	auto write_span(R const& range) -> decltype(void(write_span(range.data(), range.size())))
+	{
+		write_span(range.data(), range.size());
+	}
+
+	template <typename T, size_t N>
+	void write_span(T const (&array)[N])
+	{
+		write_span(&array[0], N);
+	}
+
+	/**
+	 * \brief Reads an array written by \ref write_span or \ref write_array into [data] without allocating.
+	 * Throws std::out_of_range if it has more than [capacity] elements, leaving the buffer before the array so that
+	 * it can be read again into a larger storage.
+	 * \return number of elements read.
+	 */
+	template <typename T, typename = typename std::enable_if_t<util::is_pod_v<T>>>
+	size_t read_into(T* data, size_t capacity)
+	{
+		const size_t start = offset;
+		const int32_t len = read_integral<int32_t>();
+		RD_ASSERT_MSG(len >= 0, "read null array(length = " + std::to_string(len) + ")");
+		const auto count = static_cast<size_t>(len);
+		if (count > capacity)
+		{
+			set_position(start);
+			throw std::out_of_range(
+				"Expected at most " + std::to_string(capacity) + " elements, got " + std::to_string(count));
+		}
+		read_elements(data, count);
+		return count;
+	}
+
+	template <typename R>
+	auto read_into(R& range) -> decltype(read_into(range.data(), range.size()))
+	{
+		return read_into(range.data(), range.size());
+	}
+
+	template <typename T, size_t N>
+	size_t read_into(T (&array)[N])
+	{
+		return read_into(&array[0], N);
 	}
 
 	template <template <class, class> class C, typename T, typename A = allocator<T>,
@@ -115,18 +227,20 @@ public:
 	{
 		int32_t len = read_integral<int32_t>();
 		RD_ASSERT_MSG(len >= 0, "read null array(length = " + std::to_string(len) + ")");
+		// fail on a broken length before allocating for it
+		check_available(sizeof(T) * len);
 		C<T, A> result;
 		using rd::resize;
 		resize(result, len);
 		if (len > 0)
 		{
-			read(reinterpret_cast<word_t*>(&result[0]), sizeof(T) * len);
+			read_elements(&result[0], static_cast<size_t>(len));
 		}
 		return result;
 	}
 
-	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>>
-	C<value_or_wrapper<T>, A> read_array(std::function<T()> reader)
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>, typename F>
+	C<value_or_wrapper<T>, A> read_array(F&& reader)
 	{
 		auto len = read_integral<int32_t>();
 		C<value_or_wrapper<T>, A> result;
@@ -144,16 +258,20 @@ public:
 	void write_array(C<T, A> const& container)
 	{
 		using rd::size;
-		const int32_t& len = rd::size(container);
-		write_integral<int32_t>(len);
+		const int32_t len = size(container);
 		if (len > 0)
 		{
-			write(reinterpret_cast<word_t const*>(&container[0]), sizeof(T) * len);
+			write_span(&container[0], static_cast<size_t>(len));
+		}
+		else
+		{
+			write_integral<int32_t>(len);
 		}
 	}
 
-	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>>
-	std::enable_if_t<util::disjunction<util::negation<is_wrapper<value_or_wrapper<T>>>, is_wrapper<T>>::value, void> write_array(C<value_or_wrapper<T>, A> const& container, std::function<void(T const&)> writer)
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>, typename F>
+	std::enable_if_t<util::disjunction<util::negation<is_wrapper<value_or_wrapper<T>>>, is_wrapper<T>>::value, void> write_array(
+		C<value_or_wrapper<T>, A> const& container, F&& writer)
 	{
 		using rd::size;
 		write_integral<int32_t>(size(container));
@@ -163,8 +281,9 @@ public:
 		}
 	}
 
-	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>>
-	std::enable_if_t<util::conjunction<is_wrapper<value_or_wrapper<T>>, util::negation<is_wrapper<T>>>::value, void> write_array(C<value_or_wrapper<T>, A> const& container, std::function<void(T const&)> writer)
+	template <template <class, class> class C, typename T, typename A = allocator<value_or_wrapper<T>>, typename F>
+	std::enable_if_t<util::conjunction<is_wrapper<value_or_wrapper<T>>, util::negation<is_wrapper<T>>>::value, void> write_array(
+		C<value_or_wrapper<T>, A> const& container, F&& writer)
 	{
 		using rd::size;
 		write_integral<int32_t>(size(container));
@@ -204,6 +323,16 @@ public:
 
 	void write_wstring(Wrapper<std::wstring> const& value);
 
+	/**
+	 * \brief Reads string as UTF-8 without materializing std::wstring.
+	 */
+	std::string read_string();
+
+	/**
+	 * \brief Writes UTF-8 encoded [value] in the same wire format as \ref write_wstring.
+	 */
+	void write_string(string_view value);
+
 	DateTime read_date_time();
 
 	void write_date_time(DateTime const& date_time);
@@ -261,9 +390,8 @@ public:
 		return reader();
 	}
 
-	template <typename T>
-	typename std::enable_if_t<!std::is_abstract<T>::value> write_nullable(
-		optional<T> const& value, std::function<void(T const&)> writer)
+	template <typename T, typename F>
+	typename std::enable_if_t<!std::is_abstract<T>::value> write_nullable(optional<T> const& value, F&& writer)
 	{
 		if (!value)
 		{
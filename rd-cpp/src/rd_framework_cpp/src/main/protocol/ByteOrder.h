@@ -0,0 +1,38 @@
+#ifndef RD_CPP_BYTEORDER_H
+#define RD_CPP_BYTEORDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace rd
+{
+namespace util
+{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool is_little_endian_host = false;
+#else
+constexpr bool is_little_endian_host = true;
+#endif
+
+/**
+ * \brief Converts [count] numbers of type T at [bytes] between host and little-endian (wire) byte order, in place.
+ * Does nothing on little-endian hosts and for types other than arithmetic ones, whose layout is unknown.
+ */
+template <typename T>
+void convert_little_endian(uint8_t* bytes, size_t count)
+{
+	if (is_little_endian_host || !std::is_arithmetic<T>::value || sizeof(T) == 1)
+	{
+		return;
+	}
+	for (size_t i = 0; i < count; ++i, bytes += sizeof(T))
+	{
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+}
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_BYTEORDER_H
@@ -14,4 +14,10 @@ RdId Identities::next(const RdId& parent) const
 	RdId result = parent.mix(id_acc.fetch_add(2));
 	return result;
 }
+
+Identities::Range Identities::next_range(const RdId& parent, int32_t count) const
+{
+	RD_ASSERT_MSG(count >= 0, "Negative count: " + std::to_string(count));
+	return Range(parent, id_acc.fetch_add(2 * count), count);
+}
 }	 // namespace rd
@@ -46,6 +46,42 @@ public:
 	 * \return unique identifier.
 	 */
 	RdId next(const RdId& parent) const;
+
+	/**
+	 * \brief Identifiers reserved at once by \ref next_range.
+	 */
+	class Range
+	{
+		RdId parent;
+		int32_t first;
+		int32_t count;
+
+	public:
+		constexpr Range(RdId parent, int32_t first, int32_t count) : parent(parent), first(first), count(count)
+		{
+		}
+
+		constexpr int32_t size() const
+		{
+			return count;
+		}
+
+		/**
+		 * \brief The \p index-th identifier of the range.
+		 */
+		RdId operator[](int32_t index) const
+		{
+			RD_ASSERT_MSG(index >= 0 && index < count, "Index " + std::to_string(index) + " out of " + std::to_string(count));
+			return parent.mix(static_cast<int64_t>(first) + 2 * static_cast<int64_t>(index));
+		}
+	};
+
+	/**
+	 * \brief Reserves \p count unique identifiers with a single atomic operation, for identifying many entities in a row.
+	 * \param parent previous id which is used for generating.
+	 * \return identifiers the same as \p count subsequent calls to \ref next would give.
+	 */
+	Range next_range(const RdId& parent, int32_t count) const;
 };
 }	 // namespace rd
 
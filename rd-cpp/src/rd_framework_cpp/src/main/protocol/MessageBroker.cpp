@@ -1,17 +1,28 @@
 #include "protocol/MessageBroker.h"
 
 #include "base/RdReactiveBase.h"
+#include "context/ProtocolContexts.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <cstring>
+
 namespace rd
 {
 std::shared_ptr<spdlog::logger> MessageBroker::logger =
 	spdlog::stderr_color_mt<spdlog::synchronous_factory>("logger", spdlog::color_mode::automatic);
 
-static void execute(const IRdReactive* that, Buffer msg)
+constexpr RdId MessageBroker::SNAPSHOT_ID;
+
+void MessageBroker::execute(const IRdReactive* that, Buffer msg) const
 {
-	msg.read_integral<int16_t>();	   // skip context
-	that->on_wire_received(std::move(msg));
+	if (!contexts)
+	{
+		msg.read_integral<int16_t>();	 // skip context
+		that->on_wire_received(std::move(msg));
+		return;
+	}
+	// the handler sees the context values of the sender
+	contexts->read_context(msg).update([&] { that->on_wire_received(std::move(msg)); });
 }
 
 void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) const
@@ -20,8 +31,16 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 	{
 		execute(that, std::move(msg));
 	}
+	else if (that->is_coalescing_received() && !that->get_wire_scheduler()->executes_inline)
+	{
+		invoke_coalesced(that, std::move(msg));
+	}
 	else
 	{
+		if (!that->get_wire_scheduler()->executes_inline)
+		{
+			msg.detach();
+		}
 		auto action = [this, that, message = std::move(msg)]() mutable {
 			bool exists_id = false;
 			{
@@ -42,19 +61,142 @@ void MessageBroker::invoke(const RdReactiveBase* that, Buffer msg, bool sync) co
 	}
 }
 
+void MessageBroker::invoke_coalesced(const RdReactiveBase* that, Buffer msg) const
+{
+	// the message is executed in place of the last one received, so it still follows the messages of other entities
+	// received before it; the actions queued for the messages it supersedes find it isn't theirs and do nothing
+	const RdId id = that->get_id();
+	msg.detach();
+	uint64_t generation;
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		generation = ++coalesced_generation;
+		auto it = coalesced.find(id);
+		if (it == coalesced.end())
+		{
+			coalesced.emplace(id, Coalesced{std::move(msg), generation});
+		}
+		else
+		{
+			logger->trace("Superseded message for id: {}", to_string(id));
+			it->second = Coalesced{std::move(msg), generation};
+		}
+	}
+	that->get_wire_scheduler()->queue([this, that, id, generation] {
+		optional<Buffer> message;
+		bool exists_id = false;
+		{
+			std::lock_guard<decltype(lock)> guard(lock);
+			auto it = coalesced.find(id);
+			if (it == coalesced.end() || it->second.generation != generation)
+			{
+				return;
+			}
+			message = make_optional<Buffer>(std::move(it->second.message));
+			coalesced.erase(it);
+			exists_id = subscriptions.count(id) > 0;
+		}
+		if (exists_id)
+		{
+			execute(that, *std::move(message));
+		}
+		else
+		{
+			logger->trace("Disappeared Handler for Reactive entities with id: {}", to_string(id));
+		}
+	});
+}
+
 MessageBroker::MessageBroker(IScheduler* defaultScheduler) : default_scheduler(defaultScheduler)
 {
 }
 
+void MessageBroker::set_contexts(ProtocolContexts const* new_contexts) const
+{
+	contexts = new_contexts;
+}
+
+void MessageBroker::dispatch_snapshot(Buffer snapshot) const
+{
+	snapshot.read_integral<int16_t>();	  // the snapshot itself is sent without contexts
+	const auto count = snapshot.read_integral<int32_t>();
+
+	std::vector<std::pair<RdId, Buffer>> deferred;
+	deferred.reserve(static_cast<size_t>(count));
+	{
+		std::lock_guard<decltype(lock)> guard(lock);
+		for (int32_t i = 0; i < count; ++i)
+		{
+			const auto size = static_cast<size_t>(snapshot.read_integral<int32_t>()) - sizeof(RdId::hash_t);
+			const RdId id = RdId::read(snapshot);
+			snapshot.check_available(size);
+			Buffer message(size);
+			message.set_string_encoding(snapshot.get_string_encoding());
+			memcpy(message.data(), static_cast<Buffer const&>(snapshot).current_pointer(), size);
+			snapshot.set_position(snapshot.get_position() + size);
+
+			// entities with their own schedulers get the messages right away, as with separate messages
+			auto it = subscriptions.find(id);
+			RdReactiveBase const* s = it == subscriptions.end() ? nullptr : it->second;
+			if (s != nullptr && s->get_wire_scheduler() != default_scheduler &&
+				(s->get_wire_scheduler()->out_of_order_execution || broker.find(id) == broker.end()))
+			{
+				invoke(s, std::move(message));
+			}
+			else
+			{
+				deferred.emplace_back(id, std::move(message));
+			}
+		}
+	}
+	if (deferred.empty())
+	{
+		return;
+	}
+
+	// the rest is applied by a single action, entities bound by a message get the following ones in the same pass
+	auto action = [this, messages = std::move(deferred)]() mutable {
+		for (auto& message : messages)
+		{
+			RdReactiveBase const* subscription = nullptr;
+			{
+				std::lock_guard<decltype(lock)> guard(lock);
+				auto it = subscriptions.find(message.first);
+				if (it != subscriptions.end())
+				{
+					subscription = it->second;
+				}
+			}
+			if (subscription != nullptr)
+			{
+				invoke(subscription, std::move(message.second), subscription->get_wire_scheduler() == default_scheduler);
+			}
+			else
+			{
+				logger->trace("No handler for id: {}", to_string(message.first));
+			}
+		}
+	};
+	std::function<void()> function = util::make_shared_function(std::move(action));
+	default_scheduler->queue(std::move(function));
+}
+
 void MessageBroker::dispatch(RdId id, Buffer message) const
 {
 	RD_ASSERT_MSG(!id.isNull(), "id mustn't be null")
 
+	if (id == SNAPSHOT_ID)
+	{
+		dispatch_snapshot(std::move(message));
+		return;
+	}
+
 	{	 // synchronized recursively
 		std::lock_guard<decltype(lock)> guard(lock);
 		RdReactiveBase const* s = subscriptions[id];
 		if (s == nullptr)
 		{
+			message.detach();
 			auto it = broker.find(id);
 			if (it == broker.end())
 			{
@@ -119,6 +261,7 @@ void MessageBroker::dispatch(RdId id, Buffer message) const
 				else
 				{
 					Mq& mq = it->second;
+					message.detach();
 					mq.custom_scheduler_messages.push_back(std::move(message));
 				}
 			}
@@ -140,7 +283,12 @@ void MessageBroker::advise_on(Lifetime lifetime, RdReactiveBase const* entity) c
 	{
 		auto key = entity->get_id();
 		subscriptions[key] = entity;
-		lifetime->add_action([this, key]() { subscriptions.erase(key); });
+		lifetime->add_action([this, key]() {
+			std::lock_guard<decltype(lock)> guard(lock);
+			subscriptions.erase(key);
+			// a message waiting for its action is never executed, the action finds it gone
+			coalesced.erase(key);
+		});
 	}
 }
 
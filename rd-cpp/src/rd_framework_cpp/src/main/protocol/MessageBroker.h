@@ -17,6 +17,8 @@ namespace rd
 {
 class RdReactiveBase;
 
+class ProtocolContexts;
+
 class RD_FRAMEWORK_API Mq
 {
 public:
@@ -41,21 +43,51 @@ class RD_FRAMEWORK_API MessageBroker final
 {
 private:
 	IScheduler* default_scheduler = nullptr;
+	mutable ProtocolContexts const* contexts = nullptr;
 	mutable rd::unordered_map<RdId, RdReactiveBase const*> subscriptions;
 	mutable rd::unordered_map<RdId, Mq> broker;
 
+	struct Coalesced
+	{
+		Buffer message;
+		// of the last queued action, the ones queued before it have been superseded
+		uint64_t generation;
+	};
+
+	// latest received messages of the entities with RdPropertyBase::coalesce_received, which are waiting for their action
+	mutable rd::unordered_map<RdId, Coalesced> coalesced;
+	mutable uint64_t coalesced_generation = 0;
+
 	mutable std::recursive_mutex lock;
 
 	static std::shared_ptr<spdlog::logger> logger;
 
+	void execute(const IRdReactive* that, Buffer msg) const;
+
 	void invoke(const RdReactiveBase* that, Buffer msg, bool sync = false) const;
 
+	void invoke_coalesced(const RdReactiveBase* that, Buffer msg) const;
+
+	void dispatch_snapshot(Buffer snapshot) const;
+
 public:
+	/**
+	 * \brief Id of the messages sent by \ref IWire::send_snapshot, they carry the messages of the snapshot packed
+	 * one after another, each as [size][id][context][payload].
+	 */
+	constexpr static RdId SNAPSHOT_ID = RdId::Null().mix("MessageBroker.Snapshot");
+
 	// region ctor/dtor
 
 	explicit MessageBroker(IScheduler* defaultScheduler);
 	// endregion
 
+	void set_contexts(ProtocolContexts const* new_contexts) const;
+
+	/**
+	 * \brief Hands [message] over to the entity with [id]. A \ref Buffer::view is copied only if the message is kept
+	 * past the call, i.e. if it waits for its entity or is queued to a scheduler which doesn't execute inline.
+	 */
 	void dispatch(RdId id, Buffer message) const;
 
 	void advise_on(Lifetime lifetime, RdReactiveBase const* entity) const;
@@ -2,6 +2,7 @@
 
 #include "serialization/SerializationCtx.h"
 #include "intern/InternRoot.h"
+#include "context/ProtocolContexts.h"
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 
@@ -14,6 +15,8 @@ std::shared_ptr<spdlog::logger> Protocol::initializationLogger =
 
 constexpr string_view Protocol::InternRootName;
 
+constexpr string_view Protocol::ContextsName;
+
 void Protocol::initialize() const
 {
 	internRoot = std::make_unique<InternRoot>();
@@ -25,16 +28,41 @@ void Protocol::initialize() const
 	scheduler->queue([this] { internRoot->bind(lifetime, this, InternRootName); });
 }
 
-Protocol::Protocol(std::shared_ptr<Identities> identity, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime)
-	: IProtocol(std::move(identity), scheduler, std::move(wire)), lifetime(lifetime)
+void Protocol::initialize_contexts(std::shared_ptr<ProtocolContexts> parent_contexts)
+{
+	if (parent_contexts)
+	{
+		// nested protocols send through the wire of the parent, which writes the parent contexts
+		contexts = std::move(parent_contexts);
+		return;
+	}
+
+	contexts = std::make_shared<ProtocolContexts>();
+	contexts->set_id(RdId::Null().mix(ContextsName));
+	wire->setup_contexts(contexts.get());
+	// terminated by the destructor of the protocol, so the protocol is alive while it isn't
+	Lifetime contexts_lifetime = contexts_lifetime_def.lifetime;
+	scheduler->invoke_or_queue([this, contexts_lifetime] {
+		if (!contexts_lifetime->is_terminated())
+		{
+			contexts->bind(contexts_lifetime, this, ContextsName);
+		}
+	});
+}
+
+Protocol::Protocol(std::shared_ptr<Identities> identity, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime,
+	std::shared_ptr<ProtocolContexts> parent_contexts)
+	: IProtocol(std::move(identity), scheduler, std::move(wire)), lifetime(lifetime), contexts_lifetime_def(lifetime)
 {
 	// initialize();
+	initialize_contexts(std::move(parent_contexts));
 }
 
 Protocol::Protocol(Identities::IdKind kind, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime)
-	: IProtocol(std::make_shared<Identities>(kind), scheduler, std::move(wire)), lifetime(lifetime)
+	: IProtocol(std::make_shared<Identities>(kind), scheduler, std::move(wire)), lifetime(lifetime), contexts_lifetime_def(lifetime)
 {
 	// initialize();
+	initialize_contexts(nullptr);
 }
 
 Protocol::~Protocol() = default;
@@ -4,6 +4,7 @@
 #include "base/IProtocol.h"
 #include "protocol/Identities.h"
 #include "serialization/SerializationCtx.h"
+#include "lifetime/LifetimeDefinition.h"
 
 #include <memory>
 
@@ -27,8 +28,13 @@ class RD_FRAMEWORK_API Protocol : /*IRdDynamic, */ public IProtocol
 {
 	constexpr static string_view InternRootName{"ProtocolInternRoot"};
 
+	constexpr static string_view ContextsName{"ProtocolContextHandler"};
+
 	Lifetime lifetime;
 
+	// terminated with the protocol, so that the contexts don't outlive it while bound
+	LifetimeDefinition contexts_lifetime_def;
+
 	mutable std::unique_ptr<SerializationCtx> context;
 
 	mutable std::unique_ptr<InternRoot> internRoot;
@@ -37,8 +43,14 @@ class RD_FRAMEWORK_API Protocol : /*IRdDynamic, */ public IProtocol
 private:
 	void initialize() const;
 
+	void initialize_contexts(std::shared_ptr<ProtocolContexts> parent_contexts);
+
 public:
-	Protocol(std::shared_ptr<Identities> identity, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime);
+	/**
+	 * \param parent_contexts contexts of the protocol this one is nested in, the protocol creates its own when null
+	 */
+	Protocol(std::shared_ptr<Identities> identity, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime,
+		std::shared_ptr<ProtocolContexts> parent_contexts = nullptr);
 
 	Protocol(Identities::IdKind, IScheduler* scheduler, std::shared_ptr<IWire> wire, Lifetime lifetime);
 
@@ -98,6 +98,35 @@ public:
 		return RdId(util::getPlatformIndependentHash(tail, static_cast<util::constexpr_hash_t>(hash)));
 	}
 
+	/**
+	 * \brief A string to \ref mix, hashed in advance.
+	 *
+	 * Mixing the string into an id multiplies the id by HASH_FACTOR once per char, so it's the same as multiplying it
+	 * by the power of HASH_FACTOR and adding the hash of the string started from zero.
+	 */
+	class Tail
+	{
+		friend class RdId;
+
+		util::constexpr_hash_t factor;
+		util::constexpr_hash_t hash;
+
+	public:
+		explicit constexpr Tail(string_view tail)
+			: factor(util::hashFactorPower(tail.size()))
+			, hash(static_cast<util::constexpr_hash_t>(util::getPlatformIndependentHash(tail, 0)))
+		{
+		}
+	};
+
+	/**
+	 * \brief Same as mixing the string \p tail was created from, without hashing it again.
+	 */
+	constexpr RdId mix(Tail const& tail) const
+	{
+		return RdId(static_cast<hash_t>(static_cast<util::constexpr_hash_t>(hash) * tail.factor + tail.hash));
+	}
+
 	/*constexpr RdId mix(int32_t tail) const {
 		return RdId(util::getPlatformIndependentHash(tail, static_cast<util::constexpr_hash_t>(hash)));
 	}
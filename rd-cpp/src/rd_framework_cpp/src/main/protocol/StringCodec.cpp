@@ -0,0 +1,571 @@
+#include "protocol/StringCodec.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RD_CPP_STRING_CODEC_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace rd
+{
+namespace util
+{
+namespace
+{
+constexpr bool WIDE_IS_UTF32 = sizeof(wchar_t) == 4;
+
+constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+constexpr uint32_t MAX_CODE_POINT = 0x10FFFF;
+
+inline uint16_t load16(uint8_t const* p)
+{
+	uint16_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline void store16(uint8_t* p, uint32_t v)
+{
+	const uint16_t u = static_cast<uint16_t>(v);
+	std::memcpy(p, &u, sizeof(u));
+}
+
+inline bool is_high_surrogate(uint32_t c)
+{
+	return (c & 0xFFFFFC00u) == 0xD800u;
+}
+
+inline bool is_low_surrogate(uint32_t c)
+{
+	return (c & 0xFFFFFC00u) == 0xDC00u;
+}
+
+inline uint32_t combine_surrogates(uint32_t high, uint32_t low)
+{
+	return 0x10000u + ((high - 0xD800u) << 10u) + (low - 0xDC00u);
+}
+
+inline uint32_t sanitize(uint32_t c)
+{
+	return c > MAX_CODE_POINT ? REPLACEMENT_CHARACTER : c;
+}
+
+// region decoders
+
+inline uint32_t next_wide(wchar_t const*& p, wchar_t const* end)
+{
+	uint32_t c = static_cast<uint32_t>(*p++);
+	if (!WIDE_IS_UTF32)
+	{
+		c &= 0xFFFFu;
+		if (is_high_surrogate(c) && p != end && is_low_surrogate(static_cast<uint32_t>(*p) & 0xFFFFu))
+		{
+			c = combine_surrogates(c, static_cast<uint32_t>(*p++) & 0xFFFFu);
+		}
+	}
+	return sanitize(c);
+}
+
+inline uint32_t next_utf16(uint8_t const*& p, uint8_t const* end)
+{
+	uint32_t c = load16(p);
+	p += 2;
+	if (is_high_surrogate(c) && p != end)
+	{
+		const uint32_t low = load16(p);
+		if (is_low_surrogate(low))
+		{
+			p += 2;
+			c = combine_surrogates(c, low);
+		}
+	}
+	return c;
+}
+
+inline uint32_t next_utf8(uint8_t const*& p, uint8_t const* end)
+{
+	uint32_t c = *p++;
+	if (c < 0x80u)
+	{
+		return c;
+	}
+	size_t extra = 0;
+	uint32_t min = 0;
+	if ((c & 0xE0u) == 0xC0u)
+	{
+		extra = 1;
+		c &= 0x1Fu;
+		min = 0x80u;
+	}
+	else if ((c & 0xF0u) == 0xE0u)
+	{
+		extra = 2;
+		c &= 0x0Fu;
+		min = 0x800u;
+	}
+	else if ((c & 0xF8u) == 0xF0u)
+	{
+		extra = 3;
+		c &= 0x07u;
+		min = 0x10000u;
+	}
+	else
+	{
+		return REPLACEMENT_CHARACTER;
+	}
+	for (size_t i = 0; i < extra; ++i)
+	{
+		if (p == end || (*p & 0xC0u) != 0x80u)
+		{
+			return REPLACEMENT_CHARACTER;
+		}
+		c = (c << 6u) | (*p++ & 0x3Fu);
+	}
+	return (c < min || c > MAX_CODE_POINT) ? REPLACEMENT_CHARACTER : c;
+}
+
+// endregion
+
+// region encoders
+
+inline size_t utf16_units(uint32_t c)
+{
+	return c > 0xFFFFu ? 2 : 1;
+}
+
+inline uint8_t* put_utf16(uint8_t* dst, uint32_t c)
+{
+	if (c > 0xFFFFu)
+	{
+		c -= 0x10000u;
+		store16(dst, 0xD800u + (c >> 10u));
+		store16(dst + 2, 0xDC00u + (c & 0x3FFu));
+		return dst + 4;
+	}
+	store16(dst, c);
+	return dst + 2;
+}
+
+inline size_t utf8_units(uint32_t c)
+{
+	return c < 0x80u ? 1 : c < 0x800u ? 2 : c < 0x10000u ? 3 : 4;
+}
+
+template <typename Byte>
+inline Byte* put_utf8(Byte* dst, uint32_t c)
+{
+	if (c < 0x80u)
+	{
+		*dst++ = static_cast<Byte>(c);
+	}
+	else if (c < 0x800u)
+	{
+		*dst++ = static_cast<Byte>(0xC0u | (c >> 6u));
+		*dst++ = static_cast<Byte>(0x80u | (c & 0x3Fu));
+	}
+	else if (c < 0x10000u)
+	{
+		*dst++ = static_cast<Byte>(0xE0u | (c >> 12u));
+		*dst++ = static_cast<Byte>(0x80u | ((c >> 6u) & 0x3Fu));
+		*dst++ = static_cast<Byte>(0x80u | (c & 0x3Fu));
+	}
+	else
+	{
+		*dst++ = static_cast<Byte>(0xF0u | (c >> 18u));
+		*dst++ = static_cast<Byte>(0x80u | ((c >> 12u) & 0x3Fu));
+		*dst++ = static_cast<Byte>(0x80u | ((c >> 6u) & 0x3Fu));
+		*dst++ = static_cast<Byte>(0x80u | (c & 0x3Fu));
+	}
+	return dst;
+}
+
+inline size_t put_wide(wchar_t* dst, uint32_t c)
+{
+	if (!WIDE_IS_UTF32 && c > 0xFFFFu)
+	{
+		c -= 0x10000u;
+		dst[0] = static_cast<wchar_t>(0xD800u + (c >> 10u));
+		dst[1] = static_cast<wchar_t>(0xDC00u + (c & 0x3FFu));
+		return 2;
+	}
+	dst[0] = static_cast<wchar_t>(c);
+	return 1;
+}
+
+// endregion
+
+#ifdef RD_CPP_STRING_CODEC_SSE2
+// All SSE2 paths below work on 32-bit wchar_t only, on Windows wide strings are already UTF-16.
+
+inline __m128i load128(void const* p)
+{
+	return _mm_loadu_si128(static_cast<__m128i const*>(p));
+}
+
+inline void store128(void* p, __m128i v)
+{
+	_mm_storeu_si128(static_cast<__m128i*>(p), v);
+}
+
+// true if all four 32-bit lanes of [v] are below 2^[bits]
+template <int bits>
+inline bool fits(__m128i v)
+{
+	return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(v, bits), _mm_setzero_si128())) == 0xFFFF;
+}
+
+// packs eight 32-bit lanes with values below 2^16 into eight 16-bit lanes (SSE2 has only signed saturation)
+inline __m128i pack_u32_to_u16(__m128i a, __m128i b)
+{
+	const __m128i bias32 = _mm_set1_epi32(0x8000);
+	const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+	return _mm_add_epi16(_mm_packs_epi32(_mm_sub_epi32(a, bias32), _mm_sub_epi32(b, bias32)), bias16);
+}
+
+// narrows sixteen 32-bit lanes with values below 2^8 to bytes
+inline __m128i pack_u32_to_u8(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+	return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+// widens sixteen bytes into sixteen 32-bit lanes
+inline void store_u8_as_u32(wchar_t* dst, __m128i v)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i lo = _mm_unpacklo_epi8(v, zero);
+	const __m128i hi = _mm_unpackhi_epi8(v, zero);
+	store128(dst, _mm_unpacklo_epi16(lo, zero));
+	store128(dst + 4, _mm_unpackhi_epi16(lo, zero));
+	store128(dst + 8, _mm_unpacklo_epi16(hi, zero));
+	store128(dst + 12, _mm_unpackhi_epi16(hi, zero));
+}
+#endif
+}	 // namespace
+
+// region wide <-> UTF-16
+
+size_t utf16_length(wstring_view value)
+{
+	if (!WIDE_IS_UTF32)
+	{
+		return value.size();
+	}
+	size_t supplementary = 0;
+	for (wchar_t c : value)
+	{
+		supplementary += static_cast<uint32_t>(c) - 0x10000u <= MAX_CODE_POINT - 0x10000u;
+	}
+	return value.size() + supplementary;
+}
+
+void write_utf16(wstring_view value, uint8_t* dst)
+{
+	if (!WIDE_IS_UTF32)
+	{
+		std::memcpy(dst, value.data(), value.size() * sizeof(wchar_t));
+		return;
+	}
+	wchar_t const* p = value.data();
+	wchar_t const* const end = p + value.size();
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	while (end - p >= 8)
+	{
+		const __m128i a = load128(p);
+		const __m128i b = load128(p + 4);
+		if (fits<16>(_mm_or_si128(a, b)))
+		{
+			store128(dst, pack_u32_to_u16(a, b));
+			p += 8;
+			dst += 16;
+			continue;
+		}
+		for (wchar_t const* block_end = p + 8; p != block_end;)
+		{
+			dst = put_utf16(dst, next_wide(p, end));
+		}
+	}
+#endif
+	while (p != end)
+	{
+		dst = put_utf16(dst, next_wide(p, end));
+	}
+}
+
+size_t read_utf16(uint8_t const* src, size_t units, wchar_t* dst)
+{
+	if (!WIDE_IS_UTF32)
+	{
+		std::memcpy(dst, src, units * sizeof(wchar_t));
+		return units;
+	}
+	uint8_t const* const end = src + 2 * units;
+	wchar_t* const begin = dst;
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i surrogate_mask = _mm_set1_epi16(static_cast<int16_t>(0xFC00));
+	const __m128i high_surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800));
+	while (end - src >= 16)
+	{
+		const __m128i v = load128(src);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, surrogate_mask), high_surrogate)) == 0)
+		{
+			store128(dst, _mm_unpacklo_epi16(v, zero));
+			store128(dst + 4, _mm_unpackhi_epi16(v, zero));
+			src += 16;
+			dst += 8;
+			continue;
+		}
+		dst += put_wide(dst, next_utf16(src, end));
+	}
+#endif
+	while (src != end)
+	{
+		dst += put_wide(dst, next_utf16(src, end));
+	}
+	return static_cast<size_t>(dst - begin);
+}
+
+// endregion
+
+// region wide <-> Latin-1
+
+bool is_latin1(wstring_view value)
+{
+	wchar_t const* p = value.data();
+	wchar_t const* const end = p + value.size();
+	uint32_t acc = 0;
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	if (WIDE_IS_UTF32)
+	{
+		__m128i vacc = _mm_setzero_si128();
+		for (; end - p >= 16; p += 16)
+		{
+			vacc = _mm_or_si128(vacc, _mm_or_si128(_mm_or_si128(load128(p), load128(p + 4)), _mm_or_si128(load128(p + 8), load128(p + 12))));
+		}
+		if (!fits<8>(vacc))
+		{
+			return false;
+		}
+	}
+#endif
+	for (; p != end; ++p)
+	{
+		acc |= static_cast<uint32_t>(*p);
+	}
+	return acc <= 0xFFu;
+}
+
+void write_latin1(wstring_view value, uint8_t* dst)
+{
+	wchar_t const* p = value.data();
+	wchar_t const* const end = p + value.size();
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	if (WIDE_IS_UTF32)
+	{
+		for (; end - p >= 16; p += 16, dst += 16)
+		{
+			store128(dst, pack_u32_to_u8(load128(p), load128(p + 4), load128(p + 8), load128(p + 12)));
+		}
+	}
+#endif
+	while (p != end)
+	{
+		*dst++ = static_cast<uint8_t>(*p++);
+	}
+}
+
+void read_latin1(uint8_t const* src, size_t len, wchar_t* dst)
+{
+	uint8_t const* const end = src + len;
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	if (WIDE_IS_UTF32)
+	{
+		for (; end - src >= 16; src += 16, dst += 16)
+		{
+			store_u8_as_u32(dst, load128(src));
+		}
+	}
+#endif
+	while (src != end)
+	{
+		*dst++ = static_cast<wchar_t>(*src++);
+	}
+}
+
+// endregion
+
+// region wide <-> UTF-8
+
+size_t utf8_length(wstring_view value)
+{
+	size_t result = 0;
+	wchar_t const* p = value.data();
+	wchar_t const* const end = p + value.size();
+	while (p != end)
+	{
+		result += utf8_units(next_wide(p, end));
+	}
+	return result;
+}
+
+void write_utf8(wstring_view value, uint8_t* dst)
+{
+	wchar_t const* p = value.data();
+	wchar_t const* const end = p + value.size();
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	if (WIDE_IS_UTF32)
+	{
+		while (end - p >= 16)
+		{
+			const __m128i a = load128(p);
+			const __m128i b = load128(p + 4);
+			const __m128i c = load128(p + 8);
+			const __m128i d = load128(p + 12);
+			if (fits<7>(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))))
+			{
+				store128(dst, pack_u32_to_u8(a, b, c, d));
+				p += 16;
+				dst += 16;
+				continue;
+			}
+			for (wchar_t const* block_end = p + 16; p != block_end;)
+			{
+				dst = put_utf8(dst, next_wide(p, end));
+			}
+		}
+	}
+#endif
+	while (p != end)
+	{
+		dst = put_utf8(dst, next_wide(p, end));
+	}
+}
+
+size_t read_utf8(uint8_t const* src, size_t len, wchar_t* dst)
+{
+	uint8_t const* const end = src + len;
+	wchar_t* const begin = dst;
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	if (WIDE_IS_UTF32)
+	{
+		while (end - src >= 16)
+		{
+			const __m128i v = load128(src);
+			if (_mm_movemask_epi8(v) == 0)
+			{
+				store_u8_as_u32(dst, v);
+				src += 16;
+				dst += 16;
+				continue;
+			}
+			dst += put_wide(dst, next_utf8(src, end));
+		}
+	}
+#endif
+	while (src != end)
+	{
+		dst += put_wide(dst, next_utf8(src, end));
+	}
+	return static_cast<size_t>(dst - begin);
+}
+
+// endregion
+
+// region UTF-8 native API
+
+size_t utf16_length(string_view value)
+{
+	auto p = reinterpret_cast<uint8_t const*>(value.data());
+	auto const end = p + value.size();
+	size_t result = 0;
+	while (p != end)
+	{
+		result += utf16_units(next_utf8(p, end));
+	}
+	return result;
+}
+
+void write_utf16(string_view value, uint8_t* dst)
+{
+	auto p = reinterpret_cast<uint8_t const*>(value.data());
+	auto const end = p + value.size();
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	while (end - p >= 16)
+	{
+		const __m128i v = load128(p);
+		if (_mm_movemask_epi8(v) == 0)
+		{
+			store128(dst, _mm_unpacklo_epi8(v, zero));
+			store128(dst + 16, _mm_unpackhi_epi8(v, zero));
+			p += 16;
+			dst += 32;
+			continue;
+		}
+		dst = put_utf16(dst, next_utf8(p, end));
+	}
+#endif
+	while (p != end)
+	{
+		dst = put_utf16(dst, next_utf8(p, end));
+	}
+}
+
+size_t utf8_length_of_utf16(uint8_t const* src, size_t units)
+{
+	uint8_t const* const end = src + 2 * units;
+	size_t result = 0;
+	while (src != end)
+	{
+		result += utf8_units(next_utf16(src, end));
+	}
+	return result;
+}
+
+void read_utf16(uint8_t const* src, size_t units, char* dst)
+{
+	uint8_t const* const end = src + 2 * units;
+#ifdef RD_CPP_STRING_CODEC_SSE2
+	const __m128i ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+	const __m128i zero = _mm_setzero_si128();
+	while (end - src >= 16)
+	{
+		const __m128i v = load128(src);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, ascii_mask), zero)) == 0xFFFF)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(v, zero));
+			src += 16;
+			dst += 8;
+			continue;
+		}
+		dst = put_utf8(dst, next_utf16(src, end));
+	}
+#endif
+	while (src != end)
+	{
+		dst = put_utf8(dst, next_utf16(src, end));
+	}
+}
+
+size_t utf8_length_of_latin1(uint8_t const* src, size_t len)
+{
+	size_t result = len;
+	for (size_t i = 0; i < len; ++i)
+	{
+		result += src[i] >> 7u;
+	}
+	return result;
+}
+
+void read_latin1(uint8_t const* src, size_t len, char* dst)
+{
+	for (size_t i = 0; i < len; ++i)
+	{
+		dst = put_utf8(dst, src[i]);
+	}
+}
+
+// endregion
+}	 // namespace util
+}	 // namespace rd
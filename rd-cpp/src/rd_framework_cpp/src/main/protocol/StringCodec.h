@@ -0,0 +1,101 @@
+#ifndef RD_CPP_STRINGCODEC_H
+#define RD_CPP_STRINGCODEC_H
+
+#include "thirdparty.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <rd_framework_export.h>
+
+namespace rd
+{
+/**
+ * \brief Wire representation of strings written by \ref Buffer.
+ */
+enum class StringEncoding : uint8_t
+{
+	/**
+	 * \brief int32 length in code units followed by UTF-16LE code units. Understood by every rd peer.
+	 */
+	Utf16,
+	/**
+	 * \brief Negative int32 header followed by Latin-1 or UTF-8 bytes. Must be used only after the counterpart
+	 * has advertised support for it, see SocketWire::Base::use_compact_strings. Only buffers set to this encoding
+	 * accept it on reading, for others a negative length is an error as it is for the other rd implementations.
+	 */
+	Compact
+};
+
+namespace util
+{
+/**
+ * \brief Transcoding primitives used by \ref Buffer to move strings between their in-memory form and the wire
+ * without intermediate containers. "Wide" means wchar_t (UTF-32 on Linux/Mac, UTF-16 on Windows),
+ * byte buffers are little-endian and don't need to be aligned.
+ *
+ * Lone surrogates are passed through unchanged in UTF-16 <-> wide conversion. Where wchar_t is UTF-32, a round trip
+ * doesn't preserve values above U+10FFFF, which are written as U+FFFD, nor a surrogate pair stored as two wchar_t,
+ * which comes back as one supplementary character.
+ */
+
+// region wide <-> UTF-16
+
+/// \return number of UTF-16 code units needed to represent [value].
+RD_FRAMEWORK_API size_t utf16_length(wstring_view value);
+
+/// \brief Writes exactly utf16_length(value) code units to [dst].
+RD_FRAMEWORK_API void write_utf16(wstring_view value, uint8_t* dst);
+
+/// \brief Decodes [units] UTF-16 code units from [src] into [dst], which must have room for [units] characters.
+/// \return number of wchar_t written.
+RD_FRAMEWORK_API size_t read_utf16(uint8_t const* src, size_t units, wchar_t* dst);
+
+// endregion
+
+// region wide <-> Latin-1
+
+RD_FRAMEWORK_API bool is_latin1(wstring_view value);
+
+/// \brief Narrows [value] to [dst], every character of [value] must be Latin-1.
+RD_FRAMEWORK_API void write_latin1(wstring_view value, uint8_t* dst);
+
+RD_FRAMEWORK_API void read_latin1(uint8_t const* src, size_t len, wchar_t* dst);
+
+// endregion
+
+// region wide <-> UTF-8
+
+/// \return number of UTF-8 bytes needed to represent [value].
+RD_FRAMEWORK_API size_t utf8_length(wstring_view value);
+
+RD_FRAMEWORK_API void write_utf8(wstring_view value, uint8_t* dst);
+
+/// \brief Decodes [len] UTF-8 bytes from [src] into [dst], which must have room for [len] characters.
+/// \return number of wchar_t written.
+RD_FRAMEWORK_API size_t read_utf8(uint8_t const* src, size_t len, wchar_t* dst);
+
+// endregion
+
+// region UTF-8 native API
+
+/// \return number of UTF-16 code units needed to represent UTF-8 encoded [value].
+RD_FRAMEWORK_API size_t utf16_length(string_view value);
+
+RD_FRAMEWORK_API void write_utf16(string_view value, uint8_t* dst);
+
+/// \return number of UTF-8 bytes produced by decoding [units] UTF-16 code units from [src].
+RD_FRAMEWORK_API size_t utf8_length_of_utf16(uint8_t const* src, size_t units);
+
+RD_FRAMEWORK_API void read_utf16(uint8_t const* src, size_t units, char* dst);
+
+/// \return number of UTF-8 bytes produced by decoding [len] Latin-1 bytes from [src].
+RD_FRAMEWORK_API size_t utf8_length_of_latin1(uint8_t const* src, size_t len);
+
+RD_FRAMEWORK_API void read_latin1(uint8_t const* src, size_t len, char* dst);
+
+// endregion
+}	 // namespace util
+}	 // namespace rd
+
+#endif	  // RD_CPP_STRINGCODEC_H
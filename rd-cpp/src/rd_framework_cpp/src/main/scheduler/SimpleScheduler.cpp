@@ -2,6 +2,11 @@
 
 namespace rd
 {
+SimpleScheduler::SimpleScheduler()
+{
+	executes_inline = true;
+}
+
 void SimpleScheduler::flush()
 {
 }
@@ -14,7 +14,7 @@ class RD_FRAMEWORK_API SimpleScheduler : public IScheduler
 {
 public:
 	// region ctor/dtor
-	SimpleScheduler() = default;
+	SimpleScheduler();
 
 	virtual ~SimpleScheduler() = default;
 	// endregion
@@ -2,17 +2,15 @@
 
 #include <utility>
 
-#include "ctpl_stl.h"
-
 namespace rd
 {
-SingleThreadScheduler::SingleThreadScheduler(Lifetime lifetime, std::string name)
-	: SingleThreadSchedulerBase(std::move(name)), lifetime(lifetime)
+SingleThreadScheduler::SingleThreadScheduler(Lifetime lifetime, std::string name, size_t spin_count)
+	: SingleThreadSchedulerBase(std::move(name), spin_count), lifetime(lifetime)
 {
-	lifetime->add_action([this]() {
+	stop_action_id = lifetime->add_action([this]() {
 		try
 		{
-			pool->stop(true);
+			stop();
 		}
 		catch (std::exception const& e)
 		{
@@ -21,4 +19,11 @@ SingleThreadScheduler::SingleThreadScheduler(Lifetime lifetime, std::string name
 		}
 	});
 }
+
+SingleThreadScheduler::~SingleThreadScheduler()
+{
+	lifetime->remove_action(stop_action_id);
+	// the queued actions may use the lifetime
+	stop();
+}
 }	 // namespace rd
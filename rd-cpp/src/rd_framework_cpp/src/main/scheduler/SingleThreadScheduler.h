@@ -14,7 +14,16 @@ class RD_FRAMEWORK_API SingleThreadScheduler : public SingleThreadSchedulerBase
 public:
 	Lifetime lifetime;
 
-	SingleThreadScheduler(Lifetime lifetime, std::string name);
+private:
+	LifetimeImpl::counter_t stop_action_id = 0;
+
+public:
+	// region ctor/dtor
+
+	SingleThreadScheduler(Lifetime lifetime, std::string name, size_t spin_count = 0);
+
+	virtual ~SingleThreadScheduler();
+	// endregion
 };
 }	 // namespace rd
 
@@ -0,0 +1,194 @@
+#include "StealingScheduler.h"
+
+#include "util/core_util.h"
+#include "util/thread_util.h"
+
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace rd
+{
+namespace
+{
+// the schedulers whose actions this thread is executing, kept out of the exported class
+thread_local std::vector<StealingScheduler const*> executing_schedulers;
+
+class ExecutingGuard
+{
+public:
+	explicit ExecutingGuard(StealingScheduler const* scheduler)
+	{
+		executing_schedulers.push_back(scheduler);
+	}
+
+	ExecutingGuard(ExecutingGuard const&) = delete;
+
+	ExecutingGuard& operator=(ExecutingGuard const&) = delete;
+
+	~ExecutingGuard()
+	{
+		executing_schedulers.pop_back();
+	}
+};
+}	 // namespace
+
+StealingScheduler::StealingScheduler(Lifetime lifetime, std::string name)
+	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic))
+	, name(std::move(name))
+	, lifetime(std::move(lifetime))
+{
+	{
+		// the thread takes the lock before it executes anything, so it sees its id assigned
+		std::lock_guard<std::mutex> guard(lock);
+		worker = std::thread([this] { run(); });
+		thread_id = worker.get_id();
+	}
+	stop_action_id = this->lifetime->add_action([this] { stop(); });
+}
+
+StealingScheduler::~StealingScheduler()
+{
+	RD_ASSERT_MSG(!is_active(), "Scheduler " + name + " can't be destroyed by its own actions");
+	lifetime->remove_action(stop_action_id);
+	stop();
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+bool StealingScheduler::can_execute() const
+{
+	return !actions.empty() && (executing_depth == 0 || executing_thread == std::this_thread::get_id());
+}
+
+bool StealingScheduler::execute_next(std::unique_lock<std::mutex>& guard)
+{
+	if (!can_execute())
+	{
+		return false;
+	}
+	auto action = std::move(actions.front());
+	actions.pop_front();
+	executing_thread = std::this_thread::get_id();
+	++executing_depth;
+	guard.unlock();
+
+	{
+		ExecutingGuard executing(this);
+		try
+		{
+			action();
+		}
+		catch (std::exception const& e)
+		{
+			log->error("Task failed, scheduler={} | {}", name, e.what());
+		}
+		catch (...)
+		{
+			// anything escaping would leave the scheduler executing forever for the threads joining it
+			log->error("Task failed, scheduler={} | unknown exception", name);
+		}
+	}
+
+	guard.lock();
+	if (--executing_depth == 0)
+	{
+		executing_thread = std::thread::id();
+	}
+	changed.notify_all();
+	return true;
+}
+
+void StealingScheduler::run()
+{
+	util::set_thread_name(name.c_str());
+
+	std::unique_lock<std::mutex> guard(lock);
+	while (true)
+	{
+		if (execute_next(guard))
+		{
+			continue;
+		}
+		if (stopped && actions.empty())
+		{
+			return;
+		}
+		changed.wait(guard);
+	}
+}
+
+void StealingScheduler::stop()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopped = true;
+	}
+	changed.notify_all();
+	// stopped by an action, which the thread may be waiting for: it finishes the queue and exits, the destructor joins it
+	if (!is_active() && worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+void StealingScheduler::queue(std::function<void()> action)
+{
+	bool execute_now;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		actions.push_back(std::move(action));
+		execute_now = stopped;
+	}
+	changed.notify_all();
+	if (execute_now)
+	{
+		// the thread may be gone already, nothing else would execute the action
+		flush();
+	}
+}
+
+void StealingScheduler::flush()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	// the actions being executed by other threads are waited for, the ones this thread executes can't be
+	while (!actions.empty() || (executing_depth > 0 && executing_thread != std::this_thread::get_id()))
+	{
+		if (!execute_next(guard))
+		{
+			changed.wait(guard);
+		}
+	}
+}
+
+bool StealingScheduler::join(std::function<bool()> const& condition, std::chrono::milliseconds timeout)
+{
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	while (!condition())
+	{
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			if (execute_next(guard))
+			{
+				continue;
+			}
+		}
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			return false;
+		}
+		// the condition may be satisfied by another thread, which doesn't notify this scheduler
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+bool StealingScheduler::is_active() const
+{
+	return thread_id == std::this_thread::get_id() ||
+		   std::find(executing_schedulers.begin(), executing_schedulers.end(), this) != executing_schedulers.end();
+}
+}	 // namespace rd
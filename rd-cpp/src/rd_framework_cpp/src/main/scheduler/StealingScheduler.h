@@ -0,0 +1,91 @@
+#ifndef RD_CPP_STEALINGSCHEDULER_H
+#define RD_CPP_STEALINGSCHEDULER_H
+
+#include "scheduler/base/IScheduler.h"
+#include "lifetime/Lifetime.h"
+
+#include "spdlog/spdlog.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Single threaded scheduler whose actions may also be executed by the threads waiting for it.
+ *
+ * A thread that joins the scheduler (see \ref join and \ref flush) executes the queued actions itself instead of
+ * blocking until the scheduler thread gets to them. Actions are still executed one at a time and in order, the thread
+ * executing an action is the active thread of the scheduler for its duration. A thread executing an action may join
+ * the scheduler too, the actions are executed reentrantly then.
+ */
+class RD_FRAMEWORK_API StealingScheduler final : public IScheduler
+{
+	std::shared_ptr<spdlog::logger> log;
+	std::string name;
+
+	mutable std::mutex lock;
+	std::condition_variable changed;
+	std::deque<std::function<void()>> actions;
+	// the thread executing an action, the actions are only executed by it until it's done
+	std::thread::id executing_thread;
+	int32_t executing_depth = 0;
+	bool stopped = false;
+
+	std::thread worker;
+
+	Lifetime lifetime;
+	LifetimeImpl::counter_t stop_action_id = 0;
+
+	bool can_execute() const;
+
+	/**
+	 * \brief Executes the next action if this thread may do it now, [guard] is unlocked while it runs.
+	 */
+	bool execute_next(std::unique_lock<std::mutex>& guard);
+
+	void run();
+
+	/**
+	 * \brief Stops the thread after it has executed the queued actions, waits for it unless called by an action.
+	 */
+	void stop();
+
+public:
+	// region ctor/dtor
+
+	StealingScheduler(Lifetime lifetime, std::string name);
+
+	StealingScheduler(StealingScheduler const&) = delete;
+
+	StealingScheduler& operator=(StealingScheduler const&) = delete;
+
+	virtual ~StealingScheduler();
+	// endregion
+
+	/**
+	 * \brief Queues [action], or executes it on the calling thread along with the rest of the queue once stopped.
+	 */
+	void queue(std::function<void()> action) override;
+
+	/**
+	 * \brief Executes the queued actions on the calling thread until there are none.
+	 */
+	void flush() override;
+
+	bool join(std::function<bool()> const& condition, std::chrono::milliseconds timeout) override;
+
+	bool is_active() const override;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_STEALINGSCHEDULER_H
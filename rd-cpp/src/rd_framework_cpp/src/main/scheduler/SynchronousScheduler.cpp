@@ -6,6 +6,11 @@ namespace rd
 {
 static thread_local int32_t SynchronousScheduler_active_count = 0;
 
+SynchronousScheduler::SynchronousScheduler()
+{
+	executes_inline = true;
+}
+
 void SynchronousScheduler::queue(std::function<void()> action)
 {
 	util::increment_guard<int32_t> guard(SynchronousScheduler_active_count);
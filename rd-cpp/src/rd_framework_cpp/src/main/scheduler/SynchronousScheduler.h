@@ -14,7 +14,7 @@ class RD_FRAMEWORK_API SynchronousScheduler : public IScheduler
 public:
 	// region ctor/dtor
 
-	SynchronousScheduler() = default;
+	SynchronousScheduler();
 
 	SynchronousScheduler(SynchronousScheduler const&) = delete;
 
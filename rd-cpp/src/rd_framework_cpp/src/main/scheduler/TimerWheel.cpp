@@ -0,0 +1,294 @@
+#include "TimerWheel.h"
+
+#include "util/thread_util.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace rd
+{
+struct TimerWheel::Timer
+{
+	Lifetime lifetime;
+	LifetimeImpl::counter_t termination_id = -1;
+	std::function<void()> action;
+	// zero for timers firing once
+	clock::duration interval;
+
+	uint64_t expiry = 0;
+	size_t level = 0;
+	size_t slot = 0;
+	// whether it's in a slot, guarded by the lock of the wheel
+	bool scheduled = false;
+
+	// held while the action is executed, so the termination of the lifetime can wait for it
+	std::mutex running;
+	std::atomic_bool cancelled{false};
+
+	Timer(Lifetime lifetime, std::function<void()> action, clock::duration interval)
+		: lifetime(std::move(lifetime)), action(std::move(action)), interval(interval)
+	{
+	}
+};
+
+constexpr size_t TimerWheel::LEVELS;
+constexpr size_t TimerWheel::SLOT_BITS;
+constexpr size_t TimerWheel::SLOTS;
+
+TimerWheel::TimerWheel(clock::duration resolution) : resolution(resolution), start(clock::now())
+{
+	worker = std::thread([this] { run(); });
+}
+
+TimerWheel::~TimerWheel()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopped = true;
+	}
+	changed.notify_all();
+	worker.join();
+}
+
+TimerWheel& TimerWheel::instance()
+{
+	static TimerWheel wheel;
+	return wheel;
+}
+
+uint64_t TimerWheel::ticks_until(clock::time_point time) const
+{
+	if (time <= start)
+	{
+		return 0;
+	}
+	// rounded up, so the timers never fire early
+	return static_cast<uint64_t>((time - start + resolution - clock::duration(1)) / resolution);
+}
+
+void TimerWheel::insert(std::shared_ptr<Timer> const& timer)
+{
+	// the lowest level on which the timer and the current tick differ in the slot only
+	const uint64_t difference = timer->expiry ^ current_tick;
+	size_t level = 0;
+	while (level + 1 < LEVELS && (difference >> (SLOT_BITS * (level + 1))) != 0)
+	{
+		++level;
+	}
+	timer->level = level;
+	timer->slot = static_cast<size_t>(timer->expiry >> (SLOT_BITS * level)) & (SLOTS - 1);
+	timer->scheduled = true;
+	levels[level][timer->slot].push_back(timer);
+	++timers_count;
+}
+
+void TimerWheel::remove(Timer& timer)
+{
+	auto& slot = levels[timer.level][timer.slot];
+	auto it = std::find_if(slot.begin(), slot.end(), [&timer](std::shared_ptr<Timer> const& t) { return t.get() == &timer; });
+	if (it != slot.end())
+	{
+		std::swap(*it, slot.back());
+		slot.pop_back();
+		--timers_count;
+	}
+	timer.scheduled = false;
+}
+
+void TimerWheel::advance(std::vector<std::shared_ptr<Timer>>& due)
+{
+	++current_tick;
+
+	// the slots of the upper levels whose turn has come are spread over the levels below, highest first
+	size_t top = 0;
+	while (top + 1 < LEVELS && (current_tick & ((uint64_t(1) << (SLOT_BITS * (top + 1))) - 1)) == 0)
+	{
+		++top;
+	}
+	for (size_t level = top; level > 0; --level)
+	{
+		slot_t moved;
+		moved.swap(levels[level][static_cast<size_t>(current_tick >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+		timers_count -= moved.size();
+		for (auto const& timer : moved)
+		{
+			insert(timer);
+		}
+	}
+
+	auto& slot = levels[0][static_cast<size_t>(current_tick) & (SLOTS - 1)];
+	timers_count -= slot.size();
+	for (auto& timer : slot)
+	{
+		timer->scheduled = false;
+		due.push_back(std::move(timer));
+	}
+	slot.clear();
+}
+
+uint64_t TimerWheel::next_tick() const
+{
+	if (timers_count == 0)
+	{
+		return std::numeric_limits<uint64_t>::max();
+	}
+	const uint64_t next_move = (current_tick | (SLOTS - 1)) + 1;
+	for (uint64_t tick = current_tick + 1; tick < next_move; ++tick)
+	{
+		if (!levels[0][static_cast<size_t>(tick) & (SLOTS - 1)].empty())
+		{
+			return tick;
+		}
+	}
+	return next_move;
+}
+
+void TimerWheel::add(Lifetime lifetime, clock::duration delay, clock::duration interval, std::function<void()> action)
+{
+	if (lifetime->is_terminated())
+	{
+		return;
+	}
+	auto timer = std::make_shared<Timer>(lifetime, std::move(action), interval);
+	// the wheel owns the timer, the lifetime doesn't keep it after it has fired
+	std::weak_ptr<Timer> weak_timer = timer;
+	timer->termination_id = lifetime->add_action([this, weak_timer] {
+		if (auto t = weak_timer.lock())
+		{
+			cancel(t);
+		}
+	});
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (timer->cancelled)
+		{
+			return;
+		}
+		const uint64_t now = ticks_until(clock::now());
+		if (timers_count == 0)
+		{
+			// nothing to fire on the way
+			current_tick = std::max(current_tick, now);
+		}
+		timer->expiry = std::max(current_tick + 1, ticks_until(clock::now() + delay));
+		insert(timer);
+	}
+	changed.notify_all();
+}
+
+void TimerWheel::cancel(std::shared_ptr<Timer> const& timer)
+{
+	timer->cancelled = true;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (timer->scheduled)
+		{
+			remove(*timer);
+		}
+	}
+	if (!is_active())
+	{
+		std::lock_guard<std::mutex> running(timer->running);
+	}
+}
+
+void TimerWheel::fire(std::vector<std::shared_ptr<Timer>>& due)
+{
+	for (auto const& timer : due)
+	{
+		std::lock_guard<std::mutex> running(timer->running);
+		if (timer->cancelled)
+		{
+			continue;
+		}
+		try
+		{
+			timer->action();
+		}
+		catch (std::exception const& e)
+		{
+			spdlog::error("Timer action failed | {}", e.what());
+		}
+	}
+}
+
+void TimerWheel::run()
+{
+	util::set_thread_name("TimerWheel");
+
+	std::unique_lock<std::mutex> guard(lock);
+	std::vector<std::shared_ptr<Timer>> due;
+	while (!stopped)
+	{
+		const uint64_t target = next_tick();
+		if (target == std::numeric_limits<uint64_t>::max())
+		{
+			changed.wait(guard);
+			continue;
+		}
+		const uint64_t now = ticks_until(clock::now());
+		if (now < target)
+		{
+			// woken up early by a new timer, the next tick is looked for again
+			changed.wait_until(guard, start + resolution * target);
+			continue;
+		}
+
+		while (current_tick < now && timers_count > 0)
+		{
+			advance(due);
+		}
+		current_tick = std::max(current_tick, now);
+		if (due.empty())
+		{
+			continue;
+		}
+
+		guard.unlock();
+		fire(due);
+		for (auto const& timer : due)
+		{
+			if (timer->interval == clock::duration::zero())
+			{
+				timer->lifetime->remove_action(timer->termination_id);
+			}
+		}
+		guard.lock();
+
+		for (auto const& timer : due)
+		{
+			if (timer->interval != clock::duration::zero() && !timer->cancelled && !timer->scheduled)
+			{
+				timer->expiry = std::max(current_tick + 1, ticks_until(clock::now() + timer->interval));
+				insert(timer);
+			}
+		}
+		due.clear();
+	}
+}
+
+void TimerWheel::schedule(Lifetime lifetime, clock::duration delay, std::function<void()> action)
+{
+	add(std::move(lifetime), delay, clock::duration::zero(), std::move(action));
+}
+
+void TimerWheel::schedule_repeating(Lifetime lifetime, clock::duration interval, std::function<void()> action)
+{
+	add(std::move(lifetime), interval, std::max(interval, clock::duration(1)), std::move(action));
+}
+
+size_t TimerWheel::size() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return timers_count;
+}
+
+bool TimerWheel::is_active() const
+{
+	return worker.get_id() == std::this_thread::get_id();
+}
+}	 // namespace rd
@@ -0,0 +1,126 @@
+#ifndef RD_CPP_TIMERWHEEL_H
+#define RD_CPP_TIMERWHEEL_H
+
+#include "lifetime/Lifetime.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Executes delayed and periodic actions of any number of components on a single thread.
+ *
+ * \details Timers are kept in a hierarchical wheel: LEVELS levels of SLOTS slots, each level counting in ticks of the
+ * size of the whole level below it. Scheduling and cancelling a timer takes constant time, a timer moves down a level
+ * at most LEVELS - 1 times before it fires. The thread sleeps until the next occupied slot or the next move down.
+ *
+ * Actions are executed on the thread of the wheel, one at a time, so they should be short: anything else should be
+ * queued to a scheduler. A timer is cancelled by the termination of its lifetime, which waits for its action if it's
+ * being executed on another thread.
+ */
+class RD_FRAMEWORK_API TimerWheel final
+{
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr size_t LEVELS = 4;
+	static constexpr size_t SLOT_BITS = 6;
+	static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+
+private:
+	struct Timer;
+
+	using slot_t = std::vector<std::shared_ptr<Timer>>;
+
+	const clock::duration resolution;
+	const clock::time_point start;
+
+	mutable std::mutex lock;
+	std::condition_variable changed;
+	std::array<std::array<slot_t, SLOTS>, LEVELS> levels;
+	// the last tick whose timers have been fired
+	uint64_t current_tick = 0;
+	size_t timers_count = 0;
+	bool stopped = false;
+
+	std::thread worker;
+
+	uint64_t ticks_until(clock::time_point time) const;
+
+	void insert(std::shared_ptr<Timer> const& timer);
+
+	void remove(Timer& timer);
+
+	/**
+	 * \brief Moves to the next tick and collects the timers which are due at it.
+	 */
+	void advance(std::vector<std::shared_ptr<Timer>>& due);
+
+	/**
+	 * \return the tick the thread has something to do at.
+	 */
+	uint64_t next_tick() const;
+
+	void add(Lifetime lifetime, clock::duration delay, clock::duration interval, std::function<void()> action);
+
+	void cancel(std::shared_ptr<Timer> const& timer);
+
+	void fire(std::vector<std::shared_ptr<Timer>>& due);
+
+	void run();
+
+public:
+	// region ctor/dtor
+
+	explicit TimerWheel(clock::duration resolution = std::chrono::milliseconds(1));
+
+	TimerWheel(TimerWheel const&) = delete;
+
+	TimerWheel& operator=(TimerWheel const&) = delete;
+
+	~TimerWheel();
+	// endregion
+
+	/**
+	 * \brief The wheel shared by the whole process, its thread is started by the first call.
+	 */
+	static TimerWheel& instance();
+
+	/**
+	 * \brief Executes [action] once after [delay], unless [lifetime] is terminated by then.
+	 */
+	void schedule(Lifetime lifetime, clock::duration delay, std::function<void()> action);
+
+	/**
+	 * \brief Executes [action] every [interval], measured from the end of the previous execution, until [lifetime] is
+	 * terminated.
+	 */
+	void schedule_repeating(Lifetime lifetime, clock::duration interval, std::function<void()> action);
+
+	/**
+	 * \return the number of timers which are neither fired nor cancelled yet.
+	 */
+	size_t size() const;
+
+	/**
+	 * \return whether the calling thread is the one executing the actions.
+	 */
+	bool is_active() const;
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_TIMERWHEEL_H
@@ -28,4 +28,18 @@ void IScheduler::invoke_or_queue(std::function<void()> action)
 		queue(action);
 	}
 }
+
+bool IScheduler::join(std::function<bool()> const& condition, std::chrono::milliseconds timeout)
+{
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+	while (!condition())
+	{
+		if (std::chrono::steady_clock::now() >= deadline)
+		{
+			return false;
+		}
+		std::this_thread::yield();
+	}
+	return true;
+}
 }	 // namespace rd
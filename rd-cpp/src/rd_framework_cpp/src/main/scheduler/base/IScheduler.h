@@ -1,6 +1,7 @@
 #ifndef RD_CPP_ISCHEDULER_H
 #define RD_CPP_ISCHEDULER_H
 
+#include <chrono>
 #include <functional>
 #include <thread>
 
@@ -36,6 +37,11 @@ public:
 	// TO-DO
 	bool out_of_order_execution = false;
 
+	/**
+	 * \brief Whether \ref queue executes the action before returning, so it may use data that lives for the call only.
+	 */
+	bool executes_inline = false;
+
 	virtual void assert_thread() const;
 
 	/**
@@ -46,6 +52,13 @@ public:
 
 	virtual void flush() = 0;
 
+	/**
+	 * \brief Waits until [condition] holds or [timeout] passes. Schedulers that can execute their actions on the
+	 * waiting thread do so instead of blocking it.
+	 * \return the last value of [condition].
+	 */
+	virtual bool join(std::function<bool()> const& condition, std::chrono::milliseconds timeout);
+
 	virtual bool is_active() const = 0;
 
 	std::thread::id get_thread_id() const
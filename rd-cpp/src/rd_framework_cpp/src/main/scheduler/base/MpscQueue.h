@@ -0,0 +1,113 @@
+#ifndef RD_CPP_MPSCQUEUE_H
+#define RD_CPP_MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace rd
+{
+/**
+ * \brief Link of the elements of \ref MpscQueue, the elements derive from it.
+ */
+class MpscQueueNode
+{
+	template <typename T>
+	friend class MpscQueue;
+
+	std::atomic<MpscQueueNode*> next{nullptr};
+};
+
+/**
+ * \brief Intrusive unbounded queue with many producers and a single consumer, neither of them locks or allocates.
+ *
+ * \details A push is a single exchange, so producers never wait for each other or for the consumer. The queue doesn't
+ * own its elements: [pop] hands an element back to the consumer, which frees it.
+ * [pop] may return nullptr while a push is in progress even though an element was pushed before it, the consumer
+ * should retry later in this case.
+ */
+template <typename T>
+class MpscQueue
+{
+	static_assert(std::is_base_of<MpscQueueNode, T>::value, "Elements of MpscQueue must derive from MpscQueueNode");
+
+	static constexpr size_t CACHE_LINE_SIZE = 64;
+
+	// written by the producers
+	std::atomic<MpscQueueNode*> head;
+	char head_padding[CACHE_LINE_SIZE - sizeof(std::atomic<MpscQueueNode*>)];
+	// written by the consumer only
+	MpscQueueNode* tail;
+	// stays in the queue when it's empty, so the producers never see it without a head
+	MpscQueueNode stub;
+
+	void push_node(MpscQueueNode* node)
+	{
+		node->next.store(nullptr, std::memory_order_relaxed);
+		MpscQueueNode* previous = head.exchange(node, std::memory_order_acq_rel);
+		// the node is unreachable for the consumer until it's linked
+		previous->next.store(node, std::memory_order_release);
+	}
+
+public:
+	// region ctor/dtor
+
+	MpscQueue() : head(&stub), tail(&stub)
+	{
+	}
+
+	MpscQueue(MpscQueue const&) = delete;
+
+	MpscQueue& operator=(MpscQueue const&) = delete;
+	// endregion
+
+	/**
+	 * \brief May be called from any thread.
+	 */
+	void push(T* element)
+	{
+		push_node(element);
+	}
+
+	/**
+	 * \brief May be called from the consumer thread only.
+	 * \return the first element in the queue, or nullptr if there are none which are completely pushed.
+	 */
+	T* pop()
+	{
+		MpscQueueNode* first = tail;
+		MpscQueueNode* next = first->next.load(std::memory_order_acquire);
+		if (first == &stub)
+		{
+			if (next == nullptr)
+			{
+				return nullptr;
+			}
+			tail = next;
+			first = next;
+			next = next->next.load(std::memory_order_acquire);
+		}
+		if (next != nullptr)
+		{
+			tail = next;
+			return static_cast<T*>(first);
+		}
+		if (first != head.load(std::memory_order_acquire))
+		{
+			// a producer has taken the head but not linked it yet
+			return nullptr;
+		}
+		// the last element is handed out only with the stub behind it
+		push_node(&stub);
+		next = first->next.load(std::memory_order_acquire);
+		if (next != nullptr)
+		{
+			tail = next;
+			return static_cast<T*>(first);
+		}
+		return nullptr;
+	}
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_MPSCQUEUE_H
@@ -1,38 +1,103 @@
 #include "SingleThreadSchedulerBase.h"
 
 #include "util/core_util.h"
+#include "util/thread_util.h"
 
-#include "ctpl_stl.h"
 #include "spdlog/include/spdlog/sinks/stdout_color_sinks.h"
 
 namespace rd
 {
-SingleThreadSchedulerBase::PoolTask::PoolTask(std::function<void()> f, SingleThreadSchedulerBase* scheduler)
-	: f(std::move(f)), scheduler(scheduler)
+SingleThreadSchedulerBase::SingleThreadSchedulerBase(std::string name, size_t spin_count)
+	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic))
+	, name(std::move(name))
+	, spin_count(spin_count)
+{
+	{
+		// the thread takes the lock before it executes anything, so it sees its id assigned
+		std::lock_guard<std::mutex> guard(lock);
+		worker = std::thread([this] { run(); });
+		thread_id = worker.get_id();
+	}
+}
+
+bool SingleThreadSchedulerBase::drain()
 {
+	bool executed = false;
+	while (Task* task = tasks.pop())
+	{
+		try
+		{
+			task->action();
+		}
+		catch (std::exception const& e)
+		{
+			log->error("Background task failed, scheduler={} | {}", name, e.what());
+		}
+		delete task;
+		--tasks_executing;
+		executed = true;
+	}
+	return executed;
 }
 
-void SingleThreadSchedulerBase::PoolTask::operator()(int id) const
+void SingleThreadSchedulerBase::park()
 {
-	try
+	std::unique_lock<std::mutex> guard(lock);
+	// seen by the producers after they have counted their action, so either they notify or it's seen here
+	sleeping = true;
+	parked.wait(guard, [this] { return tasks_executing != 0 || stopped; });
+	sleeping = false;
+}
+
+void SingleThreadSchedulerBase::run()
+{
+	util::set_thread_name(name.c_str());
 	{
-		f();
-		--scheduler->tasks_executing;
+		std::lock_guard<std::mutex> guard(lock);
 	}
-	catch (std::exception const& e)
+
+	while (true)
 	{
-		scheduler->log->error("Background task failed, scheduler={}, thread_id={} | {}", scheduler->name, id, e.what());
-		--scheduler->tasks_executing;
+		if (drain())
+		{
+			continue;
+		}
+		if (tasks_executing != 0)
+		{
+			// an action is counted but not linked into the queue yet
+			std::this_thread::yield();
+			continue;
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			if (stopped)
+			{
+				return;
+			}
+		}
+		for (size_t i = 0; i < spin_count && tasks_executing == 0; ++i)
+		{
+			std::this_thread::yield();
+		}
+		if (tasks_executing == 0)
+		{
+			park();
+		}
 	}
 }
 
-SingleThreadSchedulerBase::SingleThreadSchedulerBase(std::string name)
-	: log(spdlog::stderr_color_mt<spdlog::synchronous_factory>(name, spdlog::color_mode::automatic))
-	, name(std::move(name))
-	, pool(std::make_unique<ctpl::thread_pool>(1))
+void SingleThreadSchedulerBase::stop()
 {
-	RD_ASSERT_THROW_MSG(pool->size() == 1, "Thread pool wasn't properly initalized");
-	thread_id = pool->get_thread(0).get_id();
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopped = true;
+	}
+	parked.notify_one();
+	// stopped by its own action, the thread finishes the queue and exits, the destructor joins it
+	if (!is_active() && worker.joinable())
+	{
+		worker.join();
+	}
 }
 
 void SingleThreadSchedulerBase::flush()
@@ -48,8 +113,15 @@ void SingleThreadSchedulerBase::flush()
 void SingleThreadSchedulerBase::queue(std::function<void()> action)
 {
 	++tasks_executing;
-	PoolTask task(action, this);
-	pool->push(std::move(task));
+	tasks.push(new Task(std::move(action)));
+	if (sleeping)
+	{
+		// the consumer is either about to check for actions or waiting, it can't miss the notification
+		{
+			std::lock_guard<std::mutex> guard(lock);
+		}
+		parked.notify_one();
+	}
 }
 
 bool SingleThreadSchedulerBase::is_active() const
@@ -57,5 +129,18 @@ bool SingleThreadSchedulerBase::is_active() const
 	return thread_id == std::this_thread::get_id();
 }
 
-SingleThreadSchedulerBase::~SingleThreadSchedulerBase() = default;
+SingleThreadSchedulerBase::~SingleThreadSchedulerBase()
+{
+	RD_ASSERT_MSG(!is_active(), "Scheduler " + name + " can't be destroyed by its own thread");
+	stop();
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+	// actions queued after the thread has stopped are never executed
+	while (Task* task = tasks.pop())
+	{
+		delete task;
+	}
+}
 }	 // namespace rd
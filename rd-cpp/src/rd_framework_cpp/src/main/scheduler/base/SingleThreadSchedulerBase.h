@@ -2,46 +2,85 @@
 #define RD_CPP_SINGLETHREADSCHEDULERBASE_H
 
 #include "scheduler/base/IScheduler.h"
+#include "scheduler/base/MpscQueue.h"
 #include "lifetime/Lifetime.h"
 #include "spdlog/spdlog.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 #include <rd_framework_export.h>
 
 RD_PUSH_STL_EXPORTS_WARNINGS
 
-namespace ctpl
-{
-class thread_pool;
-}
-
 namespace rd
 {
+/**
+ * \brief Executes the queued actions in order on a thread of its own.
+ *
+ * \details Actions are queued without locks, each one is a single allocation holding the std::function, whose
+ * small-buffer storage keeps small captures in place. The thread executes all the actions it finds before it looks for
+ * more, then spins for [spin_count] rounds and parks until an action is queued.
+ */
 class RD_FRAMEWORK_API SingleThreadSchedulerBase : public IScheduler
 {
 protected:
 	std::shared_ptr<spdlog::logger> log;
 	std::string name;
 
+	// the actions queued and not executed yet, including the one being executed
 	std::atomic_uint32_t tasks_executing{0};
 	std::atomic_uint32_t active{0};
-	std::unique_ptr<ctpl::thread_pool> pool;
 
-	class PoolTask
-	{
-		std::function<void()> f;
-		SingleThreadSchedulerBase* scheduler;
+	/**
+	 * \brief Stops the thread after it has executed the actions queued before, and waits for it unless called by it.
+	 *
+	 * Derived schedulers call it from their destructors too, so that no action runs after their state is destroyed.
+	 */
+	void stop();
 
-	public:
-		explicit PoolTask(std::function<void()> f, SingleThreadSchedulerBase* scheduler);
+private:
+	struct Task : MpscQueueNode
+	{
+		std::function<void()> action;
 
-		void operator()(int id) const;
+		explicit Task(std::function<void()> action) : action(std::move(action))
+		{
+		}
 	};
 
+	MpscQueue<Task> tasks;
+	size_t spin_count;
+
+	std::mutex lock;
+	std::condition_variable parked;
+	std::atomic_bool sleeping{false};
+	bool stopped = false;
+
+	std::thread worker;
+
+	/**
+	 * \brief Executes the actions in the queue until it's empty.
+	 * \return whether any were executed.
+	 */
+	bool drain();
+
+	/**
+	 * \brief Waits until an action is queued or the scheduler is stopped.
+	 */
+	void park();
+
+	void run();
+
 public:
 	// region ctor/dtor
-	SingleThreadSchedulerBase(std::string name);
+	explicit SingleThreadSchedulerBase(std::string name, size_t spin_count = 0);
+
+	SingleThreadSchedulerBase(SingleThreadSchedulerBase const&) = delete;
+
+	SingleThreadSchedulerBase& operator=(SingleThreadSchedulerBase const&) = delete;
 
 	virtual ~SingleThreadSchedulerBase();
 	// endregion
@@ -1,6 +1,7 @@
 #ifndef RD_CPP_ISERIALIZABLE_H
 #define RD_CPP_ISERIALIZABLE_H
 
+#include <cstddef>
 #include <string>
 
 #include <rd_framework_export.h>
@@ -24,6 +25,14 @@ public:
 	virtual ~ISerializable() = default;
 
 	virtual void write(SerializationCtx& ctx, Buffer& buffer) const = 0;
+
+	/**
+	 * \brief Expected number of bytes written by \ref write, 0 if unknown. Lets the buffer grow once before writing.
+	 */
+	virtual size_t serialized_size_hint() const
+	{
+		return 0;
+	}
 };
 
 /**
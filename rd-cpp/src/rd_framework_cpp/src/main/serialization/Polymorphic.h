@@ -3,6 +3,7 @@
 
 #include "protocol/Buffer.h"
 #include "base/RdReactiveBase.h"
+#include "serialization/ISerializable.h"
 
 #include <type_traits>
 
@@ -30,13 +31,31 @@ public:
 
 	inline static void write(SerializationCtx& ctx, Buffer& buffer, T const& value)
 	{
+		require_size_hint(buffer, value);
 		value.write(ctx, buffer);
 	}
 
 	inline static void write(SerializationCtx& ctx, Buffer& buffer, Wrapper<T> const& value)
 	{
+		require_size_hint(buffer, *value);
 		value->write(ctx, buffer);
 	}
+
+private:
+	template <typename U>
+	inline static std::enable_if_t<util::is_base_of_v<ISerializable, U>> require_size_hint(Buffer& buffer, U const& value)
+	{
+		const size_t hint = value.serialized_size_hint();
+		if (hint > 0)
+		{
+			buffer.require_available(hint);
+		}
+	}
+
+	template <typename U>
+	inline static std::enable_if_t<!util::is_base_of_v<ISerializable, U>> require_size_hint(Buffer&, U const&)
+	{
+	}
 };
 
 template <typename T>
@@ -137,6 +156,21 @@ public:
 	}
 };
 
+template <>
+class Polymorphic<std::string>
+{
+public:
+	inline static std::string read(SerializationCtx& /*ctx*/, Buffer& buffer)
+	{
+		return buffer.read_string();
+	}
+
+	inline static void write(SerializationCtx& /*ctx*/, Buffer& buffer, std::string const& value)
+	{
+		buffer.write_string(value);
+	}
+};
+
 template <>
 class Polymorphic<DateTime>
 {
@@ -5,7 +5,9 @@
 #include "RdTask.h"
 #include "RdTaskResult.h"
 #include "scheduler/SynchronousScheduler.h"
+#include "scheduler/TimerWheel.h"
 #include "WiredRdTask.h"
+#include "lifetime/LifetimeDefinition.h"
 
 #include <thread>
 
@@ -68,11 +70,9 @@ public:
 	{
 		auto task = start_internal(request, true, &SynchronousScheduler::Instance());
 		auto time_at_start = std::chrono::system_clock::now();
-		while (!task.has_value() && !(*bind_lifetime)->is_terminated() &&
-			   ((std::chrono::system_clock::now() - time_at_start) < timeout))
-		{
-			std::this_thread::yield();
-		}
+		// a stealing scheduler executes its queued actions on this thread meanwhile
+		get_default_scheduler()->join(
+			[this, &task] { return task.has_value() || (*bind_lifetime)->is_terminated(); }, timeout);
 		spdlog::debug("Time elapsed: {}, has_value={}", to_string(std::chrono::system_clock::now() - time_at_start),
 			to_string(task.has_value()));
 		task.value_or_throw().unwrap();	   // check for existing value
@@ -97,6 +97,33 @@ public:
 		return start_internal(request, false, responseScheduler ? responseScheduler : get_default_scheduler());
 	}
 
+	/**
+	 * \brief Same as \ref start, but the task is faulted if the result doesn't come within [timeout]. The timeout is
+	 * tracked by the \ref TimerWheel and the fault is set on the response scheduler. The timer is cancelled as soon as
+	 * the task has a result.
+	 */
+	WiredRdTask<TRes, ResSer> start(
+		TReq const& request, std::chrono::milliseconds timeout, IScheduler* responseScheduler = nullptr) const
+	{
+		IScheduler* scheduler = responseScheduler ? responseScheduler : get_default_scheduler();
+		auto task = start_internal(request, false, scheduler);
+		// owned by the subscription to the result, which ends with it
+		auto timeout_definition = std::make_shared<LifetimeDefinition>(*bind_lifetime);
+		const Lifetime timeout_lifetime = timeout_definition->lifetime;
+		// the result is set on the response scheduler
+		scheduler->invoke_or_queue([task, timeout_definition] {
+			task.advise(timeout_definition->lifetime,
+				[timeout_definition](typename WiredRdTask<TRes, ResSer>::result_type const&) { timeout_definition->terminate(); });
+		});
+		TimerWheel::instance().schedule(timeout_lifetime, timeout, [task, scheduler, timeout] {
+			scheduler->queue([task, timeout] {
+				const std::runtime_error error("Call timed out after " + to_string(timeout));
+				task.set_result_if_empty(typename WiredRdTask<TRes, ResSer>::result_type::Fault(error));
+			});
+		});
+		return task;
+	}
+
 	void on_wire_received(Buffer buffer) const override
 	{
 		RD_ASSERT_MSG(false, "RdCall.on_wire_received called")
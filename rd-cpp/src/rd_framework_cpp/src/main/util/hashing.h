@@ -18,9 +18,43 @@ constexpr constexpr_hash_t DEFAULT_HASH = 19;
 constexpr constexpr_hash_t HASH_FACTOR = 31;
 
 // PLEASE DO NOT CHANGE IT!!! IT'S EXACTLY THE SAME ON C# SIDE
+// hash = hash * HASH_FACTOR + c for every char, four chars a step to shorten the chain of multiplications
 constexpr hash_t hashImpl(constexpr_hash_t initial, char const* begin, char const* end)
 {
-	return (begin == end) ? initial : hashImpl(initial * HASH_FACTOR + *begin, begin + 1, end);
+	constexpr constexpr_hash_t F1 = HASH_FACTOR;
+	constexpr constexpr_hash_t F2 = F1 * HASH_FACTOR;
+	constexpr constexpr_hash_t F3 = F2 * HASH_FACTOR;
+	constexpr constexpr_hash_t F4 = F3 * HASH_FACTOR;
+
+	constexpr_hash_t hash = initial;
+	for (; end - begin >= 4; begin += 4)
+	{
+		hash = hash * F4 + static_cast<constexpr_hash_t>(begin[0]) * F3 + static_cast<constexpr_hash_t>(begin[1]) * F2 +
+			   static_cast<constexpr_hash_t>(begin[2]) * F1 + static_cast<constexpr_hash_t>(begin[3]);
+	}
+	for (; begin != end; ++begin)
+	{
+		hash = hash * F1 + static_cast<constexpr_hash_t>(*begin);
+	}
+	return static_cast<hash_t>(hash);
+}
+
+/**
+ * \brief HASH_FACTOR to the power of \p n, what a hash is multiplied by when \p n chars are mixed in.
+ */
+constexpr constexpr_hash_t hashFactorPower(size_t n)
+{
+	constexpr_hash_t res = 1;
+	constexpr_hash_t base = HASH_FACTOR;
+	for (; n > 0; n >>= 1)
+	{
+		if (n & 1)
+		{
+			res *= base;
+		}
+		base *= base;
+	}
+	return res;
 }
 
 /*template<size_t N>
@@ -30,7 +64,7 @@ constexpr hash_t getPlatformIndependentHash(char const (&that)[N], constexpr_has
 
 constexpr hash_t getPlatformIndependentHash(string_view that, constexpr_hash_t initial = DEFAULT_HASH)
 {
-	return static_cast<hash_t>(hashImpl(initial, &that[0], &that[that.length() - 1] + 1));
+	return hashImpl(initial, that.data(), that.data() + that.size());
 }
 
 constexpr hash_t getPlatformIndependentHash(int32_t const& that, constexpr_hash_t initial = DEFAULT_HASH)
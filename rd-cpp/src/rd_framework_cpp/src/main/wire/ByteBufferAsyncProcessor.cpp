@@ -5,10 +5,10 @@
 
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <algorithm>
+
 namespace rd
 {
-size_t ByteBufferAsyncProcessor::INITIAL_CAPACITY = 1024 * 1024;
-
 size_t ByteBufferAsyncProcessor::DEFAULT_CHUNK_SIZE = 16370;
 
 std::shared_ptr<spdlog::logger> ByteBufferAsyncProcessor::logger =
@@ -18,7 +18,16 @@ ByteBufferAsyncProcessor::ByteBufferAsyncProcessor(
 	std::string id, std::function<bool(Buffer::ByteArray const&, sequence_number_t)> processor, size_t chunk_size)
 	: id(std::move(id)), processor(std::move(processor)), chunk_size(chunk_size)
 {
-	data.reserve(INITIAL_CAPACITY);
+}
+
+void ByteBufferAsyncProcessor::set_resend_processor(resend_processor_t processor)
+{
+	resend_processor = std::move(processor);
+}
+
+void ByteBufferAsyncProcessor::set_heartbeat_processor(std::function<void()> processor)
+{
+	heartbeat_processor = std::move(processor);
 }
 
 void ByteBufferAsyncProcessor::cleanup0()
@@ -69,13 +78,66 @@ bool ByteBufferAsyncProcessor::terminate0(time_t timeout, StateKind state_to_set
 	return success;
 }
 
-void ByteBufferAsyncProcessor::add_data(std::vector<Buffer::ByteArray>&& new_data)
+bool ByteBufferAsyncProcessor::lanes_empty() const
+{
+	return std::all_of(lanes.begin(), lanes.end(), [](std::deque<Message> const& lane) { return lane.empty(); });
+}
+
+/**
+ * @brief Splits [message] into chunks at the end of the queue, unless it has been superseded. Should be called under
+ * lock and queue_lock.
+ */
+void ByteBufferAsyncProcessor::add_chunks(Message&& lane_message)
+{
+	if (!lane_message.coalescing_key.empty())
+	{
+		auto it = latest.find(lane_message.coalescing_key);
+		if (it != latest.end() && it->second == &lane_message.data)
+		{
+			latest.erase(it);
+		}
+	}
+	Buffer::ByteArray& message = lane_message.data;
+	const size_t count = message.size();
+	if (count == 0)
+	{
+		return;
+	}
+	if (count <= chunk_size)
+	{
+		queue.emplace_back(std::move(message));
+		return;
+	}
+
+	logger->debug("{}: splitting message of {} bytes into packages of {} bytes", id, count, chunk_size);
+	for (size_t ptr = 0; ptr < count; ptr += chunk_size)
+	{
+		const size_t rest = count - ptr;
+		const size_t copylen = rest < chunk_size ? rest : chunk_size;
+		queue.emplace_back(message.begin() + ptr, message.begin() + ptr + copylen);
+	}
+}
+
+void ByteBufferAsyncProcessor::add_data()
 {
 	std::lock_guard<decltype(queue_lock)> guard(queue_lock);
-	std::move(new_data.begin(), new_data.end(), std::back_inserter(queue));
-	//		for (auto &&item : new_data) {
-	//			queue.emplace(std::move(item));
-	//		}
+	for (auto priority : {SendPriority::Control, SendPriority::Interactive})
+	{
+		auto& lane = lanes[static_cast<size_t>(priority)];
+		for (auto& message : lane)
+		{
+			add_chunks(std::move(message));
+		}
+		lane.clear();
+	}
+
+	// the chunks of a message are sent contiguously, so the other lanes overtake bulk messages between the messages
+	auto& bulk = lanes[static_cast<size_t>(SendPriority::Bulk)];
+	if (queue.empty() && !bulk.empty())
+	{
+		add_chunks(std::move(bulk.front()));
+		bulk.pop_front();
+	}
 }
 
 /**
@@ -103,6 +165,11 @@ bool ByteBufferAsyncProcessor::reprocess()
 		logger->debug("{}: reprocessing waited for main processing", id);
 
 		cleanup_pending_queue();
+		if (resend_processor && !pending_queue.empty())
+		{
+			logger->debug("{}: resending {} packages", id, pending_queue.size());
+			return resend_processor(pending_queue, current_seqn);
+		}
 		for (size_t i = 0; i < pending_queue.size(); ++i)
 		{
 			auto const& item = pending_queue[i];
@@ -124,8 +191,17 @@ void ByteBufferAsyncProcessor::process()
 
 		logger->debug("{}: processing started", id);
 
-		while (!queue.empty() && processor(queue.front(), max_sent_seqn + 1))
+		while (true)
 		{
+			// a long queue doesn't hold the heartbeat back, it goes between the packages
+			if (heartbeat_requested.exchange(false) && heartbeat_processor)
+			{
+				heartbeat_processor();
+			}
+			if (queue.empty() || !processor(queue.front(), max_sent_seqn + 1))
+			{
+				break;
+			}
 			++max_sent_seqn;
 			pending_queue.push_back(std::move(queue.front()));
 			queue.pop_front();
@@ -151,7 +227,7 @@ void ByteBufferAsyncProcessor::ThreadProc()
 				return;
 			}
 
-			while ((data.empty() && queue.empty()) || interrupt_balance != 0)
+			while ((lanes_empty() && queue.empty() && !heartbeat_requested) || interrupt_balance != 0)
 			{
 				if (state >= StateKind::Stopping)
 				{
@@ -167,11 +243,7 @@ void ByteBufferAsyncProcessor::ThreadProc()
 				}
 			}
 
-			if (!data.empty())
-			{
-				add_data(std::move(data));
-				data.clear();
-			}
+			add_data();
 		}
 
 		try
@@ -212,7 +284,7 @@ bool ByteBufferAsyncProcessor::terminate(time_t timeout)
 	return terminate0(timeout, StateKind::Terminating, "TERMINATE");
 }
 
-void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
+void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data, SendPriority priority, std::string coalescing_key)
 {
 	{
 		std::lock_guard<decltype(lock)> guard(lock);
@@ -222,26 +294,38 @@ void ByteBufferAsyncProcessor::put(Buffer::ByteArray new_data)
 			return;
 		}
 
-		const size_t count = new_data.size();
-
-		if (count <= chunk_size)
+		auto& lane = lanes[static_cast<size_t>(priority)];
+		if (coalescing_key.empty())
 		{
-			data.emplace_back(std::move(new_data));
+			lane.push_back(Message{std::move(new_data), {}});
 		}
 		else
 		{
-			logger->debug("{}: splitting message of {} bytes into packages of {} bytes", id, count, chunk_size);
-			for (size_t ptr = 0; ptr < count; ptr += chunk_size)
+			// the superseded message is left empty in its lane, the references to the others stay valid
+			Buffer::ByteArray*& latest_data = latest[coalescing_key];
+			if (latest_data != nullptr)
 			{
-				const size_t rest = count - ptr;
-				const size_t copylen = rest < chunk_size ? rest : chunk_size;
-				data.emplace_back(new_data.begin() + ptr, new_data.begin() + ptr + copylen);
+				logger->trace("{}: dropped superseded message of {} bytes", id, latest_data->size());
+				Buffer::ByteArray().swap(*latest_data);
 			}
+			lane.push_back(Message{std::move(new_data), std::move(coalescing_key)});
+			latest_data = &lane.back().data;
 		}
 	}
 	cv.notify_all();
 }
 
+void ByteBufferAsyncProcessor::request_heartbeat()
+{
+	heartbeat_requested = true;
+	{
+		// taken when it's free, so that the thread can't miss the request on its way to waiting; not waited for, since
+		// pausing and resuming hold it while sending. A request missed then goes with the next package or request.
+		std::unique_lock<decltype(lock)> guard(lock, std::try_to_lock);
+	}
+	cv.notify_all();
+}
+
 void ByteBufferAsyncProcessor::pause(const std::string& reason)
 {
 	std::lock_guard<decltype(lock)> guard(lock);
@@ -1,15 +1,20 @@
 #ifndef RD_CPP_BYTEBUFFERASYNCPROCESSOR_H
 #define RD_CPP_BYTEBUFFERASYNCPROCESSOR_H
 
+#include "base/SendPriority.h"
 #include "protocol/Buffer.h"
 #include "spdlog/spdlog.h"
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <string>
 #include <mutex>
 #include <condition_variable>
 #include <future>
 #include <list>
+#include <unordered_map>
 
 #include <rd_framework_export.h>
 
@@ -31,10 +36,11 @@ public:
 		Terminated
 	};
 
+	using resend_processor_t = std::function<bool(std::deque<Buffer::ByteArray> const&, sequence_number_t first_seqn)>;
+
 private:
 	using time_t = std::chrono::milliseconds;
 
-	static size_t INITIAL_CAPACITY;
 	static size_t DEFAULT_CHUNK_SIZE;
 
 	std::recursive_mutex lock;
@@ -43,6 +49,9 @@ private:
 	std::string id;
 
 	std::function<bool(Buffer::ByteArray const&, sequence_number_t seqn)> processor;
+	resend_processor_t resend_processor;
+	std::function<void()> heartbeat_processor;
+	std::atomic<bool> heartbeat_requested{false};
 
 	StateKind state{StateKind::Initialized};
 	static std::shared_ptr<spdlog::logger> logger;
@@ -51,7 +60,18 @@ private:
 	std::future<void> async_future;
 
 	size_t chunk_size = DEFAULT_CHUNK_SIZE;
-	std::vector<Buffer::ByteArray> data;
+
+	struct Message
+	{
+		// empty once superseded
+		Buffer::ByteArray data;
+		std::string coalescing_key;
+	};
+
+	// unchunked messages not yet moved to the queue, by SendPriority
+	std::array<std::deque<Message>, 3> lanes;
+	// the messages in the lanes which may still be superseded, by their coalescing keys
+	std::unordered_map<std::string, Buffer::ByteArray*> latest;
 	std::mutex queue_lock;
 	std::deque<Buffer::ByteArray> queue{};
 	std::deque<Buffer::ByteArray> pending_queue{};
@@ -76,7 +96,14 @@ private:
 
 	bool terminate0(time_t timeout, StateKind state_to_set, string_view action);
 
-	void add_data(std::vector<Buffer::ByteArray>&& new_data);
+	bool lanes_empty() const;
+
+	void add_chunks(Message&& message);
+
+	/**
+	 * \brief Moves the control and interactive messages to the queue, and the next bulk one if the queue is empty.
+	 */
+	void add_data();
 
 	void cleanup_pending_queue();
 
@@ -87,13 +114,34 @@ private:
 	void ThreadProc();
 
 public:
+	/**
+	 * \brief Sends the unacknowledged packages again on resume in a single call to [processor], instead of one call
+	 * of the package processor for each of them. Must be set before \ref start.
+	 */
+	void set_resend_processor(resend_processor_t processor);
+
+	/**
+	 * \brief Sends a heartbeat, which isn't a package: it has no sequence number and is never resent. Called on the
+	 * thread of the processor between packages, when one has been requested. Must be set before \ref start.
+	 */
+	void set_heartbeat_processor(std::function<void()> processor);
+
 	void start();
 
 	bool stop(time_t timeout = time_t(0));
 
 	bool terminate(time_t timeout = time_t(0) /*InfiniteDuration*/);
 
-	void put(Buffer::ByteArray new_data);
+	/**
+	 * \brief Queues [new_data] to be sent in the lane of [priority]. A message put earlier with the same non-empty
+	 * [coalescing_key] is dropped if it hasn't been moved out of its lane yet, the new one goes to the end of the lane.
+	 */
+	void put(Buffer::ByteArray new_data, SendPriority priority = SendPriority::Interactive, std::string coalescing_key = {});
+
+	/**
+	 * \brief Makes the thread of the processor send a heartbeat ahead of the queued packages, without waiting for it.
+	 */
+	void request_heartbeat();
 
 	void pause(const std::string& reason);
 
@@ -6,9 +6,15 @@
 
 namespace rd
 {
+Buffer::word_t const* PkgInputStream::current() const
+{
+	return (borrowed != nullptr ? borrowed : buffer.data()) + position;
+}
+
 void PkgInputStream::rewind()
 {
-	buffer.rewind();
+	borrowed = nullptr;
+	position = 0;
 }
 
 void PkgInputStream::require_available(int size)
@@ -18,7 +24,7 @@ void PkgInputStream::require_available(int size)
 
 size_t PkgInputStream::get_position() const
 {
-	return buffer.get_position();
+	return position;
 }
 
 Buffer::word_t* PkgInputStream::data()
@@ -31,9 +37,29 @@ Buffer& PkgInputStream::get_buffer()
 	return buffer;
 }
 
+void PkgInputStream::borrow(Buffer::word_t const* package)
+{
+	borrowed = package;
+}
+
+bool PkgInputStream::is_available(size_t size) const
+{
+	return memory != -1 && position + size <= static_cast<size_t>(memory);
+}
+
+Buffer::word_t const* PkgInputStream::peek() const
+{
+	return current();
+}
+
+void PkgInputStream::skip(size_t size)
+{
+	position += size;
+}
+
 int32_t PkgInputStream::try_read(Buffer::word_t* res, size_t size)
 {
-	if (memory == -1 || static_cast<int32_t>(buffer.get_position()) == memory)
+	if (memory == -1 || static_cast<int32_t>(position) == memory)
 	{
 		memory = request_data();
 		if (memory == -1)
@@ -41,10 +67,10 @@ int32_t PkgInputStream::try_read(Buffer::word_t* res, size_t size)
 			return -1;
 		}
 	}
-	const int32_t n = static_cast<int32_t>((std::min)(size, memory - buffer.get_position()));
-	Buffer::word_t* start = buffer.current_pointer();
+	const int32_t n = static_cast<int32_t>((std::min)(size, memory - position));
+	Buffer::word_t const* start = current();
 	std::copy(start, start + n, res);
-	buffer.set_position(buffer.get_position() + n);
+	position += n;
 	return n;
 }
 
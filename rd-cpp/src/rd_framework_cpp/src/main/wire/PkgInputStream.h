@@ -12,12 +12,20 @@ namespace rd
 class RD_FRAMEWORK_API PkgInputStream
 {
 private:
+	// packages copied from the socket
 	Buffer buffer;
 
+	// the current package if it's read in place, see \ref borrow
+	Buffer::word_t const* borrowed = nullptr;
+
+	size_t position = 0;
+
 	std::function<int32_t()> request_data;
 
 	int32_t memory = 0;
 
+	Buffer::word_t const* current() const;
+
 public:
 	template <typename F>
 	explicit PkgInputStream(F&& f) : request_data(std::forward<F>(f))
@@ -34,6 +42,21 @@ public:
 
 	Buffer& get_buffer();
 
+	/**
+	 * \brief Makes the next package be read in place from [package], which must stay valid until the following one
+	 * is requested. Call it instead of filling \ref data from the data request.
+	 */
+	void borrow(Buffer::word_t const* package);
+
+	/**
+	 * \brief Whether the next [size] bytes are in the current package, so that \ref peek can be used for them.
+	 */
+	bool is_available(size_t size) const;
+
+	Buffer::word_t const* peek() const;
+
+	void skip(size_t size);
+
 	int32_t try_read(Buffer::word_t* res, size_t size);
 
 	bool read(Buffer::word_t* res, size_t size);
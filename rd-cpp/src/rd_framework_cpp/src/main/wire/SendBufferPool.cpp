@@ -0,0 +1,86 @@
+#include "SendBufferPool.h"
+
+#include <vector>
+
+namespace rd
+{
+constexpr size_t SendBufferPool::MAX_POOLED_BUFFERS;
+constexpr size_t SendBufferPool::MAX_RETAINED_SIZE;
+constexpr size_t SendBufferPool::INITIAL_SIZE;
+constexpr size_t SendBufferPool::MAX_COPIED_SIZE;
+
+namespace
+{
+struct Pool
+{
+	std::vector<Buffer> buffers;
+	// the leases are scoped, the buffers leased are always the first ones
+	size_t leased = 0;
+};
+
+Pool& pool()
+{
+	// reserved up front, so that the leased buffers never move
+	static thread_local Pool instance = [] {
+		Pool result;
+		result.buffers.reserve(SendBufferPool::MAX_POOLED_BUFFERS);
+		return result;
+	}();
+	return instance;
+}
+}	 // namespace
+
+Buffer* SendBufferPool::Lease::take()
+{
+	auto& instance = pool();
+	if (instance.leased == MAX_POOLED_BUFFERS)
+	{
+		return nullptr;
+	}
+	if (instance.leased == instance.buffers.size())
+	{
+		instance.buffers.emplace_back(INITIAL_SIZE);
+	}
+	return &instance.buffers[instance.leased++];
+}
+
+SendBufferPool::Lease::Lease() : buffer(take()), own(buffer == nullptr ? INITIAL_SIZE : 0)
+{
+	if (buffer == nullptr)
+	{
+		buffer = &own;
+	}
+}
+
+SendBufferPool::Lease::~Lease()
+{
+	if (buffer == &own)
+	{
+		return;
+	}
+	if (buffer->get_data().size() > MAX_RETAINED_SIZE)
+	{
+		*buffer = Buffer(INITIAL_SIZE);
+	}
+	else
+	{
+		buffer->rewind();
+		buffer->set_string_encoding(StringEncoding::Utf16);
+	}
+	--pool().leased;
+}
+
+Buffer::ByteArray SendBufferPool::Lease::take_written()
+{
+	if (buffer->get_position() <= MAX_COPIED_SIZE)
+	{
+		auto result = buffer->getRealArray();
+		buffer->rewind();
+		return result;
+	}
+	// the copy would cost more than growing a fresh buffer for the next large message
+	auto result = std::move(*buffer).getRealArray();
+	*buffer = Buffer(INITIAL_SIZE);
+	return result;
+}
+}	 // namespace rd
@@ -0,0 +1,82 @@
+#ifndef RD_CPP_SENDBUFFERPOOL_H
+#define RD_CPP_SENDBUFFERPOOL_H
+
+#include "protocol/Buffer.h"
+
+#include <rd_framework_export.h>
+
+RD_PUSH_STL_EXPORTS_WARNINGS
+
+namespace rd
+{
+/**
+ * \brief Per-thread buffers that outgoing messages are written into. They keep their size between sends, so a typical
+ * message grows no buffer at all and only its final copy of the exact size is allocated. Larger messages aren't copied,
+ * they take the storage of the buffer with them and the buffer starts over from INITIAL_SIZE.
+ */
+class RD_FRAMEWORK_API SendBufferPool
+{
+public:
+	/**
+	 * \brief Buffers kept by each thread, more than one are needed only when writers send messages themselves.
+	 */
+	static constexpr size_t MAX_POOLED_BUFFERS = 4;
+
+	/**
+	 * \brief Buffers grown larger by an occasional big message are freed instead of being kept.
+	 */
+	static constexpr size_t MAX_RETAINED_SIZE = 1u << 20;
+
+	static constexpr size_t INITIAL_SIZE = 1u << 10;
+
+	/**
+	 * \brief Messages up to this size are copied out of the buffer, larger ones take its storage with them.
+	 */
+	static constexpr size_t MAX_COPIED_SIZE = 1u << 10;
+
+	/**
+	 * \brief Empty buffer of the current thread's pool, which takes it back on destruction.
+	 */
+	class RD_FRAMEWORK_API Lease
+	{
+		// the leased buffer stays in the pool, only sends nested deeper than MAX_POOLED_BUFFERS use their own
+		Buffer* buffer;
+		Buffer own;
+
+		static Buffer* take();
+
+	public:
+		// region ctor/dtor
+
+		Lease();
+
+		Lease(Lease const&) = delete;
+
+		Lease& operator=(Lease const&) = delete;
+
+		~Lease();
+
+		// endregion
+
+		Buffer& operator*()
+		{
+			return *buffer;
+		}
+
+		Buffer* operator->()
+		{
+			return buffer;
+		}
+
+		/**
+		 * \return the bytes written so far, see \ref MAX_COPIED_SIZE. The buffer is left empty either way, with at least
+		 * INITIAL_SIZE bytes to write the next message into.
+		 */
+		Buffer::ByteArray take_written();
+	};
+};
+}	 // namespace rd
+
+RD_POP_STL_EXPORTS_WARNINGS
+
+#endif	  // RD_CPP_SENDBUFFERPOOL_H
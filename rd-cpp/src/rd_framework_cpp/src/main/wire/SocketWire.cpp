@@ -1,5 +1,9 @@
 #include "wire/SocketWire.h"
 
+#include "context/ProtocolContexts.h"
+#include "scheduler/TimerWheel.h"
+#include "wire/SendBufferPool.h"
+
 #include <util/thread_util.h>
 
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -9,6 +13,8 @@
 #include <PassiveSocket.h>
 #include <SimpleSocketSender.h>
 
+#include <algorithm>
+#include <random>
 #include <utility>
 #include <thread>
 #include <csignal>
@@ -23,10 +29,23 @@ std::chrono::milliseconds SocketWire::timeout = std::chrono::milliseconds(500);
 constexpr int32_t SocketWire::Base::ACK_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PING_MESSAGE_LENGTH;
 constexpr int32_t SocketWire::Base::PACKAGE_HEADER_LENGTH;
+constexpr int32_t SocketWire::Base::CAPABILITY_COMPACT_STRINGS;
+constexpr size_t SocketWire::Base::RESEND_BATCH_SIZE;
+constexpr std::chrono::milliseconds SocketWire::Client::CONNECT_TIMEOUT;
+constexpr std::chrono::milliseconds SocketWire::Client::MIN_RECONNECT_DELAY;
+constexpr std::chrono::milliseconds SocketWire::Client::MAX_RECONNECT_DELAY;
+
+// service message which is consumed by the wire itself and never reaches MessageBroker
+static const RdId CAPABILITIES_ID = RdId::Null().mix("SocketWire.Capabilities");
 
 SocketWire::Base::Base(std::string id, Lifetime parentLifetime, IScheduler* scheduler)
 	: WireBase(scheduler), id(std::move(id)), scheduler(scheduler), lifetimeDef(parentLifetime)
 {
+	async_send_buffer.set_resend_processor(
+		[this](std::deque<Buffer::ByteArray> const& packages, sequence_number_t first_seqn) -> bool {
+			return this->resend0(packages, first_seqn);
+		});
+	async_send_buffer.set_heartbeat_processor([this] { send_ping(); });
 	async_send_buffer.pause("initial");
 	async_send_buffer.start();
 	ping_pkg_header.write_integral(PING_MESSAGE_LENGTH);
@@ -104,14 +123,78 @@ bool SocketWire::Base::send0(Buffer::ByteArray const& msg, sequence_number_t seq
 	}
 }
 
+bool SocketWire::Base::resend0(std::deque<Buffer::ByteArray> const& packages, sequence_number_t first_seqn) const
+{
+	try
+	{
+		std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+
+		// the packages are packed with their headers, so the window takes a few writes instead of two per package
+		Buffer batch(RESEND_BATCH_SIZE);
+		size_t sent = 0;
+		const auto flush_batch = [this, &batch, &sent] {
+			const auto size = static_cast<int32_t>(batch.get_position());
+			RD_ASSERT_THROW_MSG(socket_sender->Send(batch.data(), size) == size,
+				this->id + ": failed to resend packages over the network, reason: " + socket_sender->DescribeError())
+			sent += size;
+			batch.rewind();
+		};
+		sequence_number_t seqn = first_seqn;
+		for (auto const& package : packages)
+		{
+			batch.write_integral(static_cast<int32_t>(package.size()));
+			batch.write_integral(seqn++);
+			batch.write_byte_array_raw(package);
+			if (batch.get_position() >= RESEND_BATCH_SIZE)
+			{
+				flush_batch();
+			}
+		}
+		if (batch.get_position() > 0)
+		{
+			flush_batch();
+		}
+		logger->debug("{}: resent {} packages, {} bytes", this->id, packages.size(), sent);
+		return true;
+	}
+	catch (std::exception const& e)
+	{
+		logger->warn("Resend failed due to: | {}", e.what());
+		return false;
+	}
+}
+
 void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const
+{
+	enqueue(rd_id, writer, {});
+}
+
+void SocketWire::Base::send_latest(RdId const& rd_id, std::string const& key, std::function<void(Buffer& buffer)> writer) const
+{
+	// the id is a part of the key, so that the messages of different entities never supersede each other
+	const RdId::hash_t hash = rd_id.get_hash();
+	std::string coalescing_key(reinterpret_cast<char const*>(&hash), sizeof(hash));
+	coalescing_key += key;
+	enqueue(rd_id, writer, std::move(coalescing_key));
+}
+
+void SocketWire::Base::enqueue(
+	RdId const& rd_id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const
 {
 	RD_ASSERT_MSG(!rd_id.isNull(), "{}: id mustn't be null");
 
-	Buffer local_send_buffer;
+	const auto encoding = negotiated_string_encoding();
+	if (record_to_snapshot(rd_id, writer, encoding))
+	{
+		return;
+	}
+
+	SendBufferPool::Lease lease;
+	Buffer& local_send_buffer = *lease;
+	local_send_buffer.set_string_encoding(encoding);
 	local_send_buffer.write_integral<int32_t>(0);	 // placeholder for length
 	rd_id.write(local_send_buffer);					 // write id
-	local_send_buffer.write_integral<int16_t>(0);	 // placeholder for context
+	write_context(local_send_buffer);				 // write context
 	writer(local_send_buffer);						 // write rest
 
 	int32_t len = static_cast<int32_t>(local_send_buffer.get_position());
@@ -119,7 +202,8 @@ void SocketWire::Base::send(RdId const& rd_id, std::function<void(Buffer& buffer
 	local_send_buffer.rewind();
 	local_send_buffer.write_integral<int32_t>(len - 4);
 	local_send_buffer.set_position(len);
-	async_send_buffer.put(std::move(local_send_buffer).getRealArray());
+	const auto priority = rd_id == CAPABILITIES_ID ? SendPriority::Control : get_send_priority(rd_id);
+	async_send_buffer.put(lease.take_written(), priority, std::move(coalescing_key));
 }
 
 void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_socket)
@@ -138,24 +222,29 @@ void SocketWire::Base::set_socket_provider(std::shared_ptr<CActiveSocket> new_so
 		}
 	}
 
-	const auto heartbeat = LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
-		const auto heartbeat = start_heartbeat(std::move(heartbeatLifetime)).share();
+	// the termination of the heartbeat lifetime waits for a ping being sent
+	LifetimeDefinition::use([this](Lifetime heartbeatLifetime) {
+		start_heartbeat(std::move(heartbeatLifetime));
 
 		async_send_buffer.resume();
 
+		if (use_compact_strings)
+		{
+			send_capabilities();
+		}
+
 		connected.set(true);
 
 		receiverProc();
 
 		connected.set(false);
 
-		async_send_buffer.pause("Disconnected");
+		counterpart_reads_compact_strings = false;
 
-		return heartbeat;
+		async_send_buffer.pause("Disconnected");
 	});
-	const auto status = heartbeat.wait_for(timeout);
 
-	logger->debug("{}: waited for heartbeat to stop with status: {}", this->id, static_cast<uint32_t>(status));
+	logger->debug("{}: heartbeat stopped", this->id);
 
 	if (!socket_provider->IsSocketValid())
 	{
@@ -178,15 +267,9 @@ bool SocketWire::Base::connection_established(int32_t timestamp, int32_t notion_
 	return timestamp - notion_timestamp <= MaximumHeartbeatDelay;
 }
 
-std::future<void> SocketWire::Base::start_heartbeat(Lifetime lifetime)
+void SocketWire::Base::start_heartbeat(Lifetime lifetime)
 {
-	return std::async([this, lifetime] {
-		while (!lifetime->is_terminated())
-		{
-			std::this_thread::sleep_for(heartBeatInterval);
-			ping();
-		}
-	});
+	TimerWheel::instance().schedule_repeating(std::move(lifetime), heartBeatInterval, [this] { ping(); });
 }
 
 bool SocketWire::Base::read_from_socket(Buffer::word_t* res, int32_t msglen) const
@@ -320,11 +403,20 @@ int32_t SocketWire::Base::read_package() const
 
 	logger->debug("{}: read len={}, seqn={}, max_received_seqn={}", this->id, len, seqn, max_received_seqn);
 
-	receive_pkg.require_available(len);
-	if (!read_data_from_socket(receive_pkg.data(), len))
+	if (hi - lo >= len)
 	{
-		logger->debug("{}: failed to read package", this->id);
-		return -1;
+		// the package has been received whole, it's read in place until the next one is requested
+		receive_pkg.borrow(receiver_buffer.data() + (lo - receiver_buffer.begin()));
+		lo += len;
+	}
+	else
+	{
+		receive_pkg.require_available(len);
+		if (!read_data_from_socket(receive_pkg.data(), len))
+		{
+			logger->debug("{}: failed to read package", this->id);
+			return -1;
+		}
 	}
 	send_ack(seqn);
 	if (seqn <= max_received_seqn && seqn != 1)
@@ -354,25 +446,76 @@ bool SocketWire::Base::read_and_dispatch_message() const
 	logger->trace("{}: message info: sz={}, id={}", this->id, sz, id_);
 	const RdId rd_id{id_};
 	sz -= 8;	// RdId
-	message.require_available(sz);
 
-	if (!receive_pkg.read(message.data() + message.get_position(), sz - message.get_position()))
+	if (receive_pkg.is_available(sz))
 	{
-		logger->error("{}: constructing message failed", this->id);
-		return false;
+		// the message is within the current package, it's copied by the broker only if it has to be queued
+		Buffer view = Buffer::view(receive_pkg.peek(), sz);
+		receive_pkg.skip(sz);
+		dispatch_message(rd_id, std::move(view));
+	}
+	else
+	{
+		message.require_available(sz);
+		if (!receive_pkg.read(message.data() + message.get_position(), sz - message.get_position()))
+		{
+			logger->error("{}: constructing message failed", this->id);
+			return false;
+		}
+		dispatch_message(rd_id, std::move(message));
+		message.rewind();
 	}
-
-	logger->debug("{}: message received", this->id);
-	message_broker.dispatch(rd_id, std::move(message));
-	logger->debug("{}: message dispatched", this->id);
 
 	sz = -1;
 	id_ = -1;
-	message.rewind();
 	return true;
 	//		RD_ASSERT_MSG(summary_size == sz, "Broken message, read:%d bytes, expected:%d bytes", summary_size, sz)
 }
 
+void SocketWire::Base::send_capabilities() const
+{
+	auto send_now = [this] {
+		send(CAPABILITIES_ID, [](Buffer& buffer) { buffer.write_integral<int32_t>(CAPABILITY_COMPACT_STRINGS); });
+	};
+	// the counterpart skips the context header of this message without reading it
+	if (contexts)
+	{
+		contexts->send_without_contexts(send_now);
+	}
+	else
+	{
+		send_now();
+	}
+}
+
+void SocketWire::Base::dispatch_message(RdId const& rd_id, Buffer buffer) const
+{
+	if (rd_id == CAPABILITIES_ID)
+	{
+		receive_capabilities(buffer);
+		return;
+	}
+
+	// the counterpart's capabilities precede its other messages, so the encoding is known for every one of them
+	buffer.set_string_encoding(negotiated_string_encoding());
+	logger->debug("{}: message received", this->id);
+	message_broker.dispatch(rd_id, std::move(buffer));
+	logger->debug("{}: message dispatched", this->id);
+}
+
+StringEncoding SocketWire::Base::negotiated_string_encoding() const
+{
+	return use_compact_strings && counterpart_reads_compact_strings ? StringEncoding::Compact : StringEncoding::Utf16;
+}
+
+void SocketWire::Base::receive_capabilities(Buffer& buffer) const
+{
+	buffer.read_integral<int16_t>();	// skip context
+	const auto capabilities = buffer.read_integral<int32_t>();
+	logger->debug("{}: counterpart capabilities: {}", this->id, capabilities);
+	counterpart_reads_compact_strings = (capabilities & CAPABILITY_COMPACT_STRINGS) != 0;
+}
+
 CSimpleSocket* SocketWire::Base::get_socket_provider() const
 {
 	return socket_provider.get();
@@ -393,13 +536,20 @@ void SocketWire::Base::ping() const
 		}
 		heartbeatAlive.set(false);
 	}
+	// called on the thread of the shared timer wheel, which mustn't wait for the socket: the ping is sent by the thread
+	// of the send buffer ahead of the packages queued
+	async_send_buffer.request_heartbeat();
+}
+
+void SocketWire::Base::send_ping() const
+{
 	try
 	{
-		ping_pkg_header.set_position(sizeof(PING_MESSAGE_LENGTH));
-		ping_pkg_header.write_integral(current_timestamp);
-		ping_pkg_header.write_integral(counterpart_timestamp);
 		{
 			std::lock_guard<decltype(socket_send_lock)> guard(socket_send_lock);
+			ping_pkg_header.set_position(sizeof(PING_MESSAGE_LENGTH));
+			ping_pkg_header.write_integral(current_timestamp);
+			ping_pkg_header.write_integral(counterpart_timestamp);
 			int32_t sent = socket_sender->Send(ping_pkg_header.data(), ping_pkg_header.get_position());
 			if (sent == 0 && !socket_sender->IsSocketValid())
 			{
@@ -463,6 +613,8 @@ SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint1
 		{
 			logger->info("{}: started, port: {}.", this->id, this->port);
 
+			std::minstd_rand random(std::random_device{}());
+			auto reconnect_delay = MIN_RECONNECT_DELAY;
 			while (!lifetime->is_terminated())
 			{
 				try
@@ -473,15 +625,20 @@ SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint1
 					RD_ASSERT_THROW_MSG(socket->DisableNagleAlgoritm(),
 						fmt::format("{}: failed to DisableNagleAlgoritm, reason: {}", this->id, socket->DescribeError()));
 
-					// On windows connect will try to send SYN 3 times with interval of 500ms (total time is 1second)
-					// Connect timeout doesn't work if it's more than 1 second. But we don't need it because we can close socket any
-					// moment.
+					// On windows a blocking connect sends SYN 3 times with interval of 500ms (total time is 1 second) before it
+					// fails, so the connect is non-blocking and gives up after CONNECT_TIMEOUT: the next attempt comes sooner.
 
 					// https://stackoverflow.com/questions/22417228/prevent-tcp-socket-connection-retries
 					// HKLM\SYSTEM\CurrentControlSet\Services\Tcpip\Parameters\TcpMaxConnectRetransmissions
 					logger->info("{}: connecting 127.0.0.1: {}", this->id, this->port);
+					RD_ASSERT_THROW_MSG(socket->SetNonblocking(),
+						fmt::format("{}: failed to SetNonblocking, reason: {}", this->id, socket->DescribeError()));
+					socket->SetConnectTimeout(0, static_cast<int32_t>(std::chrono::microseconds(CONNECT_TIMEOUT).count()));
 					RD_ASSERT_THROW_MSG(socket->Open("127.0.0.1", this->port),
 						fmt::format("{}: failed to open ActiveSocket, reason: {}", this->id, socket->DescribeError()));
+					RD_ASSERT_THROW_MSG(socket->SetBlocking(),
+						fmt::format("{}: failed to SetBlocking, reason: {}", this->id, socket->DescribeError()));
+					reconnect_delay = MIN_RECONNECT_DELAY;
 					{
 						std::lock_guard<decltype(lock)> guard(lock);
 						if (lifetime->is_terminated())
@@ -500,18 +657,32 @@ SocketWire::Client::Client(Lifetime parentLifetime, IScheduler* scheduler, uint1
 				{
 					logger->debug("{}: connection error for port {} ({}).", this->id, this->port, e.what());
 
-					std::lock_guard<decltype(lock)> guard(lock);
-					bool should_reconnect = false;
-					if (!lifetime->is_terminated())
+					// the clients waiting for the same server don't retry in step
+					std::uniform_int_distribution<int64_t> jitter(reconnect_delay.count() / 2, reconnect_delay.count());
+					const std::chrono::milliseconds delay(jitter(random));
+					reconnect_delay = std::min(reconnect_delay * 2, MAX_RECONNECT_DELAY);
+
+					// the delay is timed by the wheel, the attempt stays on this thread: a connect blocks for up to
+					// CONNECT_TIMEOUT, the wheel thread must not
+					bool reconnect_due = false;
+					LifetimeDefinition delay_definition(lifetime);
+					TimerWheel::instance().schedule(delay_definition.lifetime, delay, [this, &reconnect_due] {
+						{
+							std::lock_guard<decltype(lock)> guard(lock);
+							reconnect_due = true;
+						}
+						cv.notify_all();
+					});
 					{
-						cv.wait_for(lock, timeout);
-						should_reconnect = !lifetime->is_terminated();
+						std::unique_lock<decltype(lock)> guard(lock);
+						cv.wait(guard, [&] { return reconnect_due || lifetime->is_terminated(); });
 					}
-					if (should_reconnect)
+					// waits for the timer if it's firing, it refers to this frame
+					delay_definition.terminate();
+					if (lifetime->is_terminated())
 					{
-						continue;
+						break;
 					}
-					break;
 				}
 			}
 		}
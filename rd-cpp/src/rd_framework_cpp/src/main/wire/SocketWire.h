@@ -58,6 +58,8 @@ public:
 		static constexpr int32_t PACKAGE_HEADER_LENGTH = sizeof(ACK_MESSAGE_LENGTH) + sizeof(sequence_number_t);
 		mutable Buffer ack_buffer{PACKAGE_HEADER_LENGTH};
 
+		static constexpr size_t RESEND_BATCH_SIZE = 1u << 16;
+
 		/**
 		 * \brief Timestamp of this wire which increases at intervals of [heartBeatInterval].
 		 */
@@ -85,6 +87,25 @@ public:
 
 		mutable Buffer message{CHUNK_SIZE};
 
+		static constexpr int32_t CAPABILITY_COMPACT_STRINGS = 1 << 0;
+		mutable std::atomic<bool> counterpart_reads_compact_strings{false};
+
+		void send_capabilities() const;
+
+		/**
+		 * \brief Writes the message of [writer] and puts it into the send queue, see \ref ByteBufferAsyncProcessor::put.
+		 */
+		void enqueue(RdId const& rd_id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const;
+
+		void receive_capabilities(Buffer& buffer) const;
+
+		/**
+		 * \brief Encoding of strings in the messages of both directions, compact only when both ends advertised it.
+		 */
+		StringEncoding negotiated_string_encoding() const;
+
+		void dispatch_message(RdId const& rd_id, Buffer buffer) const;
+
 		bool read_from_socket(Buffer::word_t* res, int32_t msglen) const;
 
 		template <typename T>
@@ -106,6 +127,12 @@ public:
 		static constexpr int32_t MaximumHeartbeatDelay = 3;
 		std::chrono::milliseconds heartBeatInterval = std::chrono::milliseconds(500);
 
+		/**
+		 * \brief Advertise \ref StringEncoding::Compact on connect and use it for outgoing messages once the counterpart
+		 * advertised it too. Other rd implementations can't read compact strings, so enable it on both C++ ends only.
+		 */
+		bool use_compact_strings = false;
+
 		// region ctor/dtor
 
 		Base(std::string id, Lifetime lifetime, IScheduler* scheduler);
@@ -124,14 +151,32 @@ public:
 
 		bool send0(Buffer::ByteArray const& msg, sequence_number_t seqn) const;
 
+		/**
+		 * \brief Sends again the packages not acknowledged before a reconnect, starting from [first_seqn].
+		 */
+		bool resend0(std::deque<Buffer::ByteArray> const& packages, sequence_number_t first_seqn) const;
+
 		void send(RdId const& rd_id, std::function<void(Buffer& buffer)> writer) const override;
 
+		void send_latest(RdId const& rd_id, std::string const& key, std::function<void(Buffer& buffer)> writer) const override;
+
 		static bool connection_established(int32_t timestamp, int32_t acknowledged_timestamp);
 
-		std::future<void> start_heartbeat(Lifetime lifetime);
+		/**
+		 * \brief Pings the counterpart every [heartBeatInterval] on the \ref TimerWheel until [lifetime] is terminated.
+		 */
+		void start_heartbeat(Lifetime lifetime);
 
+		/**
+		 * \brief Checks that the counterpart pings back and asks the send buffer for a ping, never waits for the socket.
+		 */
 		void ping() const;
 
+		/**
+		 * \brief Sends a ping on the thread of the send buffer.
+		 */
+		void send_ping() const;
+
 		bool send_ack(sequence_number_t seqn) const;
 
 		bool try_shutdown_connection() const;
@@ -143,6 +188,18 @@ public:
 	class RD_FRAMEWORK_API Client : public Base
 	{
 	public:
+		/**
+		 * \brief How long a connection attempt waits for the server before it's given up.
+		 */
+		static constexpr std::chrono::milliseconds CONNECT_TIMEOUT{200};
+
+		/**
+		 * \brief The delay before the next attempt after a failed one, doubled with each failure up to
+		 * MAX_RECONNECT_DELAY and reset by a successful connection. The actual delays are randomized by up to a half.
+		 */
+		static constexpr std::chrono::milliseconds MIN_RECONNECT_DELAY{10};
+		static constexpr std::chrono::milliseconds MAX_RECONNECT_DELAY{500};
+
 		uint16_t port = 0;
 
 		// region ctor/dtor
@@ -4,6 +4,9 @@
 #include "wire/WireUtil.h"
 #include "lifetime/LifetimeDefinition.h"
 
+#include <thread>
+#include <vector>
+
 using namespace rd;
 
 TEST(BackgroundSchedulerTest, Simple)
@@ -35,4 +38,69 @@ TEST(BackgroundSchedulerTest, Simple)
 	EXPECT_EQ(3, tasks_executed);
 
 	definition.terminate();
-}
\ No newline at end of file
+}
+
+TEST(BackgroundSchedulerTest, ProducersKeepTheirOrder)
+{
+	LifetimeDefinition definition{false};
+	rd::SingleThreadScheduler s(definition.lifetime, "test-producers", 100);
+
+	const int32_t producers = 4;
+	const int32_t count = 10000;
+	std::vector<int32_t> last(producers, -1);
+	std::atomic_int32_t out_of_order{0};
+	std::vector<std::thread> threads;
+	for (int32_t producer = 0; producer < producers; ++producer)
+	{
+		threads.emplace_back([&, producer] {
+			for (int32_t i = 0; i < count; ++i)
+			{
+				s.queue([&, producer, i] {
+					if (last[producer] + 1 != i)
+					{
+						++out_of_order;
+					}
+					last[producer] = i;
+				});
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	s.flush();
+	EXPECT_EQ(0, out_of_order);
+	EXPECT_EQ(std::vector<int32_t>(producers, count - 1), last);
+
+	// the actions queued before termination are executed
+	std::atomic_int32_t executed{0};
+	s.queue([&] {
+		util::sleep_this_thread(50);
+		++executed;
+	});
+	definition.terminate();
+	EXPECT_EQ(1, executed);
+}
+
+TEST(BackgroundSchedulerTest, StoppedByOwnAction)
+{
+	LifetimeDefinition definition{false};
+	std::atomic_int32_t tasks_executed{0};
+	{
+		rd::SingleThreadScheduler s(definition.lifetime, "test-own-stop");
+		s.queue([&]() {
+			definition.terminate();
+			tasks_executed++;
+		});
+		// queued before the destruction, executed while the scheduler is still whole
+		s.queue([&]() {
+			util::sleep_this_thread(50);
+			if (s.lifetime->is_terminated())
+			{
+				tasks_executed++;
+			}
+		});
+	}
+	EXPECT_EQ(2, tasks_executed);
+}
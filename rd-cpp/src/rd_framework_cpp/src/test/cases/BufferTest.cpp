@@ -5,6 +5,7 @@
 #include "serialization/NullableSerializer.h"
 #include "serialization/ArraySerializer.h"
 
+#include <array>
 #include <random>
 #include <numeric>
 
@@ -99,6 +100,92 @@ TEST(BufferTest, string)
 	EXPECT_EQ(len, s.length());
 }
 
+TEST(BufferTest, stringSupplementaryPlane)
+{
+	Buffer buffer;
+
+	std::wstring s = L"prefix ";
+	for (int i = 0; i < 20; ++i)
+	{
+		s += static_cast<wchar_t>(0x400 + i);
+	}
+	if (sizeof(wchar_t) == 4)
+	{
+		s += static_cast<wchar_t>(0x1F600);
+	}
+	else
+	{
+		s += static_cast<wchar_t>(0xD83D);
+		s += static_cast<wchar_t>(0xDE00);
+	}
+	s += L" suffix which is long enough to be processed by blocks";
+
+	buffer.write_wstring(s);
+	const size_t units = s.size() + (sizeof(wchar_t) == 4 ? 1 : 0);
+	EXPECT_EQ(buffer.get_position(), sizeof(int32_t) + 2 * units);
+
+	buffer.rewind();
+	EXPECT_EQ(static_cast<int32_t>(units), buffer.read_integral<int32_t>());
+
+	buffer.rewind();
+	EXPECT_EQ(s, buffer.read_wstring());
+}
+
+TEST(BufferTest, compactString)
+{
+	Buffer buffer;
+	buffer.set_string_encoding(StringEncoding::Compact);
+
+	const std::wstring latin1 = L"Latin-1 only string with \u00e9\u00ff and enough characters for several blocks";
+	const std::wstring wide = L"\u041f\u0440\u0438\u0432\u0435\u0442, not a Latin-1 string at all, but mostly ASCII";
+
+	buffer.write_wstring(latin1);
+	EXPECT_EQ(buffer.get_position(), sizeof(int32_t) + latin1.size());
+	buffer.write_wstring(wide);
+	buffer.write_wstring(std::wstring());
+
+	buffer.rewind();
+	EXPECT_EQ(latin1, buffer.read_wstring());
+	EXPECT_EQ(wide, buffer.read_wstring());
+	EXPECT_EQ(L"", buffer.read_wstring());
+
+	buffer.rewind();
+	EXPECT_EQ(u8"Latin-1 only string with \u00e9\u00ff and enough characters for several blocks", buffer.read_string());
+	EXPECT_EQ(u8"\u041f\u0440\u0438\u0432\u0435\u0442, not a Latin-1 string at all, but mostly ASCII", buffer.read_string());
+}
+
+TEST(BufferTest, compactStringNotNegotiated)
+{
+	Buffer buffer;
+	buffer.write_integral<int32_t>(-1);
+	buffer.write_wstring(std::wstring(L"compact"));
+	buffer.rewind();
+
+	// a negative length is broken data unless compact strings are used on this connection
+	EXPECT_THROW(buffer.read_wstring(), std::runtime_error);
+	buffer.rewind();
+	EXPECT_THROW(buffer.read_string(), std::runtime_error);
+}
+
+TEST(BufferTest, utf8String)
+{
+	const std::string utf8 = u8"UTF-8 \u00e9\u041f\u20ac\U0001F600 string which is longer than a single vector block";
+	const std::wstring wide = L"UTF-8 \u00e9\u041f\u20ac\U0001F600 string which is longer than a single vector block";
+
+	for (auto encoding : {StringEncoding::Utf16, StringEncoding::Compact})
+	{
+		Buffer buffer;
+		buffer.set_string_encoding(encoding);
+
+		Polymorphic<std::string>::write(ctx, buffer, utf8);
+		buffer.write_wstring(wide);
+
+		buffer.rewind();
+		EXPECT_EQ(wide, buffer.read_wstring());
+		EXPECT_EQ(utf8, Polymorphic<std::string>::read(ctx, buffer));
+	}
+}
+
 TEST(BufferTest, bigVector)
 {
 	const int STEP = 100'000;
@@ -122,6 +209,94 @@ TEST(BufferTest, bigVector)
 	EXPECT_EQ(res, list);
 }
 
+TEST(BufferTest, span)
+{
+	const std::array<int16_t, 3> fixed{{1, -2, 3}};
+	const double raw[] = {0.5, -0.25};
+	std::vector<int64_t> list(100'000);
+	std::iota(list.begin(), list.end(), -50'000);
+
+	Buffer buffer;
+	buffer.write_span(fixed);
+	buffer.write_span(raw);
+	buffer.write_span(list.data() + 1, 2);
+	const size_t before_list = buffer.get_position();
+	buffer.write_span(list);
+
+	// grown just once for the whole list
+	EXPECT_EQ(before_list + sizeof(int32_t) + sizeof(int64_t) * list.size(), buffer.get_data().size());
+	// numbers are little-endian on the wire
+	EXPECT_EQ(3, buffer.data()[0]);
+	EXPECT_EQ(1, buffer.data()[sizeof(int32_t)]);
+
+	buffer.rewind();
+
+	std::array<int16_t, 3> fixed_read{};
+	EXPECT_EQ(3u, buffer.read_into(fixed_read));
+	EXPECT_EQ(fixed, fixed_read);
+
+	double raw_read[4] = {};
+	EXPECT_EQ(2u, buffer.read_into(raw_read));
+	EXPECT_EQ(0.5, raw_read[0]);
+	EXPECT_EQ(-0.25, raw_read[1]);
+
+	// spans and arrays share the format
+	EXPECT_EQ((std::vector<int64_t>{list[1], list[2]}), (buffer.read_array<std::vector, int64_t>()));
+
+	std::vector<int64_t> too_small(10);
+	EXPECT_THROW(buffer.read_into(too_small), std::out_of_range);
+	// the array is still there to be read into a storage large enough
+	EXPECT_EQ(before_list, buffer.get_position());
+	std::vector<int64_t> large_enough(list.size());
+	EXPECT_EQ(list.size(), buffer.read_into(large_enough));
+	EXPECT_EQ(list, large_enough);
+}
+
+TEST(BufferTest, arrayWithBrokenLength)
+{
+	Buffer buffer;
+	buffer.write_integral<int32_t>(1 << 30);
+	buffer.write_integral<int64_t>(0);
+	buffer.rewind();
+
+	EXPECT_THROW((buffer.read_array<std::vector, int64_t>()), std::out_of_range);
+}
+
+namespace
+{
+class SizedPayload final : public ISerializable
+{
+public:
+	std::vector<int64_t> values;
+
+	void write(SerializationCtx& /*ctx*/, Buffer& buffer) const override
+	{
+		for (auto const& it : values)
+		{
+			buffer.write_integral(it);
+		}
+	}
+
+	size_t serialized_size_hint() const override
+	{
+		return sizeof(int64_t) * values.size();
+	}
+};
+}	 // namespace
+
+TEST(BufferTest, serializedSizeHint)
+{
+	SizedPayload payload;
+	payload.values.resize(1000, 7);
+
+	Buffer buffer;
+	Polymorphic<SizedPayload>::write(ctx, buffer, payload);
+
+	// grown once to the hinted size instead of doubling
+	EXPECT_EQ(sizeof(int64_t) * payload.values.size(), buffer.get_position());
+	EXPECT_EQ(buffer.get_position(), buffer.get_data().size());
+}
+
 TEST(BufferTest, Enum)
 {
 	enum class Numbers
@@ -351,3 +526,28 @@ TEST(BufferTest, duration)
 	std::cout << std::endl << to_string(duration);
 }
 
+
+TEST(BufferTest, view)
+{
+	Buffer source;
+	source.write_integral<int32_t>(42);
+	source.write_wstring(std::wstring(L"viewed"));
+	const auto size = source.get_position();
+
+	Buffer view = Buffer::view(source.data(), size);
+	EXPECT_TRUE(view.is_view());
+	EXPECT_EQ(source.data(), static_cast<Buffer const&>(view).data());
+	EXPECT_EQ(42, view.read_integral<int32_t>());
+	EXPECT_EQ(L"viewed", view.read_wstring());
+	EXPECT_THROW(view.read_integral<int32_t>(), std::out_of_range);
+
+	// writing goes to a copy, the viewed memory stays intact
+	view.rewind();
+	view.write_integral<int32_t>(7);
+	EXPECT_FALSE(view.is_view());
+	view.rewind();
+	EXPECT_EQ(7, view.read_integral<int32_t>());
+	EXPECT_EQ(L"viewed", view.read_wstring());
+	source.rewind();
+	EXPECT_EQ(42, source.read_integral<int32_t>());
+}
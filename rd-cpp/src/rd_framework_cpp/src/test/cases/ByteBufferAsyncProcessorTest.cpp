@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "wire/ByteBufferAsyncProcessor.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace rd;
+
+TEST(ByteBufferAsyncProcessorTest, priority_lanes)
+{
+	std::mutex lock;
+	std::condition_variable cv;
+	std::string sent;
+	ByteBufferAsyncProcessor processor(
+		"priority-lanes",
+		[&](Buffer::ByteArray const& chunk, sequence_number_t) {
+			{
+				std::lock_guard<std::mutex> guard(lock);
+				sent += static_cast<char>(chunk.front());
+			}
+			cv.notify_all();
+			return true;
+		},
+		4);
+	const auto message = [](char tag, size_t size) { return Buffer::ByteArray(size, static_cast<Buffer::word_t>(tag)); };
+
+	processor.pause("initial");
+	processor.start();
+	processor.put(message('a', 9), SendPriority::Bulk);
+	processor.put(message('b', 5), SendPriority::Bulk);
+	processor.put(message('i', 2));
+	processor.put(message('j', 6));
+	processor.put(message('c', 1), SendPriority::Control);
+	processor.resume();
+
+	std::unique_lock<std::mutex> guard(lock);
+	ASSERT_TRUE(cv.wait_for(guard, std::chrono::seconds(5), [&] { return sent.size() == 9; }));
+	// the chunks of a message stay together, the lanes keep their order
+	EXPECT_EQ("cijjaaabb", sent);
+	guard.unlock();
+
+	processor.terminate(std::chrono::milliseconds(1000));
+}
+
+TEST(ByteBufferAsyncProcessorTest, latest_wins)
+{
+	std::mutex lock;
+	std::condition_variable cv;
+	std::string sent;
+	ByteBufferAsyncProcessor processor("latest-wins", [&](Buffer::ByteArray const& chunk, sequence_number_t) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			sent += static_cast<char>(chunk.front());
+		}
+		cv.notify_all();
+		return true;
+	});
+	const auto message = [](char tag) { return Buffer::ByteArray(3, static_cast<Buffer::word_t>(tag)); };
+
+	processor.pause("initial");
+	processor.start();
+	processor.put(message('a'), SendPriority::Interactive, "property");
+	processor.put(message('m'));
+	processor.put(message('b'), SendPriority::Interactive, "property");
+	processor.put(message('k'), SendPriority::Interactive, "key");
+	processor.put(message('x'), SendPriority::Bulk, "bulk");
+	processor.put(message('y'), SendPriority::Bulk, "bulk");
+	processor.put(message('c'), SendPriority::Interactive, "property");
+	processor.resume();
+
+	std::unique_lock<std::mutex> guard(lock);
+	ASSERT_TRUE(cv.wait_for(guard, std::chrono::seconds(5), [&] { return sent.size() == 4; }));
+	// the latest message of a key goes after the ones put before it
+	EXPECT_EQ("mkcy", sent);
+	guard.unlock();
+
+	// sent messages aren't superseded
+	processor.put(message('d'), SendPriority::Interactive, "property");
+	guard.lock();
+	ASSERT_TRUE(cv.wait_for(guard, std::chrono::seconds(5), [&] { return sent.size() == 5; }));
+	EXPECT_EQ("mkcyd", sent);
+	guard.unlock();
+
+	processor.terminate(std::chrono::milliseconds(1000));
+}
+
+TEST(ByteBufferAsyncProcessorTest, resends_pending_window_at_once)
+{
+	std::mutex lock;
+	std::condition_variable cv;
+	size_t sent = 0;
+	std::vector<std::pair<size_t, sequence_number_t>> resent;
+	ByteBufferAsyncProcessor processor("resend", [&](Buffer::ByteArray const&, sequence_number_t) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			++sent;
+		}
+		cv.notify_all();
+		return true;
+	});
+	processor.set_resend_processor([&](std::deque<Buffer::ByteArray> const& packages, sequence_number_t first_seqn) {
+		std::lock_guard<std::mutex> guard(lock);
+		resent.emplace_back(packages.size(), first_seqn);
+		return true;
+	});
+
+	processor.start();
+	for (int i = 0; i < 3; ++i)
+	{
+		processor.put(Buffer::ByteArray(4, static_cast<Buffer::word_t>(i)));
+	}
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		ASSERT_TRUE(cv.wait_for(guard, std::chrono::seconds(5), [&] { return sent == 3; }));
+	}
+
+	// a reconnect sends everything unacknowledged in one go
+	processor.pause("disconnected");
+	processor.resume();
+	processor.acknowledge(1);
+	processor.pause("disconnected");
+	processor.resume();
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		EXPECT_EQ(3u, sent);
+		EXPECT_EQ((std::vector<std::pair<size_t, sequence_number_t>>{{3, 1}, {2, 2}}), resent);
+	}
+
+	processor.terminate(std::chrono::milliseconds(1000));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include "persistence/Checkpoint.h"
+#include "persistence/CheckpointSync.h"
+#include "persistence/MapCheckpoint.h"
+#include "RdFrameworkTestBase.h"
+#include "filesystem.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace rd;
+using namespace test;
+
+namespace
+{
+std::string checkpoint_path(std::string const& name)
+{
+	return filesystem::get_temp_directory() + "/rd_checkpoint_test_" + name;
+}
+
+using Cache = RdMap<int32_t, std::wstring>;
+
+void fill(Cache const& cache)
+{
+	cache.set(1, L"one");
+	cache.set(2, L"two");
+	cache.set(3, L"three");
+}
+}	 // namespace
+
+TEST(Checkpoint, write_and_open)
+{
+	const auto path = checkpoint_path("write_and_open");
+	CheckpointWriter writer(42);
+	writer.add("numbers", [](Buffer& buffer) {
+		buffer.write_integral<int32_t>(1);
+		buffer.write_integral<int32_t>(2);
+	});
+	writer.add("name", [](Buffer& buffer) { buffer.write_string("first"); });
+	writer.add("name", [](Buffer& buffer) { buffer.write_string("second"); });
+	ASSERT_TRUE(writer.commit(path));
+
+	EXPECT_EQ(nullptr, Checkpoint::open(path, 43));
+	EXPECT_EQ(nullptr, Checkpoint::open(path + ".missing", 42));
+
+	auto checkpoint = Checkpoint::open(path, 42);
+	ASSERT_NE(nullptr, checkpoint);
+	EXPECT_FALSE(checkpoint->contains("other"));
+	EXPECT_EQ(0, checkpoint->get_content_hash("other"));
+
+	Buffer numbers = checkpoint->read("numbers");
+	EXPECT_EQ(checkpoint->get_content_hash("numbers"), Checkpoint::content_hash(numbers.data(), numbers.get_data().size()));
+	EXPECT_EQ(1, numbers.read_integral<int32_t>());
+	EXPECT_EQ(2, numbers.read_integral<int32_t>());
+	EXPECT_EQ("second", checkpoint->read("name").read_string());
+	checkpoint.reset();
+
+	// a checkpoint cut short is ignored
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write("RDCK\1\0\0\0", 8);
+	}
+	EXPECT_EQ(nullptr, Checkpoint::open(path, 42));
+	std::remove(path.c_str());
+}
+
+TEST(Checkpoint, damaged_section)
+{
+	const auto path = checkpoint_path("damaged_section");
+	CheckpointWriter writer(42);
+	writer.add("first", [](Buffer& buffer) { buffer.write_string("intact"); });
+	writer.add("second", [](Buffer& buffer) { buffer.write_string("torn"); });
+	ASSERT_TRUE(writer.commit(path));
+
+	// the last byte of the file is in the body of the last section
+	{
+		std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+		file.seekg(-1, std::ios::end);
+		const auto last = static_cast<char>(file.get());
+		file.seekp(-1, std::ios::end);
+		file.put(static_cast<char>(last ^ 1));
+	}
+
+	auto checkpoint = Checkpoint::open(path, 42);
+	ASSERT_NE(nullptr, checkpoint);
+	EXPECT_TRUE(checkpoint->contains("first"));
+	EXPECT_EQ("intact", checkpoint->read("first").read_string());
+	EXPECT_FALSE(checkpoint->contains("second"));
+	EXPECT_EQ(0, checkpoint->get_content_hash("second"));
+	EXPECT_TRUE(checkpoint->read("second").get_data().empty());
+	checkpoint.reset();
+	std::remove(path.c_str());
+}
+
+TEST_F(RdFrameworkTestBase, checkpoint_warm_restart)
+{
+	SerializationCtx ctx(&serializers);
+	const auto path = checkpoint_path("warm_restart");
+	{
+		// the state of the previous session
+		Cache previous;
+		fill(previous);
+		CheckpointWriter writer(0);
+		writer.add("cache", [&](Buffer& buffer) { write_map_checkpoint(ctx, buffer, previous); });
+		ASSERT_TRUE(writer.commit(path));
+	}
+
+	Cache server_cache, client_cache;
+	CheckpointSync server_sync, client_sync;
+	statics(server_cache, 1);
+	statics(client_cache, 1);
+	statics(server_sync, 2);
+	statics(client_sync, 2);
+
+	fill(server_cache);
+	auto checkpoint = Checkpoint::open(path, 0);
+	ASSERT_NE(nullptr, checkpoint);
+	Buffer section = checkpoint->read("cache");
+	read_map_checkpoint(ctx, section, client_cache);
+	client_sync.offer("cache", checkpoint->get_content_hash("cache"));
+	server_sync.provide("cache", [&] { return map_content_hash(ctx, server_cache); });
+
+	int32_t bound = 0;
+	int64_t cache_bytes = 0;
+	auto bind_cache = [&](IProtocol* protocol, Cache& cache, CheckpointSync::Reconciliation const& r) {
+		EXPECT_EQ("cache", r.key);
+		EXPECT_TRUE(r.warm);
+		cache.initial_sync = !r.warm;
+		const auto before = clientWire->bytesWritten + serverWire->bytesWritten;
+		bindStatic(protocol, cache, "cache");
+		cache_bytes += clientWire->bytesWritten + serverWire->bytesWritten - before;
+		++bound;
+	};
+	server_sync.reconciled.advise(
+		serverLifetime, [&](CheckpointSync::Reconciliation const& r) { bind_cache(serverProtocol.get(), server_cache, r); });
+	client_sync.reconciled.advise(
+		clientLifetime, [&](CheckpointSync::Reconciliation const& r) { bind_cache(clientProtocol.get(), client_cache, r); });
+
+	bindStatic(serverProtocol.get(), server_sync, "sync");
+	bindStatic(clientProtocol.get(), client_sync, "sync");
+	ASSERT_EQ(2, bound);
+	EXPECT_EQ(0, cache_bytes);
+	EXPECT_EQ(L"three", *client_cache.get(3));
+
+	// the changes are sent as usual
+	server_cache.set(4, L"four");
+	EXPECT_EQ(L"four", *client_cache.get(4));
+
+	std::remove(path.c_str());
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, checkpoint_cold_restart)
+{
+	SerializationCtx ctx(&serializers);
+	Cache server_cache, client_cache;
+	CheckpointSync server_sync, client_sync;
+	statics(server_cache, 1);
+	statics(client_cache, 1);
+	statics(server_sync, 2);
+	statics(client_sync, 2);
+
+	// the checkpoint is behind the owning side
+	fill(client_cache);
+	fill(server_cache);
+	server_cache.set(2, L"changed");
+	client_sync.offer("cache", map_content_hash(ctx, client_cache));
+	server_sync.provide("cache", [&] { return map_content_hash(ctx, server_cache); });
+
+	server_sync.reconciled.advise(serverLifetime, [&](CheckpointSync::Reconciliation const& r) {
+		EXPECT_FALSE(r.warm);
+		bindStatic(serverProtocol.get(), server_cache, "cache");
+	});
+	client_sync.reconciled.advise(clientLifetime, [&](CheckpointSync::Reconciliation const& r) {
+		EXPECT_FALSE(r.warm);
+		client_cache.clear();
+		bindStatic(clientProtocol.get(), client_cache, "cache");
+	});
+
+	bindStatic(serverProtocol.get(), server_sync, "sync");
+	bindStatic(clientProtocol.get(), client_sync, "sync");
+	EXPECT_EQ(3, client_cache.size());
+	EXPECT_EQ(L"changed", *client_cache.get(2));
+
+	AfterTest();
+}
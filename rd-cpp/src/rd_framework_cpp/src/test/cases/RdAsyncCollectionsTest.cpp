@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "impl/AsyncRdMap.h"
+#include "impl/AsyncRdProperty.h"
+#include "impl/AsyncRdSet.h"
+#include "RdFrameworkTestBase.h"
+
+#include <thread>
+#include <vector>
+
+using namespace rd;
+using namespace test;
+
+namespace
+{
+const int THREADS = 4;
+const int CHANGES_PER_THREAD = 1000;
+
+template <typename F>
+void run_concurrently(F&& action)
+{
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads.emplace_back([&action, t] { action(t); });
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+}	 // namespace
+
+TEST_F(RdFrameworkTestBase, async_map_concurrent_changes)
+{
+	AsyncRdMap<int, int> server_map;
+	AsyncRdMap<int, int> client_map;
+
+	statics(server_map, static_entity_id);
+	statics(client_map, static_entity_id);
+
+	client_map.set(-1, -1);
+
+	bindStatic(serverProtocol.get(), server_map, static_name);
+	bindStatic(clientProtocol.get(), client_map, static_name);
+	EXPECT_EQ(-1, *server_map.get(-1));
+
+	int removed = 0;
+	server_map.advise(serverLifetime, [&](AsyncRdMap<int, int>::Event const& e) {
+		if (e.get_new_value() == nullptr)
+		{
+			++removed;
+		}
+	});
+
+	run_concurrently([&](int t) {
+		for (int i = 0; i < CHANGES_PER_THREAD; ++i)
+		{
+			const int key = t * CHANGES_PER_THREAD + i;
+			client_map.set(key, key);
+			if (i % 2 == 0)
+			{
+				client_map.remove(key);
+			}
+		}
+	});
+
+	EXPECT_EQ(THREADS * CHANGES_PER_THREAD / 2, removed);
+	EXPECT_EQ(client_map.size(), server_map.size());
+	server_map.with_lock([&] {
+		for (auto it = server_map.begin(); it != server_map.end(); ++it)
+		{
+			EXPECT_EQ(it.key(), it.value());
+			EXPECT_EQ(it.value(), *client_map.get(it.key()));
+		}
+	});
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, async_set_concurrent_changes)
+{
+	AsyncRdSet<int> server_set;
+	AsyncRdSet<int> client_set;
+
+	statics(server_set, static_entity_id);
+	statics(client_set, static_entity_id);
+
+	bindStatic(serverProtocol.get(), server_set, static_name);
+	bindStatic(clientProtocol.get(), client_set, static_name);
+
+	run_concurrently([&](int t) {
+		for (int i = 0; i < CHANGES_PER_THREAD; ++i)
+		{
+			client_set.add(t * CHANGES_PER_THREAD + i);
+		}
+	});
+
+	EXPECT_EQ(static_cast<size_t>(THREADS * CHANGES_PER_THREAD), server_set.size());
+	EXPECT_TRUE(server_set.contains(THREADS * CHANGES_PER_THREAD - 1));
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, async_property_keeps_wire_order)
+{
+	AsyncRdProperty<int> server_property{0};
+	AsyncRdProperty<int> client_property{0};
+
+	statics(server_property, static_entity_id);
+	statics(client_property, static_entity_id);
+
+	bindStatic(serverProtocol.get(), server_property, static_name);
+	bindStatic(clientProtocol.get(), client_property, static_name);
+
+	std::vector<int> log;
+	server_property.advise(serverLifetime, [&](int v) { log.push_back(v); });
+
+	run_concurrently([&](int t) {
+		for (int i = 1; i <= CHANGES_PER_THREAD; ++i)
+		{
+			client_property.set(t * CHANGES_PER_THREAD + i);
+		}
+	});
+
+	// the last value set on the client is the last one received by the server
+	EXPECT_EQ(client_property.with_lock([&] { return client_property.get(); }), log.back());
+	EXPECT_EQ(client_property.get(), server_property.get());
+
+	AfterTest();
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include "context/ProtocolContexts.h"
+#include "impl/RdPerContextMap.h"
+#include "impl/RdProperty.h"
+#include "impl/RdSignal.h"
+#include "RdFrameworkTestBase.h"
+#include "SimpleWire.h"
+
+#include <string>
+#include <vector>
+
+using namespace rd;
+using namespace test;
+
+namespace
+{
+const RdContext<std::wstring> light_key{"test-light-key", false};
+const RdContext<std::wstring> heavy_key{"test-heavy-key", true};
+const RdContext<int32_t> int_key{"test-int-key", false};
+}	 // namespace
+
+TEST(RdContext, thread_local_value)
+{
+	EXPECT_FALSE(light_key.get_value());
+	{
+		auto cookie = light_key.update_value(std::wstring(L"a"));
+		EXPECT_EQ(L"a", *light_key.get_value());
+		{
+			auto nested = light_key.update_value(nullopt);
+			EXPECT_FALSE(light_key.get_value());
+		}
+		EXPECT_EQ(L"a", *light_key.get_value());
+
+		// contexts with the same key share the value
+		const RdContext<std::wstring> same_key{"test-light-key", false};
+		EXPECT_EQ(L"a", *same_key.get_value());
+	}
+	EXPECT_FALSE(light_key.get_value());
+}
+
+TEST_F(RdFrameworkTestBase, context_values_reach_handlers)
+{
+	for (auto protocol : {clientProtocol.get(), serverProtocol.get()})
+	{
+		protocol->get_contexts().register_context(light_key);
+		protocol->get_contexts().register_context(int_key);
+	}
+
+	RdSignal<int32_t> server_signal;
+	RdSignal<int32_t> client_signal;
+	statics(server_signal, static_entity_id);
+	statics(client_signal, static_entity_id);
+	bindStatic(serverProtocol.get(), server_signal, static_name);
+	bindStatic(clientProtocol.get(), client_signal, static_name);
+
+	std::vector<std::wstring> log;
+	server_signal.advise(serverLifetime, [&](int32_t v) {
+		auto const& key = light_key.get_value();
+		auto const& number = int_key.get_value();
+		log.push_back(std::to_wstring(v) + L":" + (key ? *key : L"-") + L":" + (number ? std::to_wstring(*number) : L"-"));
+	});
+
+	client_signal.fire(1);
+	{
+		auto cookie = light_key.update_value(std::wstring(L"a"));
+		auto number = int_key.update_value(42);
+		client_signal.fire(2);
+	}
+	client_signal.fire(3);
+
+	EXPECT_EQ((std::vector<std::wstring>{L"1:-:-", L"2:a:42", L"3:-:-"}), log);
+	// the handler doesn't leak the values to the receiving thread
+	EXPECT_FALSE(light_key.get_value());
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, heavy_context_interns_values)
+{
+	clientProtocol->get_contexts().register_context(heavy_key);
+	serverProtocol->get_contexts().register_context(heavy_key);
+
+	RdSignal<int32_t> server_signal;
+	RdSignal<int32_t> client_signal;
+	statics(server_signal, static_entity_id);
+	statics(client_signal, static_entity_id);
+	bindStatic(serverProtocol.get(), server_signal, static_name);
+	bindStatic(clientProtocol.get(), client_signal, static_name);
+
+	std::vector<std::wstring> log;
+	server_signal.advise(serverLifetime, [&](int32_t) { log.push_back(*heavy_key.get_value()); });
+
+	const std::wstring value(100, L'x');
+	auto cookie = heavy_key.update_value(value);
+
+	const auto before = clientWire->bytesWritten;
+	client_signal.fire(1);
+	const auto first = clientWire->bytesWritten - before;
+	client_signal.fire(2);
+	const auto second = clientWire->bytesWritten - before - first;
+
+	EXPECT_EQ((std::vector<std::wstring>{value, value}), log);
+	// the value went once with the interning message, later messages refer to it by id
+	EXPECT_GT(first, value.size() * sizeof(char16_t));
+	EXPECT_LT(second, value.size());
+	EXPECT_TRUE(serverProtocol->get_contexts().get_value_set(heavy_key).contains_value(value));
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, per_context_map)
+{
+	clientProtocol->get_contexts().register_context(heavy_key);
+	serverProtocol->get_contexts().register_context(heavy_key);
+
+	auto factory = [](bool is_master) {
+		RdProperty<int32_t> property(0);
+		property.is_master = is_master;
+		return property;
+	};
+	RdPerContextMap<std::wstring, RdProperty<int32_t>> server_map(heavy_key, factory);
+	RdPerContextMap<std::wstring, RdProperty<int32_t>> client_map(heavy_key, factory);
+	server_map.is_master = true;
+
+	statics(server_map, static_entity_id);
+	statics(client_map, static_entity_id);
+	bindStatic(serverProtocol.get(), server_map, static_name);
+	bindStatic(clientProtocol.get(), client_map, static_name);
+
+	EXPECT_EQ(0u, server_map.size());
+	{
+		auto cookie = heavy_key.update_value(std::wstring(L"first"));
+		clientProtocol->get_contexts().get_context_handler(heavy_key).register_value_in_value_set();
+
+		// both sides get an entry for the value and bind it under the same id
+		ASSERT_NE(nullptr, server_map.get(L"first"));
+		client_map.get_for_current_context().set(5);
+		EXPECT_EQ(5, server_map.get(L"first")->get());
+	}
+	{
+		auto cookie = heavy_key.update_value(std::wstring(L"second"));
+		serverProtocol->get_contexts().get_context_handler(heavy_key).register_value_in_value_set();
+		server_map.get_for_current_context().set(7);
+		EXPECT_EQ(7, client_map.get_for_current_context().get());
+	}
+	EXPECT_EQ(2u, client_map.size());
+	EXPECT_EQ(0, client_map.get(L"second") == nullptr);
+
+	AfterTest();
+}
@@ -143,3 +143,44 @@ TEST_F(SocketWireTestBase, /*DISABLED_*/ testSlowpokeExtension)
 
 	terminate();
 }
+
+namespace
+{
+struct CoalescingExtProperty : ExtProperty<std::wstring>
+{
+	explicit CoalescingExtProperty(std::wstring value) : ExtProperty<std::wstring>(std::move(value))
+	{
+		property.coalesce_sent = true;
+	}
+};
+}	 // namespace
+
+TEST_F(SocketWireTestBase, testExtensionCoalescesSentValues)
+{
+	const Protocol serverProtocol = server(socketLifetime);
+	const Protocol clientProtocol = client(socketLifetime, serverProtocol);
+
+	const RdProperty<int> serverProperty{0}, clientProperty{0};
+	init(serverProtocol, clientProtocol, &serverProperty, &clientProperty);
+
+	auto const& serverExt = serverProperty.getOrCreateExtension<CoalescingExtProperty>("data", L"SERVER");
+
+	// queued by the ext wire until the counterpart creates its extension, the latest value replaces the earlier one
+	serverExt.property.set(L"UPDATE");
+	serverExt.property.set(L"UPGRADE");
+
+	rd::util::sleep_this_thread(200);
+
+	auto const& clientExt = clientProperty.getOrCreateExtension<CoalescingExtProperty>("data", L"CLIENT");
+	std::vector<std::wstring> clientLog;
+	clientExt.property.advise(socketLifetime, [&](std::wstring const& value) { clientLog.push_back(value); });
+
+	clientScheduler.pump_one_message();
+	clientScheduler.pump_one_message();	   // send "UPGRADE"
+	checkSchedulersAreEmpty();
+
+	EXPECT_EQ((std::vector<std::wstring>{L"CLIENT", L"UPGRADE"}), clientLog);
+	EXPECT_EQ(serverExt.property.get(), L"UPGRADE");
+
+	terminate();
+}
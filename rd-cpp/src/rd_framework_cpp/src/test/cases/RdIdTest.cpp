@@ -22,4 +22,52 @@ TEST(rd_id, constexprness)
 {
 	constexpr auto hash = getPlatformIndependentHash("InternScopeInExt");
 	EXPECT_EQ(-4122988489618686035L, hash);
-}
\ No newline at end of file
+}
+
+namespace
+{
+// the hash as it's written on the other sides, a char at a time
+hash_t reference_hash(string_view that, constexpr_hash_t initial = DEFAULT_HASH)
+{
+	for (char c : that)
+	{
+		initial = initial * HASH_FACTOR + c;
+	}
+	return static_cast<hash_t>(initial);
+}
+}	 // namespace
+
+TEST(rd_id, hash_matches_reference)
+{
+	std::string value;
+	for (int i = 0; i < 64; ++i)
+	{
+		EXPECT_EQ(reference_hash(value), getPlatformIndependentHash(value)) << value;
+		value += static_cast<char>(i % 2 == 0 ? 'a' + i % 26 : -i);
+	}
+	EXPECT_EQ(reference_hash("", 42), getPlatformIndependentHash("", 42));
+}
+
+TEST(rd_id, mix_tail)
+{
+	constexpr RdId::Tail tail(".value");
+	constexpr RdId id = RdId(-5123855772550266649L).mix(tail);
+	EXPECT_EQ(RdId(-5123855772550266649L).mix(".value"), id);
+	EXPECT_EQ(RdId::Null().mix(""), RdId::Null().mix(RdId::Tail("")));
+	EXPECT_EQ(RdId::Null().mix("InternScopeInExt"), RdId::Null().mix(RdId::Tail("InternScopeInExt")));
+}
+
+TEST(rd_id, next_range)
+{
+	Identities single(Identities::SERVER);
+	Identities bulk(Identities::SERVER);
+	const RdId parent = RdId::Null().mix("parent");
+
+	const Identities::Range range = bulk.next_range(parent, 3);
+	ASSERT_EQ(3, range.size());
+	for (int32_t i = 0; i < range.size(); ++i)
+	{
+		EXPECT_EQ(single.next(parent), range[i]);
+	}
+	EXPECT_EQ(single.next(parent), bulk.next(parent));
+}
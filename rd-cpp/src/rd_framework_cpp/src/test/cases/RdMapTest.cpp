@@ -112,6 +112,53 @@ TEST_F(RdFrameworkTestBase, rd_map_dynamic)
 	AfterTest();
 }
 
+TEST_F(RdFrameworkTestBase, rd_map_coalesces_sent_changes)
+{
+	RdMap<int32_t, std::wstring> server_map;
+	RdMap<int32_t, std::wstring> client_map;
+	server_map.is_master = true;
+	client_map.is_master = false;
+	server_map.coalesce_sent = true;
+
+	statics(server_map, 1);
+	statics(client_map, 1);
+	server_map.optimize_nested = true;
+	client_map.optimize_nested = true;
+
+	bindStatic(clientProtocol.get(), client_map, static_name);
+	bindStatic(serverProtocol.get(), server_map, static_name);
+
+	std::vector<std::string> log;
+	client_map.advise(Lifetime::Eternal(),
+		[&](typename IViewableMap<int32_t, std::wstring>::Event entry) { log.push_back(to_string(entry)); });
+
+	// the changes of an entry made while the wire is paused supersede each other
+	serverWire->set_auto_flush(false);
+	server_map.set(1, L"added");
+	server_map.set(1, L"updated");
+	server_map.set(2, L"added");
+	server_map.remove(2);
+	server_map.set(3, L"added");
+	EXPECT_EQ(3, serverWire->msgQ.size());
+	serverWire->set_auto_flush(true);
+
+	// the slave gets the latest state of each entry, the update of an entry it hasn't seen adds it
+	EXPECT_EQ(2, client_map.size());
+	EXPECT_EQ(L"updated", *client_map.get(1));
+	EXPECT_EQ(nullptr, client_map.get(2));
+	EXPECT_EQ(L"added", *client_map.get(3));
+	EXPECT_EQ((std::vector<std::string>{"Add 1:updated", "Add 3:added"}), log);
+
+	// the slave acknowledged the latest versions, so nothing is pending for ACK: the master takes the changes of the
+	// slave instead of rejecting them as older than its own
+	client_map.set(1, L"client");
+	client_map.set(3, L"client");
+	EXPECT_EQ(L"client", *server_map.get(1));
+	EXPECT_EQ(L"client", *server_map.get(3));
+
+	AfterTest();
+}
+
 TEST_F(RdFrameworkTestBase, rd_map_move)
 {
 	RdMap<int, int> map1;
@@ -11,6 +11,51 @@ using namespace rd;
 using namespace test;
 using namespace test::util;
 
+namespace
+{
+// executes the actions received in a burst when it's flushed, as a UI thread does
+class QueuedScheduler final : public IScheduler
+{
+public:
+	std::vector<std::function<void()>> actions;
+
+	void queue(std::function<void()> action) override
+	{
+		actions.push_back(std::move(action));
+	}
+
+	void flush() override
+	{
+		auto burst = std::move(actions);
+		actions.clear();
+		for (auto& action : burst)
+		{
+			action();
+		}
+	}
+
+	bool is_active() const override
+	{
+		return true;
+	}
+};
+
+class QueuedRdProperty final : public RdProperty<int32_t>
+{
+public:
+	IScheduler* scheduler = nullptr;
+
+	explicit QueuedRdProperty(int32_t value) : RdProperty<int32_t>(value)
+	{
+	}
+
+	IScheduler* get_wire_scheduler() const override
+	{
+		return scheduler;
+	}
+};
+}	 // namespace
+
 TEST_F(RdFrameworkTestBase, property_statics)
 {
 	int property_id = 1;
@@ -386,3 +431,81 @@ TEST_F(RdFrameworkTestBase, property_uninitialized)
 
 	AfterTest();
 }
+
+TEST_F(RdFrameworkTestBase, property_coalesces_received_values)
+{
+	QueuedScheduler scheduler;
+
+	RdProperty<int32_t> client_progress(0), client_caret(0);
+	QueuedRdProperty server_progress(0), server_caret(0);
+	server_progress.scheduler = &scheduler;
+	server_caret.scheduler = &scheduler;
+	server_progress.coalesce_received = true;
+	client_progress.is_master = true;
+
+	statics(client_progress, 1);
+	statics(server_progress, 1);
+	statics(client_caret, 2);
+	statics(server_caret, 2);
+
+	std::vector<std::string> server_log;
+	server_progress.advise(Lifetime::Eternal(), [&](int32_t v) { server_log.push_back("p" + std::to_string(v)); });
+	server_caret.advise(Lifetime::Eternal(), [&](int32_t v) { server_log.push_back("c" + std::to_string(v)); });
+
+	bindStatic(serverProtocol.get(), server_progress, "progress");
+	bindStatic(clientProtocol.get(), client_progress, "progress");
+	bindStatic(serverProtocol.get(), server_caret, "caret");
+	bindStatic(clientProtocol.get(), client_caret, "caret");
+
+	for (int32_t i = 1; i <= 10; ++i)
+	{
+		client_progress.set(i);
+	}
+	client_caret.set(1);
+	client_caret.set(2);
+	client_progress.set(11);
+	scheduler.flush();
+
+	// the latest progress comes after the caret updates received before it, the caret isn't coalesced
+	EXPECT_EQ((std::vector<std::string>{"p0", "c0", "c1", "c2", "p11"}), server_log);
+	EXPECT_EQ(11, server_progress.get());
+
+	// the versions of the dropped values aren't lost, the master accepts the value set on top of the latest one
+	server_progress.set(20);
+	EXPECT_EQ(20, client_progress.get());
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, property_coalesces_sent_values)
+{
+	RdProperty<int32_t> client_property(0), server_property(0);
+	client_property.is_master = true;
+	client_property.coalesce_sent = true;
+
+	statics(client_property, 1);
+	statics(server_property, 1);
+	bindStatic(serverProtocol.get(), server_property, static_name);
+	bindStatic(clientProtocol.get(), client_property, static_name);
+
+	std::vector<int32_t> server_log;
+	server_property.advise(Lifetime::Eternal(), [&](int32_t v) { server_log.push_back(v); });
+
+	// the values set while the wire is paused supersede each other
+	clientWire->set_auto_flush(false);
+	for (int32_t i = 1; i <= 5; ++i)
+	{
+		client_property.set(i);
+	}
+	EXPECT_EQ(1, clientWire->msgQ.size());
+	clientWire->set_auto_flush(true);
+
+	EXPECT_EQ((std::vector<int32_t>{0, 5}), server_log);
+	EXPECT_EQ(5, server_property.get());
+
+	// the versions of the dropped values aren't lost, the master accepts the value set on top of the latest one
+	server_property.set(7);
+	EXPECT_EQ(7, client_property.get());
+
+	AfterTest();
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "impl/RdProperty.h"
+#include "impl/RdSet.h"
+#include "impl/RdSignal.h"
+#include "RdFrameworkTestBase.h"
+#include "SimpleWire.h"
+
+#include <string>
+#include <vector>
+
+using namespace rd;
+using namespace test;
+
+using vs = std::vector<std::string>;
+
+TEST_F(RdFrameworkTestBase, snapshot_of_initial_values)
+{
+	RdSet<int32_t> server_set, client_set;
+	RdProperty<int32_t> server_property, client_property;
+	RdSignal<int32_t> server_signal, client_signal;
+
+	statics(server_set, 1);
+	statics(client_set, 1);
+	statics(server_property, 2);
+	statics(client_property, 2);
+	statics(server_signal, 3);
+	statics(client_signal, 3);
+
+	bindStatic(serverProtocol.get(), server_set, "set");
+	bindStatic(serverProtocol.get(), server_property, "property");
+	bindStatic(serverProtocol.get(), server_signal, "signal");
+
+	vs log;
+	server_set.advise(serverLifetime, [&](AddRemove kind, int32_t v) {
+		log.push_back((kind == AddRemove::ADD ? "+" : "-") + std::to_string(v));
+	});
+	server_property.advise(serverLifetime, [&](int32_t v) { log.push_back("p" + std::to_string(v)); });
+	server_signal.advise(serverLifetime, [&](int32_t v) { log.push_back("s" + std::to_string(v)); });
+
+	client_set.addAll({1, 2, 3});
+
+	setWireAutoFlush(false);
+	clientProtocol->get_wire()->send_snapshot([&] {
+		bindStatic(clientProtocol.get(), client_set, "set");
+		bindStatic(clientProtocol.get(), client_property, "property");
+		bindStatic(clientProtocol.get(), client_signal, "signal");
+		client_property.set(4);
+		client_signal.fire(5);
+	});
+	EXPECT_EQ(1, clientWire->msgQ.size());
+	EXPECT_EQ(vs(), log);
+
+	clientWire->process_all_messages();
+	EXPECT_EQ((vs{"+1", "+2", "+3", "p4", "s5"}), log);
+
+	// the later changes are sent one by one
+	client_set.remove(2);
+	client_property.set(6);
+	EXPECT_EQ(2, clientWire->msgQ.size());
+	clientWire->process_all_messages();
+	EXPECT_EQ((vs{"+1", "+2", "+3", "p4", "s5", "-2", "p6"}), log);
+
+	setWireAutoFlush(true);
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, snapshot_without_messages)
+{
+	RdSignal<int32_t> client_signal;
+	statics(client_signal, 1);
+
+	setWireAutoFlush(false);
+	clientProtocol->get_wire()->send_snapshot([&] { bindStatic(clientProtocol.get(), client_signal, static_name); });
+	EXPECT_TRUE(clientWire->msgQ.empty());
+
+	setWireAutoFlush(true);
+	AfterTest();
+}
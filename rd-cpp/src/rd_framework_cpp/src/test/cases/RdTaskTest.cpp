@@ -6,7 +6,9 @@
 #include "task/RdCall.h"
 #include "task/RdEndpoint.h"
 #include "task/RdSymmetricCall.h"
+#include "wire/WireUtil.h"
 
+#include <atomic>
 #include <string>
 
 using namespace rd;
@@ -81,6 +83,53 @@ TEST_F(RdFrameworkTestBase, testStaticFailure)
 	AfterTest();
 }
 
+TEST_F(RdFrameworkTestBase, testStaticTimeout)
+{
+	RdCall<int, std::wstring> client_entity;
+	RdEndpoint<int, std::wstring> server_entity;
+	RdTask<std::wstring> never_set;
+	server_entity.set([&](const Lifetime&, int const&) { return never_set; });
+
+	statics(client_entity, static_entity_id);
+	statics(server_entity, static_entity_id);
+
+	bindStatic(serverProtocol.get(), server_entity, static_name);
+	bindStatic(clientProtocol.get(), client_entity, static_name);
+
+	std::atomic_bool faulted{false};
+	auto task = client_entity.start(2, std::chrono::milliseconds(20));
+	task.advise(Lifetime::Eternal(), [&](RdTaskResult<std::wstring> const& result) { faulted = result.is_faulted(); });
+	EXPECT_FALSE(task.has_value());
+
+	for (int32_t i = 0; i < 5000 && !faulted; ++i)
+	{
+		util::sleep_this_thread(1);
+	}
+	EXPECT_TRUE(faulted);
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, testStaticTimeoutCancelledByResult)
+{
+	RdCall<int, std::wstring> client_entity;
+	RdEndpoint<int, std::wstring> server_entity([](int const& it) -> std::wstring { return std::to_wstring(it); });
+
+	statics(client_entity, static_entity_id);
+	statics(server_entity, static_entity_id);
+
+	bindStatic(serverProtocol.get(), server_entity, static_name);
+	bindStatic(clientProtocol.get(), client_entity, static_name);
+
+	const size_t timers = TimerWheel::instance().size();
+	auto task = client_entity.start(2, std::chrono::seconds(60));
+	EXPECT_EQ(L"2", task.value_or_throw().unwrap());
+	// the completed call leaves no timer behind
+	EXPECT_EQ(timers, TimerWheel::instance().size());
+
+	AfterTest();
+}
+
 TEST_F(RdFrameworkTestBase, testSymmetricCall)
 {
 	RdSymmetricCall<std::wstring, int32_t> server_entity, client_entity;
@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+#include "RdTextBuffer.h"
+#include "RdFrameworkTestBase.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rd;
+using namespace test;
+
+namespace
+{
+void bind_buffer(IProtocol* protocol, Lifetime lifetime, RdTextBuffer const& buffer)
+{
+	buffer.identify(*protocol->get_identity(), RdId(1));
+	buffer.bind(lifetime, protocol, "top");
+}
+
+std::vector<RdTextChangeKind> kinds_of(std::vector<RdTextChange> const& changes)
+{
+	std::vector<RdTextChangeKind> result;
+	for (auto const& change : changes)
+	{
+		result.push_back(change.kind);
+	}
+	return result;
+}
+}	 // namespace
+
+TEST(TextRope, random_edits)
+{
+	std::mt19937 random(42);
+	TextRope rope;
+	std::wstring expected;
+	for (int i = 0; i < 5000; ++i)
+	{
+		const size_t offset = random() % (expected.size() + 1);
+		const auto action = random() % 10;
+		if (action < 5)
+		{
+			// long inserts make the chunks split
+			const std::wstring text(action == 0 ? random() % 3000 : random() % 8 + 1, static_cast<wchar_t>(L'a' + i % 26));
+			rope.insert(offset, text);
+			expected.insert(offset, text);
+		}
+		else if (action < 8)
+		{
+			const size_t count = random() % (action == 5 ? 2000 : 8) % (expected.size() - offset + 1);
+			rope.erase(offset, count);
+			expected.erase(offset, count);
+		}
+		else
+		{
+			const size_t count = random() % 8 % (expected.size() - offset + 1);
+			rope.replace(offset, count, L"xyz");
+			expected.replace(offset, count, L"xyz");
+		}
+		ASSERT_EQ(expected.size(), rope.size());
+		if (i % 100 == 0)
+		{
+			ASSERT_EQ(expected, rope.to_wstring());
+			const size_t from = random() % (expected.size() + 1);
+			const size_t count = random() % (expected.size() - from + 1);
+			ASSERT_EQ(expected.substr(from, count), rope.substr(from, count));
+			if (from < expected.size())
+			{
+				ASSERT_EQ(expected[from], rope.at(from));
+			}
+		}
+	}
+	EXPECT_EQ(expected, rope.to_wstring());
+
+	rope.assign(L"abc");
+	EXPECT_EQ(L"abc", rope.to_wstring());
+	rope.clear();
+	EXPECT_TRUE(rope.empty());
+}
+
+TEST(TextRope, utf16_offsets)
+{
+	// a surrogate pair in UTF-16, a single wchar_t where it's UTF-32
+	const std::wstring smile = L"\U0001F600";
+	const size_t smile_length = smile.size();
+
+	TextRope rope(L"a" + smile + L"b");
+	EXPECT_EQ(4u, rope.utf16_size());
+	EXPECT_EQ(4u, TextRope::utf16_length(rope.to_wstring()));
+	EXPECT_EQ(1u, rope.to_utf16_offset(1));
+	EXPECT_EQ(3u, rope.to_utf16_offset(1 + smile_length));
+	EXPECT_EQ(1u, rope.from_utf16_offset(1));
+	EXPECT_EQ(1 + smile_length, rope.from_utf16_offset(3));
+	EXPECT_EQ(rope.size(), rope.from_utf16_offset(4));
+	if (smile_length == 1)
+	{
+		EXPECT_THROW(rope.from_utf16_offset(2), std::runtime_error);
+	}
+
+	// the counts survive the edits which split and merge chunks
+	std::mt19937 random(7);
+	std::wstring expected = rope.to_wstring();
+	for (int i = 0; i < 2000; ++i)
+	{
+		const size_t offset = random() % (expected.size() + 1);
+		if (random() % 3 > 0)
+		{
+			std::wstring text;
+			for (size_t j = random() % (i % 10 == 0 ? 1500 : 8); j > 0; --j)
+			{
+				text += random() % 4 == 0 ? smile : L"x";
+			}
+			rope.insert(offset, text);
+			expected.insert(offset, text);
+		}
+		else
+		{
+			const size_t count = (std::min)(expected.size() - offset, static_cast<size_t>(random() % 1000));
+			rope.erase(offset, count);
+			expected.erase(offset, count);
+		}
+		if (i % 50 == 0)
+		{
+			size_t units = 0;
+			for (size_t position = 0; position < expected.size(); ++position)
+			{
+				ASSERT_EQ(units, rope.to_utf16_offset(position));
+				ASSERT_EQ(position, rope.from_utf16_offset(units));
+				units += static_cast<uint32_t>(expected[position]) > 0xFFFFu ? 2 : 1;
+			}
+			ASSERT_EQ(units, rope.utf16_size());
+		}
+	}
+}
+
+TEST(RdTextChange, reverse)
+{
+	RdTextChange change(RdTextChangeKind::Replace, 3, L"ab", L"xyz", 10);
+	RdTextChange reversed = change.reverse();
+	EXPECT_EQ(RdTextChange(RdTextChangeKind::Replace, 3, L"xyz", L"ab", 9), reversed);
+	EXPECT_EQ(change, reversed.reverse());
+
+	EXPECT_EQ(RdTextChangeKind::Remove, RdTextChange(RdTextChangeKind::InsertLeftSide, 0, L"", L"a", 1).reverse().kind);
+	EXPECT_THROW(RdTextChange(RdTextChangeKind::Reset, 0, L"", L"a", 1).reverse(), std::invalid_argument);
+}
+
+TEST(RdTextChange, serialization)
+{
+	SerializationCtx ctx{nullptr};
+	Buffer buffer;
+	RdTextBufferChange change(TextBufferVersion(3, -1), RdChangeOrigin::Master,
+		RdTextChange(RdTextChangeKind::InsertRightSide, 5, L"", L"text", 42));
+	change.write(ctx, buffer);
+
+	// int32 master, int32 slave, int32 origin, then the change
+	Buffer reader(buffer.getRealArray());
+	EXPECT_EQ(3, reader.read_integral<int32_t>());
+	EXPECT_EQ(-1, reader.read_integral<int32_t>());
+	EXPECT_EQ(1, reader.read_integral<int32_t>());
+	EXPECT_EQ(6, reader.read_integral<int32_t>());
+	EXPECT_EQ(5, reader.read_integral<int32_t>());
+
+	reader.rewind();
+	EXPECT_EQ(change, RdTextBufferChange::read(ctx, reader));
+}
+
+TEST_F(RdFrameworkTestBase, text_buffer_sync)
+{
+	RdTextBuffer server_buffer(true);
+	RdTextBuffer client_buffer(false);
+
+	std::vector<RdTextChange> client_log;
+	std::vector<RdTextChange> server_log;
+
+	bind_buffer(serverProtocol.get(), serverLifetime, server_buffer);
+	bind_buffer(clientProtocol.get(), clientLifetime, client_buffer);
+
+	server_buffer.advise(serverLifetime, [&](RdTextChange const& change) { server_log.push_back(change); });
+	client_buffer.advise(clientLifetime, [&](RdTextChange const& change) { client_log.push_back(change); });
+
+	server_buffer.reset(L"Hello world");
+	EXPECT_EQ(L"Hello world", client_buffer.get_text());
+	EXPECT_EQ(TextBufferVersion(0, -1), client_buffer.get_buffer_version());
+
+	client_buffer.insert(5, L",");
+	server_buffer.replace(7, 5, L"there");
+	client_buffer.remove(0, 1);
+	server_buffer.insert(0, L"h");
+
+	EXPECT_EQ(L"hello, there", server_buffer.get_text());
+	EXPECT_EQ(L"hello, there", client_buffer.get_text());
+	EXPECT_EQ(server_buffer.get_buffer_version(), client_buffer.get_buffer_version());
+	EXPECT_EQ(TextBufferVersion(2, 1), server_buffer.get_buffer_version());
+
+	// local changes aren't reported
+	EXPECT_EQ(
+		(std::vector<RdTextChangeKind>{RdTextChangeKind::Reset, RdTextChangeKind::Replace, RdTextChangeKind::Insert}),
+		kinds_of(client_log));
+	EXPECT_EQ((std::vector<RdTextChangeKind>{RdTextChangeKind::Insert, RdTextChangeKind::Remove}), kinds_of(server_log));
+
+	server_buffer.assert_state();
+	client_buffer.assert_state();
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, text_buffer_conflict)
+{
+	RdTextBuffer server_buffer(true);
+	RdTextBuffer client_buffer(false);
+
+	std::vector<RdTextChange> client_log;
+
+	bind_buffer(serverProtocol.get(), serverLifetime, server_buffer);
+	bind_buffer(clientProtocol.get(), clientLifetime, client_buffer);
+
+	client_buffer.advise(clientLifetime, [&](RdTextChange const& change) { client_log.push_back(change); });
+
+	server_buffer.reset(L"abc");
+
+	setWireAutoFlush(false);
+
+	client_buffer.insert(3, L"Y");
+	client_buffer.insert(0, L"Z");
+	server_buffer.insert(0, L"X");
+	EXPECT_EQ(L"ZabcY", client_buffer.get_text());
+	EXPECT_EQ(L"Xabc", server_buffer.get_text());
+
+	setWireAutoFlush(true);
+
+	// master rejects the slave changes, slave rolls them back in reverse order
+	EXPECT_EQ(L"Xabc", server_buffer.get_text());
+	EXPECT_EQ(L"Xabc", client_buffer.get_text());
+	EXPECT_EQ((std::vector<RdTextChangeKind>{RdTextChangeKind::Reset, RdTextChangeKind::Remove, RdTextChangeKind::Remove,
+				  RdTextChangeKind::Insert}),
+		kinds_of(client_log));
+	EXPECT_EQ(L"Z", client_log[1].old_text);
+	EXPECT_EQ(L"Y", client_log[2].old_text);
+
+	// the sides are in sync again
+	client_buffer.insert(4, L"!");
+	EXPECT_EQ(L"Xabc!", server_buffer.get_text());
+	EXPECT_EQ(server_buffer.get_buffer_version(), client_buffer.get_buffer_version());
+
+	AfterTest();
+}
+
+TEST_F(RdFrameworkTestBase, text_buffer_counts_utf16_units_on_the_wire)
+{
+	const std::wstring smile = L"\U0001F600";
+	const auto smile_length = static_cast<int32_t>(smile.size());
+
+	RdTextBuffer server_buffer(true);
+	// the other side, which counts offsets in UTF-16 code units
+	RdTextBufferState client_state;
+
+	bind_buffer(serverProtocol.get(), serverLifetime, server_buffer);
+	client_state.identify(*clientProtocol->get_identity(), RdId(1));
+	client_state.bind(clientLifetime, clientProtocol.get(), "top");
+
+	std::vector<RdTextChange> received;
+	client_state.get_changes().advise(clientLifetime, [&](Wrapper<RdTextBufferChange> const& change) {
+		if (change)
+		{
+			received.push_back(change->change);
+		}
+	});
+
+	server_buffer.reset(L"a" + smile + L"b");
+	server_buffer.insert(1 + smile_length, L"c");
+	ASSERT_EQ(2u, received.size());
+	EXPECT_EQ(RdTextChange(RdTextChangeKind::Reset, 0, L"", L"a" + smile + L"b", 4), received[0]);
+	EXPECT_EQ(RdTextChange(RdTextChangeKind::Insert, 3, L"", L"c", 5), received[1]);
+
+	std::vector<RdTextChange> server_log;
+	server_buffer.advise(serverLifetime, [&](RdTextChange const& change) { server_log.push_back(change); });
+
+	client_state.get_changes().set(Wrapper<RdTextBufferChange>(RdTextBufferChange(
+		TextBufferVersion(1, 0), RdChangeOrigin::Slave, RdTextChange(RdTextChangeKind::Remove, 4, L"b", L"", 4))));
+	EXPECT_EQ(L"a" + smile + L"c", server_buffer.get_text());
+	ASSERT_EQ(1u, server_log.size());
+	EXPECT_EQ(RdTextChange(RdTextChangeKind::Remove, 2 + smile_length, L"b", L"", 2 + smile_length), server_log[0]);
+
+	AfterTest();
+}
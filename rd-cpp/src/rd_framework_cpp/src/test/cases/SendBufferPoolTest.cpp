@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "wire/SendBufferPool.h"
+
+#include <thread>
+
+using namespace rd;
+
+TEST(SendBufferPoolTest, ReusesBuffersOfThread)
+{
+	Buffer::word_t const* memory;
+	{
+		SendBufferPool::Lease lease;
+		lease->set_string_encoding(StringEncoding::Compact);
+		lease->write_integral<int64_t>(42);
+		memory = lease->data();
+	}
+	{
+		SendBufferPool::Lease lease;
+		EXPECT_EQ(memory, lease->data());
+		EXPECT_EQ(0u, lease->get_position());
+		EXPECT_EQ(StringEncoding::Utf16, lease->get_string_encoding());
+
+		// nested sends get a buffer of their own
+		SendBufferPool::Lease nested;
+		EXPECT_NE(memory, nested->data());
+	}
+	std::thread([memory] {
+		SendBufferPool::Lease lease;
+		EXPECT_NE(memory, lease->data());
+	}).join();
+}
+
+TEST(SendBufferPoolTest, FreesOversizedBuffers)
+{
+	{
+		SendBufferPool::Lease lease;
+		lease->require_available(2 * SendBufferPool::MAX_RETAINED_SIZE);
+	}
+	SendBufferPool::Lease leases[SendBufferPool::MAX_POOLED_BUFFERS];
+	for (auto& lease : leases)
+	{
+		EXPECT_LE(lease->get_data().size(), SendBufferPool::MAX_RETAINED_SIZE);
+	}
+}
+
+TEST(SendBufferPoolTest, MovesLargeMessages)
+{
+	const Buffer::ByteArray small(16, 1);
+	const Buffer::ByteArray large(SendBufferPool::MAX_COPIED_SIZE + 1, 2);
+	Buffer::word_t const* memory;
+	{
+		SendBufferPool::Lease lease;
+		lease->write_byte_array_raw(small);
+		memory = lease->data();
+		const auto written = lease.take_written();
+		EXPECT_EQ(small, written);
+		EXPECT_NE(memory, written.data());
+	}
+	{
+		// the buffer small messages are copied out of stays pooled, a large message takes its storage away
+		SendBufferPool::Lease lease;
+		EXPECT_EQ(memory, lease->data());
+		lease->write_byte_array_raw(large);
+		memory = lease->data();
+		const auto written = lease.take_written();
+		EXPECT_EQ(large, written);
+		EXPECT_EQ(memory, written.data());
+	}
+	// the buffer starts over with room for a typical message
+	SendBufferPool::Lease lease;
+	EXPECT_EQ(0u, lease->get_position());
+	EXPECT_EQ(SendBufferPool::INITIAL_SIZE, lease->get_data().size());
+	memory = lease->data();
+	lease->write_byte_array_raw(small);
+	EXPECT_EQ(memory, lease->data());
+}
@@ -417,6 +417,45 @@ TEST_F(SocketWireTestBase, /*DISABLED_*/ TestRunWithSlowpokeServer)
 	terminate();
 }
 
+TEST_F(SocketWireTestBase, TestClientBacksOffUntilServerStarts)
+{
+	uint16_t port = find_free_port();
+	auto clientProtocol = client(socketLifetime, port);
+
+	RdSignal<int32_t> sp, cp;
+
+	statics(cp, property_id);
+	cp.bind(lifetime, &clientProtocol, static_name);
+
+	for (int32_t i = 0; i < 3; ++i)
+	{
+		cp.fire(i);
+	}
+
+	// the client keeps retrying meanwhile, with growing delays
+	sleep_this_thread(300);
+
+	auto serverProtocol = server(socketLifetime, port);
+
+	std::vector<int32_t> log;
+	statics(sp, property_id);
+	sp.advise(socketLifetime, [&](int32_t const& it) { log.push_back(it); });
+	sp.bind(lifetime, &serverProtocol, static_name);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int32_t i = 0; i < 3; ++i)
+	{
+		serverScheduler.pump_one_message();
+	}
+	EXPECT_LT(std::chrono::steady_clock::now() - start, SocketWire::Client::MAX_RECONNECT_DELAY * 2);
+
+	checkSchedulersAreEmpty();
+
+	EXPECT_EQ(log, (std::vector<int32_t>{0, 1, 2}));
+
+	terminate();
+}
+
 // new client has no information about already sent package by previous client :(
 TEST_F(SocketWireTestBase, DISABLED_TestFailoverServer)
 {
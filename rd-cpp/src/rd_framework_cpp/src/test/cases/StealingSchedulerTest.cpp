@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "scheduler/StealingScheduler.h"
+#include "wire/WireUtil.h"
+#include "lifetime/LifetimeDefinition.h"
+
+#include <atomic>
+
+using namespace rd;
+
+TEST(StealingSchedulerTest, Simple)
+{
+	LifetimeDefinition definition{false};
+	StealingScheduler s(definition.lifetime, "stealing-simple");
+	EXPECT_FALSE(s.is_active());
+
+	std::atomic_int32_t tasks_executed{0};
+	s.queue([&]() {
+		util::sleep_this_thread(100);
+		tasks_executed++;
+	});
+	s.queue([&]() {
+		tasks_executed++;
+		s.assert_thread();
+	});
+	s.flush();
+	EXPECT_EQ(2, tasks_executed);
+
+	s.queue([]() { throw std::invalid_argument(""); });
+	s.queue([&]() { tasks_executed++; });
+	s.flush();
+	EXPECT_EQ(3, tasks_executed);
+
+	// not derived from std::exception
+	s.queue([]() { throw 42; });
+	s.queue([&]() { tasks_executed++; });
+	s.flush();
+	EXPECT_EQ(4, tasks_executed);
+
+	definition.terminate();
+
+	// the stopped scheduler executes on the queueing thread
+	s.queue([&]() {
+		tasks_executed++;
+		EXPECT_TRUE(s.is_active());
+	});
+	EXPECT_EQ(5, tasks_executed);
+}
+
+TEST(StealingSchedulerTest, JoiningThreadIsActive)
+{
+	LifetimeDefinition definition{false};
+	StealingScheduler s(definition.lifetime, "stealing-active");
+
+	const int32_t count = 1000;
+	std::atomic_int32_t active{0};
+	int32_t inline_invocations = 0;
+	for (int32_t i = 0; i < count; ++i)
+	{
+		s.queue([&]() {
+			if (s.is_active())
+			{
+				++active;
+			}
+			// executed right away by whichever thread executes the action
+			bool invoked = false;
+			s.invoke_or_queue([&] { invoked = true; });
+			inline_invocations += invoked ? 1 : 0;
+		});
+	}
+	s.flush();
+	EXPECT_EQ(count, active);
+	EXPECT_EQ(count, inline_invocations);
+	EXPECT_FALSE(s.is_active());
+
+	definition.terminate();
+}
+
+TEST(StealingSchedulerTest, ReentrantJoin)
+{
+	LifetimeDefinition definition{false};
+	StealingScheduler s(definition.lifetime, "stealing-reentrant");
+
+	std::atomic_bool joined{false};
+	std::thread::id outer_thread;
+	std::thread::id inner_thread;
+	s.queue([&]() {
+		outer_thread = std::this_thread::get_id();
+		bool done = false;
+		s.queue([&]() {
+			inner_thread = std::this_thread::get_id();
+			done = true;
+		});
+		// a single threaded scheduler would only get to the action after this one
+		joined = s.join([&] { return done; }, std::chrono::milliseconds(1000));
+	});
+	s.flush();
+	EXPECT_TRUE(joined);
+	EXPECT_EQ(outer_thread, inner_thread);
+
+	definition.terminate();
+}
+
+TEST(StealingSchedulerTest, StoppedByOwnAction)
+{
+	LifetimeDefinition definition{false};
+	std::atomic_int32_t tasks_executed{0};
+	{
+		StealingScheduler s(definition.lifetime, "stealing-own-stop");
+		s.queue([&]() {
+			definition.terminate();
+			tasks_executed++;
+		});
+		// queued before the stop, so still executed
+		s.queue([&]() { tasks_executed++; });
+		s.flush();
+		util::sleep_this_thread(50);
+	}
+	EXPECT_EQ(2, tasks_executed);
+}
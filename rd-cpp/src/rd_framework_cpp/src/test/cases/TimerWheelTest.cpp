@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "scheduler/TimerWheel.h"
+#include "wire/WireUtil.h"
+#include "lifetime/LifetimeDefinition.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+using namespace rd;
+using namespace std::chrono;
+
+namespace
+{
+template <typename F>
+bool wait_until(F&& condition, milliseconds timeout = milliseconds(5000))
+{
+	const auto deadline = steady_clock::now() + timeout;
+	while (!condition())
+	{
+		if (steady_clock::now() >= deadline)
+		{
+			return false;
+		}
+		util::sleep_this_thread(1);
+	}
+	return true;
+}
+}	 // namespace
+
+TEST(TimerWheelTest, FiresInOrderAcrossLevels)
+{
+	// ticks of 10us, so the delays below are kept on every level of the wheel
+	TimerWheel wheel(microseconds(10));
+	LifetimeDefinition definition{false};
+
+	std::mutex lock;
+	std::vector<int32_t> fired;
+	std::vector<steady_clock::duration> late;
+	const auto start = steady_clock::now();
+	const std::vector<microseconds> delays{microseconds(60000), microseconds(200), microseconds(5000), microseconds(0),
+		microseconds(2500)};
+	for (int32_t i = 0; i < static_cast<int32_t>(delays.size()); ++i)
+	{
+		const auto delay = delays[i];
+		wheel.schedule(definition.lifetime, delay, [&, i, delay] {
+			std::lock_guard<std::mutex> guard(lock);
+			fired.push_back(i);
+			late.push_back(steady_clock::now() - start - delay);
+		});
+	}
+
+	ASSERT_TRUE(wait_until([&] {
+		std::lock_guard<std::mutex> guard(lock);
+		return fired.size() == delays.size();
+	}));
+	EXPECT_EQ((std::vector<int32_t>{3, 1, 4, 2, 0}), fired);
+	for (auto const& lateness : late)
+	{
+		EXPECT_GE(lateness, steady_clock::duration::zero());
+	}
+}
+
+TEST(TimerWheelTest, RepeatsUntilTerminated)
+{
+	LifetimeDefinition definition{false};
+	std::atomic_int32_t count{0};
+	TimerWheel::instance().schedule_repeating(definition.lifetime, milliseconds(2), [&] { ++count; });
+
+	ASSERT_TRUE(wait_until([&] { return count >= 3; }));
+	definition.terminate();
+	const int32_t after_termination = count;
+	util::sleep_this_thread(20);
+	EXPECT_EQ(after_termination, count);
+}
+
+TEST(TimerWheelTest, TerminationCancelsAndWaits)
+{
+	LifetimeDefinition cancelled{false};
+	std::atomic_bool cancelled_fired{false};
+	TimerWheel::instance().schedule(cancelled.lifetime, milliseconds(10), [&] { cancelled_fired = true; });
+	cancelled.terminate();
+
+	LifetimeDefinition running{false};
+	std::atomic_bool started{false};
+	std::atomic_bool finished{false};
+	TimerWheel::instance().schedule(running.lifetime, milliseconds(0), [&] {
+		started = true;
+		util::sleep_this_thread(50);
+		finished = true;
+	});
+	ASSERT_TRUE(wait_until([&] { return started.load(); }));
+	// the action being executed is waited for
+	running.terminate();
+	EXPECT_TRUE(finished);
+
+	util::sleep_this_thread(20);
+	EXPECT_FALSE(cancelled_fired);
+}
+
+TEST(TimerWheelTest, ActionTerminatesItsLifetime)
+{
+	LifetimeDefinition definition{false};
+	std::atomic_int32_t count{0};
+	TimerWheel::instance().schedule_repeating(definition.lifetime, milliseconds(1), [&] {
+		if (++count == 2)
+		{
+			definition.terminate();
+		}
+	});
+	ASSERT_TRUE(wait_until([&] { return definition.is_terminated(); }));
+	util::sleep_this_thread(10);
+	EXPECT_EQ(2, count);
+}
@@ -1,5 +1,7 @@
 #include "SimpleWire.h"
 
+#include <algorithm>
+
 namespace rd
 {
 namespace test
@@ -10,17 +12,44 @@ SimpleWire::SimpleWire(IScheduler* scheduler) : WireBase(scheduler)
 }
 
 void SimpleWire::send(RdId const& id, std::function<void(Buffer& buffer)> writer) const
+{
+	enqueue(id, writer, {});
+}
+
+void SimpleWire::send_latest(RdId const& id, std::string const& key, std::function<void(Buffer& buffer)> writer) const
+{
+	const RdId::hash_t hash = id.get_hash();
+	std::string coalescing_key(reinterpret_cast<char const*>(&hash), sizeof(hash));
+	coalescing_key += key;
+	enqueue(id, writer, std::move(coalescing_key));
+}
+
+void SimpleWire::enqueue(RdId const& id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const
 {
 	assert(!id.isNull());
+	if (record_to_snapshot(id, writer))
+	{
+		return;
+	}
+
 	Buffer buffer;
-	buffer.write_integral<int16_t>(0);	  // placeholder for context
+	write_context(buffer);
 	writer(buffer);
 
 	bytesWritten += buffer.get_position();
 
 	buffer.rewind();
 
-	msgQ.emplace(id, std::move(buffer));
+	if (!coalescing_key.empty())
+	{
+		auto it = std::find_if(
+			msgQ.begin(), msgQ.end(), [&](RdMessage const& message) { return message.coalescing_key == coalescing_key; });
+		if (it != msgQ.end())
+		{
+			msgQ.erase(it);
+		}
+	}
+	msgQ.emplace_back(id, std::move(buffer), std::move(coalescing_key));
 	if (auto_flush)
 	{
 		process_all_messages();
@@ -42,7 +71,7 @@ void SimpleWire::process_one_message() const
 		return;
 	}
 	auto msg = std::move(msgQ.front());
-	msgQ.pop();
+	msgQ.pop_front();
 	counterpart->message_broker.dispatch(msg.id, std::move(msg.buffer));
 }
 
@@ -5,7 +5,8 @@
 #include "protocol/RdId.h"
 #include "protocol/Buffer.h"
 
-#include <queue>
+#include <deque>
+#include <string>
 #include <utility>
 
 namespace rd
@@ -17,8 +18,11 @@ class RdMessage
 public:
 	RdId id;
 	Buffer buffer;
+	// the queued message with the same key is dropped when this one is sent, none if empty
+	std::string coalescing_key;
 
-	RdMessage(const RdId& id, Buffer buffer) : id(id), buffer(std::move(buffer)){};
+	RdMessage(const RdId& id, Buffer buffer, std::string coalescing_key = {})
+		: id(id), buffer(std::move(buffer)), coalescing_key(std::move(coalescing_key)){};
 };
 
 class SimpleWire : public WireBase
@@ -26,9 +30,11 @@ class SimpleWire : public WireBase
 protected:
 	bool auto_flush = true;
 
+	void enqueue(RdId const& id, std::function<void(Buffer& buffer)> const& writer, std::string coalescing_key) const;
+
 public:
 	mutable SimpleWire const* counterpart = nullptr;
-	mutable std::queue<RdMessage> msgQ;
+	mutable std::deque<RdMessage> msgQ;
 	mutable int64_t bytesWritten = 0;
 
 	// region ctor/dtor
@@ -40,6 +46,11 @@ public:
 
 	void send(RdId const& id, std::function<void(Buffer& buffer)> writer) const override;
 
+	/**
+	 * \brief Drops the superseded message if it's still queued, i.e. while auto flush is off.
+	 */
+	void send_latest(RdId const& id, std::string const& key, std::function<void(Buffer& buffer)> writer) const override;
+
 	void process_all_messages() const;
 
 	void process_one_message() const;
@@ -1 +1,270 @@
 #include "RdTextBuffer.h"
+
+#include <utility>
+
+namespace rd
+{
+RdTextBuffer::RdTextBuffer(bool is_master) : RdTextBuffer(RdTextBufferState(), is_master)
+{
+}
+
+RdTextBuffer::RdTextBuffer(RdTextBufferState state, bool is_master)
+	: state(std::move(state)), master(is_master), local_origin(is_master ? RdChangeOrigin::Master : RdChangeOrigin::Slave)
+{
+}
+
+RdTextBuffer RdTextBuffer::read(SerializationCtx& ctx, Buffer& buffer)
+{
+	return RdTextBuffer(RdTextBufferState::read(ctx, buffer), false);
+}
+
+void RdTextBuffer::write(SerializationCtx& ctx, Buffer& buffer) const
+{
+	state.write(ctx, buffer);
+}
+
+const IProtocol* RdTextBuffer::get_protocol() const
+{
+	return static_cast<IRdDynamic const&>(state).get_protocol();
+}
+
+SerializationCtx& RdTextBuffer::get_serialization_context() const
+{
+	return state.get_serialization_context();
+}
+
+const RName& RdTextBuffer::get_location() const
+{
+	return state.get_location();
+}
+
+void RdTextBuffer::set_id(RdId id) const
+{
+	state.set_id(id);
+}
+
+RdId RdTextBuffer::get_id() const
+{
+	return state.get_id();
+}
+
+void RdTextBuffer::bind(Lifetime lf, IRdDynamic const* parent, string_view name) const
+{
+	state.bind(lf, parent, name);
+
+	// the buffer resolves conflicts by itself, so the changes property never rejects anything
+	state.get_changes().advise(lf, [this](Wrapper<RdTextBufferChange> const& change) {
+		if (change && change->origin != local_origin)
+		{
+			receive_change(*change);
+		}
+	});
+	state.get_asserted_master_text().advise(lf, [this](RdAssertion const&) { check_assertions(); });
+	state.get_asserted_slave_text().advise(lf, [this](RdAssertion const&) { check_assertions(); });
+}
+
+void RdTextBuffer::identify(Identities const& identities, RdId const& id) const
+{
+	state.identify(identities, id);
+}
+
+void RdTextBuffer::receive_change(RdTextBufferChange const& buffer_change) const
+{
+	TextBufferVersion const& new_version = buffer_change.version;
+	RdTextChangeKind const kind = buffer_change.change.kind;
+
+	if (kind == RdTextChangeKind::Reset)
+	{
+		changes_to_confirm_or_rollback.clear();
+	}
+	else if (kind == RdTextChangeKind::PromoteVersion)
+	{
+		RD_ASSERT_MSG(!master, "master mustn't receive PromoteVersion");
+		buffer_version = new_version;
+		return;
+	}
+	else if (master)
+	{
+		if (new_version.master != buffer_version.master)
+		{
+			// reject the change, the slave will roll it back when it receives the master changes made meanwhile
+			return;
+		}
+	}
+	else
+	{
+		if (new_version.slave != buffer_version.slave)
+		{
+			for (auto it = changes_to_confirm_or_rollback.rbegin(); it != changes_to_confirm_or_rollback.rend(); ++it)
+			{
+				if (it->version.slave <= new_version.slave)
+				{
+					break;
+				}
+				const RdTextChange reversed = it->change.reverse();
+				apply(reversed);
+				text_changed.fire(reversed);
+			}
+		}
+		changes_to_confirm_or_rollback.clear();
+	}
+
+	// converted on top of the rolled back text, which the offsets of the change refer to
+	const RdTextChange change = from_wire(buffer_change.change);
+	buffer_version = new_version;
+	apply(change);
+	text_changed.fire(change);
+}
+
+void RdTextBuffer::apply(RdTextChange const& change) const
+{
+	change.assert_document_length(static_cast<int32_t>(text.size()));
+	const auto offset = static_cast<size_t>(change.start_offset);
+	switch (change.kind)
+	{
+		case RdTextChangeKind::Insert:
+		case RdTextChangeKind::InsertLeftSide:
+		case RdTextChangeKind::InsertRightSide:
+			text.insert(offset, change.new_text);
+			break;
+		case RdTextChangeKind::Remove:
+			text.erase(offset, change.old_text.size());
+			break;
+		case RdTextChangeKind::Replace:
+			text.replace(offset, change.old_text.size(), change.new_text);
+			break;
+		case RdTextChangeKind::Reset:
+			text.assign(change.new_text);
+			break;
+		case RdTextChangeKind::PromoteVersion:
+			break;
+	}
+}
+
+int32_t RdTextBuffer::pairs_after(RdTextChange const& change) const
+{
+	const size_t kept = change.kind == RdTextChangeKind::Reset ? 0 : text.utf16_size() - text.size();
+	const size_t added = TextRope::utf16_length(change.new_text) - change.new_text.size();
+	const size_t removed = TextRope::utf16_length(change.old_text) - change.old_text.size();
+	return static_cast<int32_t>(kept + added - removed);
+}
+
+RdTextChange RdTextBuffer::to_wire(RdTextChange const& change) const
+{
+	// the text before the change is the same before and after it
+	const auto start_offset = static_cast<int32_t>(text.to_utf16_offset(static_cast<size_t>(change.start_offset)));
+	const int32_t full_text_length = change.full_text_length == -1 ? -1 : change.full_text_length + pairs_after(change);
+	return RdTextChange(change.kind, start_offset, change.old_text, change.new_text, full_text_length);
+}
+
+RdTextChange RdTextBuffer::from_wire(RdTextChange const& change) const
+{
+	const auto start_offset = static_cast<int32_t>(text.from_utf16_offset(static_cast<size_t>(change.start_offset)));
+	const int32_t full_text_length = change.full_text_length == -1 ? -1 : change.full_text_length - pairs_after(change);
+	return RdTextChange(change.kind, start_offset, change.old_text, change.new_text, full_text_length);
+}
+
+void RdTextBuffer::check_assertions() const
+{
+	auto const& master_text = state.get_asserted_master_text();
+	auto const& slave_text = state.get_asserted_slave_text();
+	if (!master_text.has_value() || !slave_text.has_value())
+	{
+		return;
+	}
+	RdAssertion const& m = master_text.get();
+	RdAssertion const& s = slave_text.get();
+	RD_ASSERT_MSG(m.master_version != s.master_version || m.slave_version != s.slave_version || m.text == s.text,
+		"Master and Slave texts are different at version " + to_string(TextBufferVersion(m.master_version, m.slave_version)));
+}
+
+bool RdTextBuffer::is_master() const
+{
+	return master;
+}
+
+TextBufferVersion const& RdTextBuffer::get_buffer_version() const
+{
+	return buffer_version;
+}
+
+size_t RdTextBuffer::length() const
+{
+	return text.size();
+}
+
+std::wstring RdTextBuffer::get_text() const
+{
+	return text.to_wstring();
+}
+
+std::wstring RdTextBuffer::get_text(size_t offset, size_t count) const
+{
+	return text.substr(offset, count);
+}
+
+void RdTextBuffer::insert(int32_t offset, std::wstring const& value)
+{
+	const auto full_text_length = static_cast<int32_t>(text.size() + value.size());
+	fire(RdTextChange(RdTextChangeKind::Insert, offset, std::wstring(), value, full_text_length));
+}
+
+void RdTextBuffer::remove(int32_t offset, int32_t count)
+{
+	const auto full_text_length = static_cast<int32_t>(text.size()) - count;
+	fire(RdTextChange(RdTextChangeKind::Remove, offset, text.substr(offset, count), std::wstring(), full_text_length));
+}
+
+void RdTextBuffer::replace(int32_t offset, int32_t count, std::wstring const& value)
+{
+	const auto full_text_length = static_cast<int32_t>(text.size() + value.size()) - count;
+	fire(RdTextChange(RdTextChangeKind::Replace, offset, text.substr(offset, count), value, full_text_length));
+}
+
+void RdTextBuffer::reset(std::wstring const& value)
+{
+	fire(RdTextChange(RdTextChangeKind::Reset, 0, std::wstring(), value, static_cast<int32_t>(value.size())));
+}
+
+void RdTextBuffer::fire(RdTextChange change)
+{
+	RdTextChange wire_change = to_wire(change);
+	apply(change);
+
+	buffer_version = master ? buffer_version.increment_master() : buffer_version.increment_slave();
+	if (change.kind == RdTextChangeKind::Reset)
+	{
+		changes_to_confirm_or_rollback.clear();
+	}
+	else if (!master)
+	{
+		changes_to_confirm_or_rollback.emplace_back(buffer_version, local_origin, std::move(change));
+	}
+
+	state.get_changes().set(
+		Wrapper<RdTextBufferChange>(RdTextBufferChange(buffer_version, local_origin, std::move(wire_change))));
+}
+
+void RdTextBuffer::advise(Lifetime lifetime, std::function<void(RdTextChange const&)> handler) const
+{
+	text_changed.advise(lifetime, std::move(handler));
+}
+
+void RdTextBuffer::assert_state() const
+{
+	RdAssertion assertion(buffer_version.master, buffer_version.slave, text.to_wstring());
+	if (master)
+	{
+		state.get_asserted_master_text().set(std::move(assertion));
+	}
+	else
+	{
+		state.get_asserted_slave_text().set(std::move(assertion));
+	}
+}
+
+std::string to_string(RdTextBuffer const& value)
+{
+	return "RdTextBuffer(version=" + to_string(value.buffer_version) + ", length=" + std::to_string(value.text.size()) + ")";
+}
+}	 // namespace rd
@@ -1,10 +1,142 @@
 #ifndef RD_CPP_RDTEXTBUFFER_H
 #define RD_CPP_RDTEXTBUFFER_H
 
+#include "text/RdTextBufferState.h"
+#include "text/RdTextChange.h"
+#include "text/TextBufferVersion.h"
+#include "text/TextRope.h"
+
+#include "base/IRdBindable.h"
+#include "reactive/base/SignalX.h"
+#include "serialization/ISerializable.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
 namespace rd
 {
-class RdTextBuffer
+/**
+ * \brief Text document synchronized between two sides by deltas, wire compatible with RdTextBuffer of the other rd
+ * implementations.
+ *
+ * \details One side is the master, conflicts are resolved in its favour: the master ignores a slave change made
+ * on top of an outdated master version, and the slave rolls back its own unconfirmed changes when it receives a master
+ * change which doesn't take them into account. The document itself is stored in a \ref TextRope, so edits cost
+ * O(log n) of the document size.
+ *
+ * Subscribers of \ref advise are notified of the changes applied by the other side and of the rollbacks, local edits
+ * aren't reported back. Typing sessions of the .NET implementation aren't supported.
+ *
+ * The wire representation is \ref RdTextBufferState bound under the same id and name as the buffer itself. Offsets
+ * and lengths are counted in UTF-16 code units on the wire, like on the other side, and in characters of std::wstring
+ * here: the changes are converted when they are sent and received.
+ */
+class RdTextBuffer final : public virtual IRdBindable, public ISerializable
 {
+	RdTextBufferState state;
+	bool master;
+	RdChangeOrigin local_origin;
+
+	mutable TextBufferVersion buffer_version = TextBufferVersion::INIT_VERSION;
+	/// \brief Local changes of the slave which may still be rolled back, in order of their versions.
+	mutable std::vector<RdTextBufferChange> changes_to_confirm_or_rollback;
+	mutable TextRope text;
+	Signal<RdTextChange> text_changed;
+
+	void receive_change(RdTextBufferChange const& buffer_change) const;
+
+	void apply(RdTextChange const& change) const;
+
+	/**
+	 * \brief Characters of the document above the BMP once [change] is applied, each of them takes two UTF-16 units.
+	 */
+	int32_t pairs_after(RdTextChange const& change) const;
+
+	/**
+	 * \brief Converts local [change] to UTF-16 units before it's applied.
+	 */
+	RdTextChange to_wire(RdTextChange const& change) const;
+
+	/**
+	 * \brief Converts [change] received in UTF-16 units before it's applied.
+	 */
+	RdTextChange from_wire(RdTextChange const& change) const;
+
+	void check_assertions() const;
+
+public:
+	// region ctor/dtor
+
+	explicit RdTextBuffer(bool is_master = false);
+
+	RdTextBuffer(RdTextBufferState state, bool is_master);
+
+	RdTextBuffer(RdTextBuffer&&) = default;
+
+	RdTextBuffer& operator=(RdTextBuffer&&) = default;
+
+	virtual ~RdTextBuffer() = default;
+	// endregion
+
+	/// \brief Reads the slave side of a buffer.
+	static RdTextBuffer read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	// delegated
+
+	const IProtocol* get_protocol() const override;
+
+	SerializationCtx& get_serialization_context() const override;
+
+	const RName& get_location() const override;
+
+	void set_id(RdId id) const override;
+
+	RdId get_id() const override;
+
+	void bind(Lifetime lf, IRdDynamic const* parent, string_view name) const override;
+
+	void identify(Identities const& identities, RdId const& id) const override;
+
+	// text
+
+	bool is_master() const;
+
+	TextBufferVersion const& get_buffer_version() const;
+
+	size_t length() const;
+
+	std::wstring get_text() const;
+
+	std::wstring get_text(size_t offset, size_t count) const;
+
+	void insert(int32_t offset, std::wstring const& value);
+
+	void remove(int32_t offset, int32_t count);
+
+	void replace(int32_t offset, int32_t count, std::wstring const& value);
+
+	void reset(std::wstring const& value);
+
+	/**
+	 * \brief Applies local [change] to the document and sends it to the other side.
+	 */
+	void fire(RdTextChange change);
+
+	/**
+	 * \brief Subscribes to the changes applied to the document by the other side, including rollbacks.
+	 */
+	void advise(Lifetime lifetime, std::function<void(RdTextChange const&)> handler) const;
+
+	/**
+	 * \brief Sends the whole text at the current version, the sides fail an assertion if their texts differ at
+	 * the same version.
+	 */
+	void assert_state() const;
+
+	friend std::string to_string(RdTextBuffer const& value);
 };
 }	 // namespace rd
 
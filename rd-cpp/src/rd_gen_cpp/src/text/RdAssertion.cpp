@@ -0,0 +1,44 @@
+#include "RdAssertion.h"
+
+#include "protocol/Buffer.h"
+
+#include <utility>
+
+namespace rd
+{
+RdAssertion::RdAssertion(int32_t master_version, int32_t slave_version, std::wstring text)
+	: master_version(master_version), slave_version(slave_version), text(std::move(text))
+{
+}
+
+RdAssertion RdAssertion::read(SerializationCtx& /*ctx*/, Buffer& buffer)
+{
+	const auto master_version = buffer.read_integral<int32_t>();
+	const auto slave_version = buffer.read_integral<int32_t>();
+	auto text = buffer.read_wstring();
+	return RdAssertion(master_version, slave_version, std::move(text));
+}
+
+void RdAssertion::write(SerializationCtx& /*ctx*/, Buffer& buffer) const
+{
+	buffer.write_integral<int32_t>(master_version);
+	buffer.write_integral<int32_t>(slave_version);
+	buffer.write_wstring(text);
+}
+
+bool operator==(RdAssertion const& lhs, RdAssertion const& rhs)
+{
+	return lhs.master_version == rhs.master_version && lhs.slave_version == rhs.slave_version && lhs.text == rhs.text;
+}
+
+bool operator!=(RdAssertion const& lhs, RdAssertion const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+std::string to_string(RdAssertion const& value)
+{
+	return "RdAssertion(masterVersion=" + std::to_string(value.master_version) +
+		   ", slaveVersion=" + std::to_string(value.slave_version) + ", text=" + std::to_string(value.text.size()) + " chars)";
+}
+}	 // namespace rd
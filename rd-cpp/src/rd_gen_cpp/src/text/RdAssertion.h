@@ -0,0 +1,45 @@
+#ifndef RD_CPP_RDASSERTION_H
+#define RD_CPP_RDASSERTION_H
+
+#include "serialization/ISerializable.h"
+
+#include <cstdint>
+#include <string>
+
+namespace rd
+{
+// region predeclared
+
+class Buffer;
+
+class SerializationCtx;
+// endregion
+
+/**
+ * \brief Whole text of one side of \ref RdTextBuffer at the given version, sent to check that both sides agree.
+ */
+class RdAssertion final : public ISerializable
+{
+public:
+	int32_t master_version;
+	int32_t slave_version;
+	std::wstring text;
+
+	// region ctor/dtor
+
+	RdAssertion(int32_t master_version, int32_t slave_version, std::wstring text);
+	// endregion
+
+	static RdAssertion read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	friend bool operator==(RdAssertion const& lhs, RdAssertion const& rhs);
+
+	friend bool operator!=(RdAssertion const& lhs, RdAssertion const& rhs);
+
+	friend std::string to_string(RdAssertion const& value);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_RDASSERTION_H
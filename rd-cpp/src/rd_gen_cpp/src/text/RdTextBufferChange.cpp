@@ -0,0 +1,51 @@
+#include "RdTextBufferChange.h"
+
+#include "protocol/Buffer.h"
+
+#include <utility>
+
+namespace rd
+{
+RdTextBufferChange::RdTextBufferChange(TextBufferVersion version, RdChangeOrigin origin, RdTextChange change)
+	: version(version), origin(origin), change(std::move(change))
+{
+}
+
+RdTextBufferChange RdTextBufferChange::read(SerializationCtx& ctx, Buffer& buffer)
+{
+	auto version = TextBufferVersion::read(ctx, buffer);
+	const auto origin = static_cast<RdChangeOrigin>(buffer.read_integral<int32_t>());
+	auto change = RdTextChange::read(ctx, buffer);
+	return RdTextBufferChange(version, origin, std::move(change));
+}
+
+void RdTextBufferChange::write(SerializationCtx& ctx, Buffer& buffer) const
+{
+	version.write(ctx, buffer);
+	buffer.write_integral<int32_t>(static_cast<int32_t>(origin));
+	change.write(ctx, buffer);
+}
+
+size_t RdTextBufferChange::serialized_size_hint() const
+{
+	// two version numbers and the origin
+	return 3 * sizeof(int32_t) + change.serialized_size_hint();
+}
+
+bool operator==(RdTextBufferChange const& lhs, RdTextBufferChange const& rhs)
+{
+	return lhs.version == rhs.version && lhs.origin == rhs.origin && lhs.change == rhs.change;
+}
+
+bool operator!=(RdTextBufferChange const& lhs, RdTextBufferChange const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+std::string to_string(RdTextBufferChange const& value)
+{
+	return "RdTextBufferChange(version=" + to_string(value.version) +
+		   ", origin=" + (value.origin == RdChangeOrigin::Master ? "Master" : "Slave") + ", change=" + to_string(value.change) +
+		   ")";
+}
+}	 // namespace rd
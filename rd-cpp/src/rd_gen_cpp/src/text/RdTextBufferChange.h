@@ -0,0 +1,50 @@
+#ifndef RD_CPP_RDTEXTBUFFERCHANGE_H
+#define RD_CPP_RDTEXTBUFFERCHANGE_H
+
+#include "RdTextChange.h"
+#include "TextBufferVersion.h"
+
+#include <cstdint>
+#include <string>
+
+namespace rd
+{
+/**
+ * \brief Serialized as int32, the order must match the other rd implementations.
+ */
+enum class RdChangeOrigin : int32_t
+{
+	Slave,
+	Master
+};
+
+/**
+ * \brief \ref RdTextChange stamped with the version of the buffer after it and the side which made it.
+ */
+class RdTextBufferChange final : public ISerializable
+{
+public:
+	TextBufferVersion version;
+	RdChangeOrigin origin;
+	RdTextChange change;
+
+	// region ctor/dtor
+
+	RdTextBufferChange(TextBufferVersion version, RdChangeOrigin origin, RdTextChange change);
+	// endregion
+
+	static RdTextBufferChange read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	size_t serialized_size_hint() const override;
+
+	friend bool operator==(RdTextBufferChange const& lhs, RdTextBufferChange const& rhs);
+
+	friend bool operator!=(RdTextBufferChange const& lhs, RdTextBufferChange const& rhs);
+
+	friend std::string to_string(RdTextBufferChange const& value);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_RDTEXTBUFFERCHANGE_H
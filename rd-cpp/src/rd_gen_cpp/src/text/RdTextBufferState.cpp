@@ -0,0 +1,119 @@
+#include "RdTextBufferState.h"
+
+#include <utility>
+
+namespace rd
+{
+Wrapper<RdTextBufferChange> RdTextBufferState::__RdTextBufferChangeNullableSerializer::read(
+	SerializationCtx& ctx, Buffer& buffer)
+{
+	if (!buffer.read_bool())
+	{
+		return Wrapper<RdTextBufferChange>(nullptr);
+	}
+	return Wrapper<RdTextBufferChange>(RdTextBufferChange::read(ctx, buffer));
+}
+
+void RdTextBufferState::__RdTextBufferChangeNullableSerializer::write(
+	SerializationCtx& ctx, Buffer& buffer, Wrapper<RdTextBufferChange> const& value)
+{
+	buffer.write_bool(static_cast<bool>(value));
+	if (value)
+	{
+		value->write(ctx, buffer);
+	}
+}
+
+void RdTextBufferState::initialize()
+{
+	changes_.optimize_nested = true;
+	version_before_typing_session_.optimize_nested = true;
+	asserted_master_text_.optimize_nested = true;
+	asserted_slave_text_.optimize_nested = true;
+}
+
+RdTextBufferState::RdTextBufferState(changes_t changes_, RdProperty<TextBufferVersion> version_before_typing_session_,
+	RdProperty<RdAssertion> asserted_master_text_, RdProperty<RdAssertion> asserted_slave_text_)
+	: changes_(std::move(changes_))
+	, version_before_typing_session_(std::move(version_before_typing_session_))
+	, asserted_master_text_(std::move(asserted_master_text_))
+	, asserted_slave_text_(std::move(asserted_slave_text_))
+{
+	initialize();
+}
+
+RdTextBufferState::RdTextBufferState()
+	: RdTextBufferState(changes_t{}, RdProperty<TextBufferVersion>{}, RdProperty<RdAssertion>{}, RdProperty<RdAssertion>{})
+{
+}
+
+RdTextBufferState RdTextBufferState::read(SerializationCtx& ctx, Buffer& buffer)
+{
+	auto _id = RdId::read(buffer);
+	auto changes_ = changes_t::read(ctx, buffer);
+	auto version_before_typing_session_ = RdProperty<TextBufferVersion>::read(ctx, buffer);
+	auto asserted_master_text_ = RdProperty<RdAssertion>::read(ctx, buffer);
+	auto asserted_slave_text_ = RdProperty<RdAssertion>::read(ctx, buffer);
+	RdTextBufferState res{std::move(changes_), std::move(version_before_typing_session_), std::move(asserted_master_text_),
+		std::move(asserted_slave_text_)};
+	withId(res, _id);
+	return res;
+}
+
+void RdTextBufferState::write(SerializationCtx& ctx, Buffer& buffer) const
+{
+	this->rdid.write(buffer);
+	changes_.write(ctx, buffer);
+	version_before_typing_session_.write(ctx, buffer);
+	asserted_master_text_.write(ctx, buffer);
+	asserted_slave_text_.write(ctx, buffer);
+}
+
+void RdTextBufferState::init(Lifetime lifetime) const
+{
+	RdBindableBase::init(lifetime);
+	bindPolymorphic(changes_, lifetime, this, "changes");
+	bindPolymorphic(version_before_typing_session_, lifetime, this, "versionBeforeTypingSession");
+	bindPolymorphic(asserted_master_text_, lifetime, this, "assertedMasterText");
+	bindPolymorphic(asserted_slave_text_, lifetime, this, "assertedSlaveText");
+}
+
+void RdTextBufferState::identify(Identities const& identities, RdId const& id) const
+{
+	RdBindableBase::identify(identities, id);
+	identifyPolymorphic(changes_, identities, id.mix(".changes"));
+	identifyPolymorphic(version_before_typing_session_, identities, id.mix(".versionBeforeTypingSession"));
+	identifyPolymorphic(asserted_master_text_, identities, id.mix(".assertedMasterText"));
+	identifyPolymorphic(asserted_slave_text_, identities, id.mix(".assertedSlaveText"));
+}
+
+RdTextBufferState::changes_t const& RdTextBufferState::get_changes() const
+{
+	return changes_;
+}
+
+IProperty<TextBufferVersion> const& RdTextBufferState::get_version_before_typing_session() const
+{
+	return version_before_typing_session_;
+}
+
+IProperty<RdAssertion> const& RdTextBufferState::get_asserted_master_text() const
+{
+	return asserted_master_text_;
+}
+
+IProperty<RdAssertion> const& RdTextBufferState::get_asserted_slave_text() const
+{
+	return asserted_slave_text_;
+}
+
+std::string to_string(RdTextBufferState const& value)
+{
+	std::string res = "RdTextBufferState\n";
+	res += "\tchanges = " + to_string(value.changes_) + '\n';
+	res += "\tversionBeforeTypingSession = " + to_string(value.version_before_typing_session_) + '\n';
+	res += "\tassertedMasterText = " + to_string(value.asserted_master_text_) + '\n';
+	res += "\tassertedSlaveText = " + to_string(value.asserted_slave_text_) + '\n';
+	return res;
+}
+}	 // namespace rd
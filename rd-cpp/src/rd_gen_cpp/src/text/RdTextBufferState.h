@@ -0,0 +1,79 @@
+#ifndef RD_CPP_RDTEXTBUFFERSTATE_H
+#define RD_CPP_RDTEXTBUFFERSTATE_H
+
+#include "RdAssertion.h"
+#include "RdTextBufferChange.h"
+#include "TextBufferVersion.h"
+
+#include "base/RdBindableBase.h"
+#include "impl/RdProperty.h"
+
+#include <string>
+
+namespace rd
+{
+/**
+ * \brief Wire part of \ref RdTextBuffer, laid out the same way as RdTextBufferState of the other rd implementations.
+ */
+class RdTextBufferState final : public RdBindableBase, public ISerializable
+{
+public:
+	// custom serializers
+	/// \brief Nullable RdTextBufferChange stored in a Wrapper, so that the buffer can share the last change with the property.
+	class __RdTextBufferChangeNullableSerializer
+	{
+	public:
+		static Wrapper<RdTextBufferChange> read(SerializationCtx& ctx, Buffer& buffer);
+
+		static void write(SerializationCtx& ctx, Buffer& buffer, Wrapper<RdTextBufferChange> const& value);
+	};
+
+	using changes_t = RdProperty<Wrapper<RdTextBufferChange>, __RdTextBufferChangeNullableSerializer>;
+
+private:
+	// fields
+	changes_t changes_;
+	RdProperty<TextBufferVersion> version_before_typing_session_;
+	RdProperty<RdAssertion> asserted_master_text_;
+	RdProperty<RdAssertion> asserted_slave_text_;
+
+	// initializer
+	void initialize();
+
+public:
+	// region ctor/dtor
+
+	RdTextBufferState(changes_t changes_, RdProperty<TextBufferVersion> version_before_typing_session_,
+		RdProperty<RdAssertion> asserted_master_text_, RdProperty<RdAssertion> asserted_slave_text_);
+
+	RdTextBufferState();
+
+	RdTextBufferState(RdTextBufferState&&) = default;
+
+	RdTextBufferState& operator=(RdTextBufferState&&) = default;
+
+	virtual ~RdTextBufferState() = default;
+	// endregion
+
+	static RdTextBufferState read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	void init(Lifetime lifetime) const override;
+
+	void identify(Identities const& identities, RdId const& id) const override;
+
+	// getters
+	changes_t const& get_changes() const;
+
+	IProperty<TextBufferVersion> const& get_version_before_typing_session() const;
+
+	IProperty<RdAssertion> const& get_asserted_master_text() const;
+
+	IProperty<RdAssertion> const& get_asserted_slave_text() const;
+
+	friend std::string to_string(RdTextBufferState const& value);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_RDTEXTBUFFERSTATE_H
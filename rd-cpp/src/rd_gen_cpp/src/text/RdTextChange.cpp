@@ -0,0 +1,125 @@
+#include "RdTextChange.h"
+
+#include "protocol/Buffer.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace rd
+{
+std::string to_string(RdTextChangeKind kind)
+{
+	switch (kind)
+	{
+		case RdTextChangeKind::Insert:
+			return "Insert";
+		case RdTextChangeKind::Remove:
+			return "Remove";
+		case RdTextChangeKind::Replace:
+			return "Replace";
+		case RdTextChangeKind::Reset:
+			return "Reset";
+		case RdTextChangeKind::PromoteVersion:
+			return "PromoteVersion";
+		case RdTextChangeKind::InsertLeftSide:
+			return "InsertLeftSide";
+		case RdTextChangeKind::InsertRightSide:
+			return "InsertRightSide";
+	}
+	return std::to_string(static_cast<int32_t>(kind));
+}
+
+RdTextChange::RdTextChange(
+	RdTextChangeKind kind, int32_t start_offset, std::wstring old_text, std::wstring new_text, int32_t full_text_length)
+	: kind(kind)
+	, start_offset(start_offset)
+	, old_text(std::move(old_text))
+	, new_text(std::move(new_text))
+	, full_text_length(full_text_length)
+{
+}
+
+RdTextChange RdTextChange::read(SerializationCtx& /*ctx*/, Buffer& buffer)
+{
+	const auto kind = static_cast<RdTextChangeKind>(buffer.read_integral<int32_t>());
+	const auto start_offset = buffer.read_integral<int32_t>();
+	auto old_text = buffer.read_wstring();
+	auto new_text = buffer.read_wstring();
+	const auto full_text_length = buffer.read_integral<int32_t>();
+	return RdTextChange(kind, start_offset, std::move(old_text), std::move(new_text), full_text_length);
+}
+
+void RdTextChange::write(SerializationCtx& /*ctx*/, Buffer& buffer) const
+{
+	buffer.write_integral<int32_t>(static_cast<int32_t>(kind));
+	buffer.write_integral<int32_t>(start_offset);
+	buffer.write_wstring(old_text);
+	buffer.write_wstring(new_text);
+	buffer.write_integral<int32_t>(full_text_length);
+}
+
+size_t RdTextChange::serialized_size_hint() const
+{
+	// kind, offset, two string lengths and the document length, the texts take two bytes per character in UTF-16
+	return 5 * sizeof(int32_t) + 2 * (old_text.size() + new_text.size());
+}
+
+int32_t RdTextChange::get_delta() const
+{
+	return static_cast<int32_t>(new_text.size()) - static_cast<int32_t>(old_text.size());
+}
+
+RdTextChange RdTextChange::reverse() const
+{
+	RdTextChangeKind reversed_kind;
+	switch (kind)
+	{
+		case RdTextChangeKind::Insert:
+		case RdTextChangeKind::InsertLeftSide:
+		case RdTextChangeKind::InsertRightSide:
+			reversed_kind = RdTextChangeKind::Remove;
+			break;
+		case RdTextChangeKind::Remove:
+			reversed_kind = RdTextChangeKind::Insert;
+			break;
+		case RdTextChangeKind::Replace:
+			reversed_kind = RdTextChangeKind::Replace;
+			break;
+		default:
+			throw std::invalid_argument(to_string(kind) + " change isn't invertible");
+	}
+	const int32_t reversed_length = full_text_length == -1 ? -1 : full_text_length - get_delta();
+	return RdTextChange(reversed_kind, start_offset, new_text, old_text, reversed_length);
+}
+
+void RdTextChange::assert_document_length(int32_t current_length) const
+{
+	if (kind != RdTextChangeKind::Reset && full_text_length != -1)
+	{
+		const int32_t actual = current_length + get_delta();
+		if (actual != full_text_length)
+		{
+			throw std::invalid_argument("Expected the document size: " + std::to_string(full_text_length) +
+										", but actual: " + std::to_string(actual));
+		}
+	}
+}
+
+bool operator==(RdTextChange const& lhs, RdTextChange const& rhs)
+{
+	return lhs.kind == rhs.kind && lhs.start_offset == rhs.start_offset && lhs.old_text == rhs.old_text &&
+		   lhs.new_text == rhs.new_text && lhs.full_text_length == rhs.full_text_length;
+}
+
+bool operator!=(RdTextChange const& lhs, RdTextChange const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+std::string to_string(RdTextChange const& value)
+{
+	return "RdTextChange(kind=" + to_string(value.kind) + ", start=" + std::to_string(value.start_offset) +
+		   ", old=" + std::to_string(value.old_text.size()) + " chars, new=" + std::to_string(value.new_text.size()) +
+		   " chars, fullTextLength=" + std::to_string(value.full_text_length) + ")";
+}
+}	 // namespace rd
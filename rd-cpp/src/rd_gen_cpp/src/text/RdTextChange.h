@@ -0,0 +1,82 @@
+#ifndef RD_CPP_RDTEXTCHANGE_H
+#define RD_CPP_RDTEXTCHANGE_H
+
+#include "serialization/ISerializable.h"
+
+#include <cstdint>
+#include <string>
+
+namespace rd
+{
+// region predeclared
+
+class Buffer;
+
+class SerializationCtx;
+// endregion
+
+/**
+ * \brief Serialized as int32, the order must match the other rd implementations.
+ */
+enum class RdTextChangeKind : int32_t
+{
+	Insert,
+	Remove,
+	Replace,
+	Reset,
+	PromoteVersion,
+	InsertLeftSide,
+	InsertRightSide
+};
+
+std::string to_string(RdTextChangeKind kind);
+
+/**
+ * \brief Single edit of a text document.
+ *
+ * \details Offsets and lengths are counted in characters of std::wstring. The changes sent and received by
+ * \ref RdTextBuffer count them in UTF-16 code units instead, like the other side does.
+ */
+class RdTextChange final : public ISerializable
+{
+public:
+	RdTextChangeKind kind;
+	int32_t start_offset;
+	std::wstring old_text;
+	std::wstring new_text;
+	/// \brief Length of the whole document after the change or -1 if unknown.
+	int32_t full_text_length;
+
+	// region ctor/dtor
+
+	RdTextChange(RdTextChangeKind kind, int32_t start_offset, std::wstring old_text, std::wstring new_text,
+		int32_t full_text_length);
+	// endregion
+
+	static RdTextChange read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	size_t serialized_size_hint() const override;
+
+	int32_t get_delta() const;
+
+	/**
+	 * \brief The change which undoes this one. Reset and PromoteVersion can't be reversed.
+	 */
+	RdTextChange reverse() const;
+
+	/**
+	 * \brief Checks [full_text_length] against the length of the document [current_length] before the change.
+	 */
+	void assert_document_length(int32_t current_length) const;
+
+	friend bool operator==(RdTextChange const& lhs, RdTextChange const& rhs);
+
+	friend bool operator!=(RdTextChange const& lhs, RdTextChange const& rhs);
+
+	friend std::string to_string(RdTextChange const& value);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_RDTEXTCHANGE_H
@@ -0,0 +1,50 @@
+#include "TextBufferVersion.h"
+
+#include "protocol/Buffer.h"
+
+namespace rd
+{
+const TextBufferVersion TextBufferVersion::INIT_VERSION{-1, -1};
+
+TextBufferVersion::TextBufferVersion(int32_t master, int32_t slave) : master(master), slave(slave)
+{
+}
+
+TextBufferVersion TextBufferVersion::read(SerializationCtx& /*ctx*/, Buffer& buffer)
+{
+	const auto master = buffer.read_integral<int32_t>();
+	const auto slave = buffer.read_integral<int32_t>();
+	return TextBufferVersion(master, slave);
+}
+
+void TextBufferVersion::write(SerializationCtx& /*ctx*/, Buffer& buffer) const
+{
+	buffer.write_integral<int32_t>(master);
+	buffer.write_integral<int32_t>(slave);
+}
+
+TextBufferVersion TextBufferVersion::increment_master() const
+{
+	return TextBufferVersion(master + 1, slave);
+}
+
+TextBufferVersion TextBufferVersion::increment_slave() const
+{
+	return TextBufferVersion(master, slave + 1);
+}
+
+bool operator==(TextBufferVersion const& lhs, TextBufferVersion const& rhs)
+{
+	return lhs.master == rhs.master && lhs.slave == rhs.slave;
+}
+
+bool operator!=(TextBufferVersion const& lhs, TextBufferVersion const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+std::string to_string(TextBufferVersion const& value)
+{
+	return "(master=" + std::to_string(value.master) + ", slave=" + std::to_string(value.slave) + ")";
+}
+}	 // namespace rd
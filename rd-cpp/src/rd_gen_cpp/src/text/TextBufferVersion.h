@@ -0,0 +1,50 @@
+#ifndef RD_CPP_TEXTBUFFERVERSION_H
+#define RD_CPP_TEXTBUFFERVERSION_H
+
+#include "serialization/ISerializable.h"
+
+#include <cstdint>
+#include <string>
+
+namespace rd
+{
+// region predeclared
+
+class Buffer;
+
+class SerializationCtx;
+// endregion
+
+/**
+ * \brief Pair of counters of the changes made by each side of \ref RdTextBuffer.
+ */
+class TextBufferVersion final : public ISerializable
+{
+public:
+	static const TextBufferVersion INIT_VERSION;
+
+	int32_t master;
+	int32_t slave;
+
+	// region ctor/dtor
+
+	TextBufferVersion(int32_t master, int32_t slave);
+	// endregion
+
+	static TextBufferVersion read(SerializationCtx& ctx, Buffer& buffer);
+
+	void write(SerializationCtx& ctx, Buffer& buffer) const override;
+
+	TextBufferVersion increment_master() const;
+
+	TextBufferVersion increment_slave() const;
+
+	friend bool operator==(TextBufferVersion const& lhs, TextBufferVersion const& rhs);
+
+	friend bool operator!=(TextBufferVersion const& lhs, TextBufferVersion const& rhs);
+
+	friend std::string to_string(TextBufferVersion const& value);
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_TEXTBUFFERVERSION_H
@@ -0,0 +1,425 @@
+#include "TextRope.h"
+
+#include <util/core_util.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace rd
+{
+constexpr size_t TextRope::MAX_CHUNK;
+
+namespace
+{
+bool is_pair(wchar_t c)
+{
+	// values above U+10FFFF are written as U+FFFD, a single code unit
+	const auto code_point = static_cast<uint32_t>(c);
+	return code_point > 0xFFFFu && code_point <= 0x10FFFFu;
+}
+
+size_t count_pairs(wchar_t const* begin, wchar_t const* end)
+{
+	return static_cast<size_t>(std::count_if(begin, end, is_pair));
+}
+}	 // namespace
+
+struct TextRope::Node
+{
+	std::wstring chunk;
+	size_t chunk_pairs;
+	size_t length;
+	// characters above the BMP in the subtree
+	size_t pairs;
+	uint32_t priority;
+	node_ptr left;
+	node_ptr right;
+
+	Node(std::wstring chunk, uint32_t priority)
+		: chunk(std::move(chunk))
+		, chunk_pairs(count_pairs(this->chunk.data(), this->chunk.data() + this->chunk.size()))
+		, length(this->chunk.size())
+		, pairs(chunk_pairs)
+		, priority(priority)
+	{
+	}
+};
+
+// region ctor/dtor
+
+TextRope::TextRope() = default;
+
+TextRope::TextRope(wstring_view text)
+{
+	assign(text);
+}
+
+TextRope::TextRope(TextRope&&) noexcept = default;
+
+TextRope& TextRope::operator=(TextRope&&) noexcept = default;
+
+TextRope::~TextRope() = default;
+// endregion
+
+uint32_t TextRope::next_priority()
+{
+	// xorshift, priorities only have to be independent of the edits
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+TextRope::node_ptr TextRope::make_node(std::wstring chunk)
+{
+	return std::make_unique<Node>(std::move(chunk), next_priority());
+}
+
+TextRope::node_ptr TextRope::build(wstring_view text)
+{
+	// chunks are half full, so that following edits nearby fit in place
+	constexpr size_t BUILD_CHUNK = MAX_CHUNK / 2;
+	node_ptr result;
+	for (size_t position = 0; position < text.size(); position += BUILD_CHUNK)
+	{
+		const size_t count = (std::min)(BUILD_CHUNK, text.size() - position);
+		result = merge(std::move(result), make_node(std::wstring(text.data() + position, count)));
+	}
+	return result;
+}
+
+size_t TextRope::length_of(node_ptr const& node)
+{
+	return node ? node->length : 0;
+}
+
+size_t TextRope::pairs_of(node_ptr const& node)
+{
+	return node ? node->pairs : 0;
+}
+
+void TextRope::update(Node& node)
+{
+	node.length = length_of(node.left) + node.chunk.size() + length_of(node.right);
+	node.pairs = pairs_of(node.left) + node.chunk_pairs + pairs_of(node.right);
+}
+
+void TextRope::split(node_ptr node, size_t offset, node_ptr& left, node_ptr& right)
+{
+	if (!node)
+	{
+		left = nullptr;
+		right = nullptr;
+		return;
+	}
+	const size_t left_length = length_of(node->left);
+	const size_t chunk_end = left_length + node->chunk.size();
+	if (offset <= left_length)
+	{
+		split(std::move(node->left), offset, left, node->left);
+		update(*node);
+		right = std::move(node);
+	}
+	else if (offset >= chunk_end)
+	{
+		split(std::move(node->right), offset - chunk_end, node->right, right);
+		update(*node);
+		left = std::move(node);
+	}
+	else
+	{
+		const size_t cut = offset - left_length;
+		node_ptr tail = make_node(node->chunk.substr(cut));
+		node->chunk.erase(cut);
+		node->chunk_pairs -= tail->chunk_pairs;
+		node_ptr rest = std::move(node->right);
+		update(*node);
+		left = std::move(node);
+		right = merge(std::move(tail), std::move(rest));
+	}
+}
+
+TextRope::node_ptr TextRope::merge(node_ptr left, node_ptr right)
+{
+	if (!left)
+	{
+		return right;
+	}
+	if (!right)
+	{
+		return left;
+	}
+	if (left->priority > right->priority)
+	{
+		left->right = merge(std::move(left->right), std::move(right));
+		update(*left);
+		return left;
+	}
+	right->left = merge(std::move(left), std::move(right->left));
+	update(*right);
+	return right;
+}
+
+bool TextRope::insert_in_place(Node& node, size_t offset, wstring_view text)
+{
+	const size_t left_length = length_of(node.left);
+	const size_t chunk_end = left_length + node.chunk.size();
+	bool inserted = false;
+	if (offset < left_length)
+	{
+		inserted = insert_in_place(*node.left, offset, text);
+	}
+	else if (offset <= chunk_end)
+	{
+		inserted = node.chunk.size() + text.size() <= MAX_CHUNK;
+		if (inserted)
+		{
+			node.chunk.insert(offset - left_length, text.data(), text.size());
+			node.chunk_pairs += count_pairs(text.data(), text.data() + text.size());
+		}
+	}
+	else
+	{
+		inserted = insert_in_place(*node.right, offset - chunk_end, text);
+	}
+	if (inserted)
+	{
+		update(node);
+	}
+	return inserted;
+}
+
+bool TextRope::erase_in_place(Node& node, size_t offset, size_t count)
+{
+	const size_t left_length = length_of(node.left);
+	const size_t chunk_end = left_length + node.chunk.size();
+	bool erased = false;
+	if (offset < left_length)
+	{
+		erased = offset + count <= left_length && erase_in_place(*node.left, offset, count);
+	}
+	else if (offset < chunk_end)
+	{
+		// an emptied chunk has to leave the tree, that's done by splitting
+		erased = offset + count <= chunk_end && count < node.chunk.size();
+		if (erased)
+		{
+			auto const begin = node.chunk.data() + (offset - left_length);
+			node.chunk_pairs -= count_pairs(begin, begin + count);
+			node.chunk.erase(offset - left_length, count);
+		}
+	}
+	else
+	{
+		erased = node.right && erase_in_place(*node.right, offset - chunk_end, count);
+	}
+	if (erased)
+	{
+		update(node);
+	}
+	return erased;
+}
+
+void TextRope::append_to(Node const& node, size_t offset, size_t count, std::wstring& out)
+{
+	const size_t left_length = length_of(node.left);
+	const size_t chunk_end = left_length + node.chunk.size();
+	const size_t end = offset + count;
+	if (node.left && offset < left_length)
+	{
+		append_to(*node.left, offset, (std::min)(end, left_length) - offset, out);
+	}
+	if (offset < chunk_end && end > left_length)
+	{
+		const size_t from = (std::max)(offset, left_length) - left_length;
+		const size_t to = (std::min)(end, chunk_end) - left_length;
+		out.append(node.chunk, from, to - from);
+	}
+	if (node.right && end > chunk_end)
+	{
+		const size_t from = (std::max)(offset, chunk_end) - chunk_end;
+		append_to(*node.right, from, end - chunk_end - from, out);
+	}
+}
+
+size_t TextRope::size() const
+{
+	return length_of(root);
+}
+
+bool TextRope::empty() const
+{
+	return !root;
+}
+
+wchar_t TextRope::at(size_t offset) const
+{
+	RD_ASSERT_THROW_MSG(offset < size(), "offset " + std::to_string(offset) + " is out of text of " + std::to_string(size()));
+	Node const* node = root.get();
+	while (true)
+	{
+		const size_t left_length = length_of(node->left);
+		if (offset < left_length)
+		{
+			node = node->left.get();
+		}
+		else if (offset < left_length + node->chunk.size())
+		{
+			return node->chunk[offset - left_length];
+		}
+		else
+		{
+			offset -= left_length + node->chunk.size();
+			node = node->right.get();
+		}
+	}
+}
+
+void TextRope::assign(wstring_view text)
+{
+	root = build(text);
+}
+
+void TextRope::clear()
+{
+	root = nullptr;
+}
+
+void TextRope::insert(size_t offset, wstring_view text)
+{
+	RD_ASSERT_THROW_MSG(offset <= size(), "offset " + std::to_string(offset) + " is out of text of " + std::to_string(size()));
+	if (text.empty())
+	{
+		return;
+	}
+	if (root && insert_in_place(*root, offset, text))
+	{
+		return;
+	}
+	node_ptr left;
+	node_ptr right;
+	split(std::move(root), offset, left, right);
+	root = merge(merge(std::move(left), build(text)), std::move(right));
+}
+
+void TextRope::erase(size_t offset, size_t count)
+{
+	RD_ASSERT_THROW_MSG(offset <= size() && count <= size() - offset,
+		"range [" + std::to_string(offset) + ", " + std::to_string(offset + count) + ") is out of text of " +
+			std::to_string(size()));
+	if (count == 0 || erase_in_place(*root, offset, count))
+	{
+		return;
+	}
+	node_ptr left;
+	node_ptr middle;
+	node_ptr right;
+	split(std::move(root), offset + count, middle, right);
+	split(std::move(middle), offset, left, middle);
+	root = merge(std::move(left), std::move(right));
+}
+
+void TextRope::replace(size_t offset, size_t count, wstring_view text)
+{
+	erase(offset, count);
+	insert(offset, text);
+}
+
+std::wstring TextRope::substr(size_t offset, size_t count) const
+{
+	RD_ASSERT_THROW_MSG(offset <= size() && count <= size() - offset,
+		"range [" + std::to_string(offset) + ", " + std::to_string(offset + count) + ") is out of text of " +
+			std::to_string(size()));
+	std::wstring result;
+	result.reserve(count);
+	if (count > 0)
+	{
+		append_to(*root, offset, count, result);
+	}
+	return result;
+}
+
+std::wstring TextRope::to_wstring() const
+{
+	return substr(0, size());
+}
+
+size_t TextRope::utf16_length(wstring_view text)
+{
+	return text.size() + count_pairs(text.data(), text.data() + text.size());
+}
+
+size_t TextRope::utf16_size() const
+{
+	return length_of(root) + pairs_of(root);
+}
+
+size_t TextRope::to_utf16_offset(size_t offset) const
+{
+	RD_ASSERT_THROW_MSG(offset <= size(), "offset " + std::to_string(offset) + " is out of text of " + std::to_string(size()));
+	size_t result = offset;
+	Node const* node = root.get();
+	while (node != nullptr)
+	{
+		const size_t left_length = length_of(node->left);
+		if (offset < left_length)
+		{
+			node = node->left.get();
+		}
+		else if (offset <= left_length + node->chunk.size())
+		{
+			auto const begin = node->chunk.data();
+			return result + pairs_of(node->left) + count_pairs(begin, begin + (offset - left_length));
+		}
+		else
+		{
+			offset -= left_length + node->chunk.size();
+			result += pairs_of(node->left) + node->chunk_pairs;
+			node = node->right.get();
+		}
+	}
+	return result;
+}
+
+size_t TextRope::from_utf16_offset(size_t utf16_offset) const
+{
+	RD_ASSERT_THROW_MSG(utf16_offset <= utf16_size(),
+		"UTF-16 offset " + std::to_string(utf16_offset) + " is out of text of " + std::to_string(utf16_size()));
+	size_t remaining = utf16_offset;
+	size_t result = 0;
+	Node const* node = root.get();
+	while (node != nullptr)
+	{
+		const size_t left_units = length_of(node->left) + pairs_of(node->left);
+		const size_t chunk_units = node->chunk.size() + node->chunk_pairs;
+		if (remaining < left_units)
+		{
+			node = node->left.get();
+		}
+		else if (remaining <= left_units + chunk_units)
+		{
+			result += length_of(node->left);
+			size_t units = left_units;
+			for (wchar_t c : node->chunk)
+			{
+				if (units >= remaining)
+				{
+					break;
+				}
+				units += is_pair(c) ? 2 : 1;
+				++result;
+			}
+			RD_ASSERT_THROW_MSG(units == remaining,
+				"UTF-16 offset " + std::to_string(utf16_offset) + " splits a surrogate pair");
+			return result;
+		}
+		else
+		{
+			remaining -= left_units + chunk_units;
+			result += length_of(node->left) + node->chunk.size();
+			node = node->right.get();
+		}
+	}
+	return result;
+}
+}	 // namespace rd
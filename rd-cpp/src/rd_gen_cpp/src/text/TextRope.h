@@ -0,0 +1,119 @@
+#ifndef RD_CPP_TEXTROPE_H
+#define RD_CPP_TEXTROPE_H
+
+#include "thirdparty.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace rd
+{
+/**
+ * \brief Text storage for \ref RdTextBuffer with O(log n) edits.
+ *
+ * \details The text is kept in chunks of at most [MAX_CHUNK] characters, which are the nodes of an implicit treap ordered
+ * by position, every node knows the length of its subtree. An edit which fits into a single chunk is made in place and
+ * only updates the lengths on the path to it, so typing costs O(log n + MAX_CHUNK). Other edits split the tree at their
+ * bounds and merge the parts back, so a paste of k characters costs O(log n + k) regardless of the document size.
+ *
+ * Nodes also count the characters above the BMP, which take a surrogate pair in UTF-16 where wchar_t is UTF-32, so
+ * that offsets are converted to and from UTF-16 code units in O(log n + MAX_CHUNK) as well.
+ */
+class TextRope
+{
+public:
+	static constexpr size_t MAX_CHUNK = 1024;
+
+private:
+	struct Node;
+
+	using node_ptr = std::unique_ptr<Node>;
+
+	node_ptr root;
+	uint32_t seed = 0x9E3779B9u;
+
+	uint32_t next_priority();
+
+	node_ptr make_node(std::wstring chunk);
+
+	node_ptr build(wstring_view text);
+
+	void split(node_ptr node, size_t offset, node_ptr& left, node_ptr& right);
+
+	static node_ptr merge(node_ptr left, node_ptr right);
+
+	static size_t length_of(node_ptr const& node);
+
+	static size_t pairs_of(node_ptr const& node);
+
+	static void update(Node& node);
+
+	static bool insert_in_place(Node& node, size_t offset, wstring_view text);
+
+	static bool erase_in_place(Node& node, size_t offset, size_t count);
+
+	static void append_to(Node const& node, size_t offset, size_t count, std::wstring& out);
+
+public:
+	// region ctor/dtor
+
+	TextRope();
+
+	explicit TextRope(wstring_view text);
+
+	TextRope(TextRope const&) = delete;
+
+	TextRope& operator=(TextRope const&) = delete;
+
+	TextRope(TextRope&&) noexcept;
+
+	TextRope& operator=(TextRope&&) noexcept;
+
+	~TextRope();
+	// endregion
+
+	size_t size() const;
+
+	bool empty() const;
+
+	wchar_t at(size_t offset) const;
+
+	void assign(wstring_view text);
+
+	void clear();
+
+	void insert(size_t offset, wstring_view text);
+
+	void erase(size_t offset, size_t count);
+
+	void replace(size_t offset, size_t count, wstring_view text);
+
+	std::wstring substr(size_t offset, size_t count) const;
+
+	std::wstring to_wstring() const;
+
+	/**
+	 * \brief Length of [text] in UTF-16 code units.
+	 */
+	static size_t utf16_length(wstring_view text);
+
+	/**
+	 * \brief Length of the text in UTF-16 code units.
+	 */
+	size_t utf16_size() const;
+
+	/**
+	 * \return UTF-16 offset of the character at [offset].
+	 */
+	size_t to_utf16_offset(size_t offset) const;
+
+	/**
+	 * \return offset of the character at [utf16_offset], which mustn't split a surrogate pair.
+	 */
+	size_t from_utf16_offset(size_t utf16_offset) const;
+};
+}	 // namespace rd
+
+#endif	  // RD_CPP_TEXTROPE_H
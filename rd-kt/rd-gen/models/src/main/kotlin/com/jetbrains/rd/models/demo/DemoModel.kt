@@ -21,6 +21,8 @@ object DemoRoot : Root(
 
     init {
         setting(Cpp17Generator.TargetName, "demo_model")
+        setting(Cpp17Generator.InlineSerializers)
+        setting(Cpp17Generator.PrecomputedIds)
     }
 }
 
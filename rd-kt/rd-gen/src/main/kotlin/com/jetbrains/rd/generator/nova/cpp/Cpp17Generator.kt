@@ -141,6 +141,26 @@ open class Cpp17Generator(
 
     object GeneratePrecompiledHeaders : SettingWithDefault<Boolean, Toplevel>(false)
 
+    /**
+     * Emit readers and writers which don't dispatch through `rd::Polymorphic` where the type is known statically:
+     * enums are (de)serialized by `rd::Buffer` directly, final structs call each other's `write`, arrays of enums
+     * are copied in bulk, arrays of elements of a fixed size are made room for at once and writers reserve
+     * the fixed-size part of the layout, nested final structs included. Wire format is the same as without the setting.
+     */
+    object InlineSerializers : ISetting<Unit, Declaration>
+
+    private val Declaration.inlineSerializers: Boolean
+        get() = hasSetting(InlineSerializers)
+
+    /**
+     * Hash the names of bindable members at compile time: `identify` mixes a precomputed `rd::RdId::Tail` into the id
+     * of the owner instead of hashing the name on every call. Ids are the same as without the setting.
+     */
+    object PrecomputedIds : ISetting<Unit, Declaration>
+
+    private val Declaration.precomputedIds: Boolean
+        get() = hasSetting(PrecomputedIds)
+
     private fun fsExtension(isDefinition: Boolean) = if (isDefinition) "cpp" else "h"
 
     private fun Declaration.sourceFileName() = this.fsName(true)
@@ -352,6 +372,24 @@ open class Cpp17Generator(
     private val IType.isPrimitive: Boolean
         get() = this is PredefinedType.NativeFloatingPointType || this.isPredefinedNumber
 
+    //number of bytes on the wire if it doesn't depend on the value
+    private val IType.fixedWireSize: Int?
+        get() = when (this) {
+            is PredefinedType.bool, is PredefinedType.byte -> 1
+            is PredefinedType.char, is PredefinedType.short -> 2
+            is PredefinedType.int, is PredefinedType.float -> 4
+            is PredefinedType.long, is PredefinedType.double, is PredefinedType.dateTime, is PredefinedType.timeSpan -> 8
+            is PredefinedType.UnsignedIntegral -> itemType.fixedWireSize
+            is Enum -> 4
+            is IAttributedType -> itemType.fixedWireSize
+            //final structs are written as their fields only
+            is Struct.Concrete -> if (isIntrinsic || isUnknown) null else (membersOfBaseClasses + ownMembers).let { members ->
+                val sizes = members.map { (it as? Member.Field)?.type?.fixedWireSize }
+                if (sizes.any { it == null }) null else sizes.filterNotNull().sum()
+            }
+            else -> null
+        }
+
     private fun IType.isAbstract0() = (this is Struct.Abstract || this is Class.Abstract)
     private fun IType.isAbstract() = (this.isAbstract0()) || (this is InternedScalar && (this.itemType.isAbstract0()))
 
@@ -1849,7 +1887,11 @@ open class Cpp17Generator(
         fun IType.polymorphicReader() = "rd::Polymorphic<${templateName(decl)}>::read(ctx, buffer)"
 
         fun IType.reader(): String = when (this) {
-            is Enum -> polymorphicReader()
+            is Enum -> when {
+                !decl.inlineSerializers -> polymorphicReader()
+                flags -> "buffer.read_enum_set<${templateName(decl)}>()"
+                else -> "buffer.read_enum<${templateName(decl)}>()"
+            }
             is InternedScalar -> {
                 val lambda = lambda("rd::SerializationCtx &, rd::Buffer &", "return ${itemType.reader()}")
                 """ctx.readInterned<${itemType.templateName(decl)}, ${internKey.hash()}>(buffer, $lambda)"""
@@ -1881,7 +1923,7 @@ open class Cpp17Generator(
             is IArray, is IImmutableList -> { //awaiting superinterfaces' support in Kotlin
                 this as IHasItemType
                 val templateTypes = "${decl.listType.withNamespace()}, ${itemType.templateName(decl)}, ${decl.allocatorType(itemType.substituted(decl))}"
-                if (isPrimitivesArray) {
+                if (isPrimitivesArray || (decl.inlineSerializers && itemType is Enum)) {
                     "buffer.read_array<$templateTypes>()"
                 } else {
                     """buffer.read_array<$templateTypes>(${lambda(null, "return ${itemType.reader()}")})"""
@@ -2040,7 +2082,11 @@ open class Cpp17Generator(
         fun IType.writer(field: String): String {
             return when (this) {
                 is CppIntrinsicType -> polymorphicWriter(field)
-                is Enum -> polymorphicWriter(field)
+                is Enum -> when {
+                    !decl.inlineSerializers -> polymorphicWriter(field)
+                    flags -> "buffer.write_enum_set($field)"
+                    else -> "buffer.write_enum($field)"
+                }
                 is InternedScalar -> {
                     val lambda = lambda("rd::SerializationCtx &, rd::Buffer &, ${itemType.substitutedName(decl)} const & internedValue", itemType.writer("internedValue"), "void")
                     """ctx.writeInterned<${itemType.templateName(decl)}, ${internKey.hash()}>(buffer, $field, $lambda)"""
@@ -2055,7 +2101,9 @@ open class Cpp17Generator(
                 is Declaration ->
                     if (isAbstract || isOpen)
                         "ctx.get_serializers().writePolymorphic<${templateName(decl)}>(ctx, buffer, $field)"
-                    else {
+                    else if (decl.inlineSerializers && this is Struct.Concrete && !isIntrinsic) {
+                        "rd::wrapper::get($field).write(ctx, buffer)"
+                    } else {
                         "rd::Polymorphic<std::decay_t<decltype($field)>>::write(ctx, buffer, $field)"
                     }
                 is INullable -> {
@@ -2065,12 +2113,15 @@ open class Cpp17Generator(
                 is IAttributedType -> itemType.writer(field)
                 is IArray, is IImmutableList -> { //awaiting superinterfaces' support in Kotlin
                     this as IHasItemType
-                    if (isPrimitivesArray) {
+                    if (isPrimitivesArray || (decl.inlineSerializers && itemType is Enum)) {
                         "buffer.write_array($field)"
                     } else {
                         val templateTypes = "${decl.listType.withNamespace()}, ${itemType.templateName(decl)}, ${decl.allocatorType(itemType.substituted(decl))}"
                         val lambda = lambda("${itemType.templateName(decl)} const & it", itemType.writer("it"), "void")
-                        "buffer.write_array<$templateTypes>($field, $lambda)"
+                        val itemSize = decl.inlineSerializers.condstr { itemType.fixedWireSize?.toString() ?: "" }
+                        //elements of a fixed size are made room for at once, as the fixed part of a struct
+                        val reserve = itemSize.isNotEmpty().condstr { "buffer.require_available(4 + $itemSize * $field.size()), " }
+                        "${reserve}buffer.write_array<$templateTypes>($field, $lambda)"
                     }
                 }
                 else -> fail("Unknown declaration: $decl")
@@ -2089,6 +2140,16 @@ open class Cpp17Generator(
 
         if (decl.isConcrete || decl.isValue) {
             define(writerTraitDecl(decl)) {
+                if (decl.inlineSerializers) {
+                    val idSize = if (decl is Class || decl is Aggregate) 8 else 0
+                    val fixedSize = idSize + (decl.membersOfBaseClasses + decl.ownMembers)
+                        .filterIsInstance<Member.Field>()
+                        .map { it.type.fixedWireSize ?: 0 }
+                        .sum()
+                    if (fixedSize > 0) {
+                        +"buffer.require_available($fixedSize);"
+                    }
+                }
                 if (decl is Class || decl is Aggregate) {
                     +"this->rdid.write(buffer);"
                 }
@@ -2121,9 +2182,18 @@ open class Cpp17Generator(
         identifyTraitDecl(decl)?.let {
             define(it) {
                 +"rd::RdBindableBase::identify(identities, id);"
-                decl.ownMembers
-                    .filter { it.isBindable }
-                    .println { """identifyPolymorphic(${it.encapsulatedName}, identities, id.mix(".${it.name}"));""" }
+                if (decl.precomputedIds) {
+                    decl.ownMembers
+                        .filter { it.isBindable }
+                        .forEach {
+                            +"""constexpr rd::RdId::Tail ${it.name}_tail(".${it.name}");"""
+                            +"""identifyPolymorphic(${it.encapsulatedName}, identities, id.mix(${it.name}_tail));"""
+                        }
+                } else {
+                    decl.ownMembers
+                        .filter { it.isBindable }
+                        .println { """identifyPolymorphic(${it.encapsulatedName}, identities, id.mix(".${it.name}"));""" }
+                }
             }
         }
     }